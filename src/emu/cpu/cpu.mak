@@ -32,6 +32,7 @@ DRCOBJ = \
 	$(CPUOBJ)/drcbeut.o \
 	$(CPUOBJ)/drccache.o \
 	$(CPUOBJ)/drcfe.o \
+	$(CPUOBJ)/drcthread.o \
 	$(CPUOBJ)/drcuml.o \
 	$(CPUOBJ)/uml.o \
 	$(CPUOBJ)/i386/i386dasm.o \
@@ -44,6 +45,7 @@ DRCDEPS = \
 	$(CPUSRC)/drcbeut.h \
 	$(CPUSRC)/drccache.h \
 	$(CPUSRC)/drcfe.h \
+	$(CPUSRC)/drcthread.h \
 	$(CPUSRC)/drcuml.h \
 	$(CPUSRC)/drcumlsh.h \
 	$(CPUSRC)/uml.h \
@@ -811,7 +813,8 @@ $(CPUOBJ)/sh2/sh2fe.o:  $(CPUSRC)/sh2/sh2fe.c \
 
 ifneq ($(filter SH4,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/sh4
-CPUOBJS += $(CPUOBJ)/sh4/sh4.o $(CPUOBJ)/sh4/sh4comn.o $(CPUOBJ)/sh4/sh3comn.o $(CPUOBJ)/sh4/sh4tmu.o $(CPUOBJ)/sh4/sh4dmac.o
+CPUOBJS += $(CPUOBJ)/sh4/sh4.o $(CPUOBJ)/sh4/sh4comn.o $(CPUOBJ)/sh4/sh3comn.o $(CPUOBJ)/sh4/sh4tmu.o $(CPUOBJ)/sh4/sh4dmac.o \
+			$(CPUOBJ)/sh4/sh4drc.o $(DRCOBJ)
 DASMOBJS += $(CPUOBJ)/sh4/sh4dasm.o
 endif
 
@@ -821,6 +824,11 @@ $(CPUOBJ)/sh4/sh4.o:    $(CPUSRC)/sh4/sh4.c \
 			$(CPUSRC)/sh4/sh4comn.h \
 			$(CPUSRC)/sh4/sh3comn.h
 
+$(CPUOBJ)/sh4/sh4drc.o:  $(CPUSRC)/sh4/sh4drc.c \
+			$(CPUSRC)/sh4/sh4.h \
+			$(CPUSRC)/sh4/sh4comn.h \
+			$(DRCDEPS)
+
 $(CPUOBJ)/sh4/sh4comn.o:  $(CPUSRC)/sh4/sh4comn.c \
 			$(CPUSRC)/sh4/sh4comn.h \
 			$(CPUSRC)/sh4/sh4regs.h \
@@ -1065,7 +1073,7 @@ endif
 
 ifneq ($(filter I386,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/i386
-CPUOBJS += $(CPUOBJ)/i386/i386.o
+CPUOBJS += $(CPUOBJ)/i386/i386.o $(CPUOBJ)/i386/i386drc.o $(DRCOBJ)
 DASMOBJS += $(CPUOBJ)/i386/i386dasm.o
 endif
 
@@ -1095,6 +1103,10 @@ $(CPUOBJ)/i386/i386.o:  $(CPUSRC)/i386/i386.c \
 						$(CPUSRC)/i386/i386ops.h \
 						$(CPUSRC)/i386/cycles.h
 
+$(CPUOBJ)/i386/i386drc.o: $(CPUSRC)/i386/i386drc.c \
+						$(CPUSRC)/i386/i386.h \
+						$(DRCDEPS)
+
 
 
 #-------------------------------------------------
@@ -1280,7 +1292,8 @@ $(CPUOBJ)/mips/mips3drc.o:  $(CPUSRC)/mips/mips3drc.c \
 
 ifneq ($(filter PSX,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/psx
-CPUOBJS += $(CPUOBJ)/psx/psx.o $(CPUOBJ)/psx/gte.o $(CPUOBJ)/psx/dma.o $(CPUOBJ)/psx/irq.o $(CPUOBJ)/psx/mdec.o $(CPUOBJ)/psx/rcnt.o $(CPUOBJ)/psx/sio.o
+CPUOBJS += $(CPUOBJ)/psx/psx.o $(CPUOBJ)/psx/gte.o $(CPUOBJ)/psx/dma.o $(CPUOBJ)/psx/irq.o $(CPUOBJ)/psx/mdec.o $(CPUOBJ)/psx/rcnt.o $(CPUOBJ)/psx/sio.o \
+			$(CPUOBJ)/psx/psxdrc.o $(DRCOBJ)
 DASMOBJS += $(CPUOBJ)/psx/psxdasm.o
 endif
 
@@ -1292,6 +1305,10 @@ $(CPUOBJ)/psx/psx.o:    $(CPUSRC)/psx/psx.c \
 			$(CPUSRC)/psx/rcnt.h \
 			$(CPUSRC)/psx/sio.h
 
+$(CPUOBJ)/psx/psxdrc.o: $(CPUSRC)/psx/psxdrc.c \
+			$(CPUSRC)/psx/psx.h \
+			$(DRCDEPS)
+
 $(CPUOBJ)/psx/dma.o:    $(CPUSRC)/psx/dma.c \
 			$(CPUSRC)/psx/dma.h
 
@@ -1624,6 +1641,7 @@ $(CPUOBJ)/mc68hc11/mc68hc11.o:  $(CPUSRC)/mc68hc11/mc68hc11.c \
 ifneq ($(filter M680X0,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/m68000
 CPUOBJS += $(CPUOBJ)/m68000/m68kcpu.o $(CPUOBJ)/m68000/m68kops.o \
+			$(CPUOBJ)/m68000/m68kdrc.o $(DRCOBJ)
 
 DASMOBJS += $(CPUOBJ)/m68000/m68kdasm.o
 #ifndef M68KMAKE
@@ -1651,6 +1669,9 @@ endif
 $(CPUOBJ)/m68000/m68kcpu.o:     $(CPUSRC)/m68000/m68kops.c \
 								$(CPUSRC)/m68000/m68kcpu.h $(CPUSRC)/m68000/m68kfpu.inc $(CPUSRC)/m68000/m68kmmu.h
 
+$(CPUOBJ)/m68000/m68kdrc.o:     $(CPUSRC)/m68000/m68kcpu.h \
+								$(DRCDEPS)
+
 # m68kcpu.h now includes m68kops.h; m68kops.h won't exist until m68kops.c has been made
 $(CPUSRC)/m68000/m68kcpu.h: $(CPUSRC)/m68000/m68kops.c
 
@@ -128,6 +128,14 @@ enum
 	OP_FFRI8,
 	OP_FFRFS,
 	OP_FFRFD,
+	OP_MOVI,
+	OP_ADDI,
+	OP_SUBI,
+	OP_ANDI,
+	OP_ORI,
+	OP_XORI,
+	OP_SHLI,
+	OP_SHRI
 };
 
 
@@ -160,6 +168,22 @@ enum
 #define OPCODE_FAIL_CONDITION(op,f) (((op) & s_condition_map[f]) == 0)
 #define OPCODE_GET_PWORDS(op)       ((op) >> 28)
 
+// label each handler; in threaded mode, interpret(NULL) walks the switch once
+// to record the address of each label in s_handler_table
+#if DRCBEC_THREADED
+#define OPCODE_CASE(op, size, cf) \
+	case MAKE_OPCODE_SHORT(op, size, cf): \
+		if (UNEXPECTED(inst == NULL)) \
+		{ \
+			s_handler_table[MAKE_OPCODE_SHORT(op, size, cf)] = &&op##_##size##_##cf; \
+			goto next_handler; \
+		} \
+	op##_##size##_##cf
+#else
+#define OPCODE_CASE(op, size, cf) \
+	case MAKE_OPCODE_SHORT(op, size, cf)
+#endif
+
 // shorthand for accessing parameters in the instruction stream
 #define PARAM0                      (*inst[0].puint32)
 #define PARAM1                      (*inst[1].puint32)
@@ -240,6 +264,10 @@ union drcbec_instruction
 
 UINT64 drcbe_c::s_immediate_zero = 0;
 
+#if DRCBEC_THREADED
+void *drcbe_c::s_handler_table[0x1000];
+#endif
+
 const UINT32 drcbe_c::s_condition_map[] =
 {
 	/* ..... */     NCBIT | NVBIT | NZBIT | NSBIT | NUBIT | ABIT  | GBIT  | GEBIT,
@@ -293,6 +321,11 @@ drcbe_c::drcbe_c(drcuml_state &drcuml, device_t &device, drc_cache &cache, UINT3
 		m_labels(cache),
 		m_fixup_delegate(FUNC(drcbe_c::fixup_label), this)
 {
+#if DRCBEC_THREADED
+	// resolve the handler addresses once for all instances
+	if (s_handler_table[0] == NULL)
+		interpret(NULL);
+#endif
 }
 
 
@@ -329,7 +362,7 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 	m_map.block_begin(block);
 
 	// begin codegen; fail if we can't
-	drccodeptr *cachetop = m_cache.begin_codegen(numinst * sizeof(drcbec_instruction) * 4);
+	drccodeptr *cachetop = m_cache.begin_codegen(numinst * sizeof(drcbec_instruction) * (4 + DRCBEC_THREADED));
 	if (cachetop == NULL)
 		block.abort();
 
@@ -374,7 +407,7 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 
 			// JMP instructions need to resolve their labels
 			case OP_JMP:
-				(dst++)->i = MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), 1);
+				output_opcode(&dst, MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), 1));
 				dst->inst = (drcbec_instruction *)m_labels.get_codeptr(inst.param(0).label(), m_fixup_delegate, dst);
 				dst++;
 				break;
@@ -424,9 +457,28 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 				if (opcode == OP_FFRFLT)
 					opcode = (opcode_t)(OP_FFRFS + (inst.param(2).size() - 2));
 
+				// simple 32-bit operations with an immediate last operand store it inline
+				int inlineparams = 0;
+				if (inst.size() == 4 && inst.condition() == COND_ALWAYS && inst.flags() == 0 && inst.numparams() >= 2 && inst.param(inst.numparams() - 1).is_immediate())
+				{
+					inlineparams = 1;
+					switch (opcode)
+					{
+						case OP_MOV:    opcode = (opcode_t)OP_MOVI;    break;
+						case OP_ADD:    opcode = (opcode_t)OP_ADDI;    break;
+						case OP_SUB:    opcode = (opcode_t)OP_SUBI;    break;
+						case OP_AND:    opcode = (opcode_t)OP_ANDI;    break;
+						case OP_OR:     opcode = (opcode_t)OP_ORI;     break;
+						case OP_XOR:    opcode = (opcode_t)OP_XORI;    break;
+						case OP_SHL:    opcode = (opcode_t)OP_SHLI;    break;
+						case OP_SHR:    opcode = (opcode_t)OP_SHRI;    break;
+						default:        inlineparams = 0;              break;
+					}
+				}
+
 				// count how many bytes of immediates we need
 				int immedbytes = 0;
-				for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				for (int pnum = 0; pnum < inst.numparams() - inlineparams; pnum++)
 					if (inst.param(pnum).is_mapvar() ||
 						(inst.param(pnum).is_immediate() && inst.param(pnum).immediate() != 0) ||
 						(inst.param(pnum).is_size_space() && inst.param(pnum).space() != 0))
@@ -436,14 +488,16 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 				int immedwords = (immedbytes + sizeof(drcbec_instruction) - 1) / sizeof(drcbec_instruction);
 
 				// first item is the opcode, size, condition flags and length
-				(dst++)->i = MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), inst.numparams() + immedwords);
+				output_opcode(&dst, MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), inst.numparams() + immedwords));
 
 				// immediates start after parameters
 				void *immed = dst + inst.numparams();
 
 				// output each of the parameters
-				for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				for (int pnum = 0; pnum < inst.numparams() - inlineparams; pnum++)
 					output_parameter(&dst, &immed, psize[pnum], inst.param(pnum));
+				if (inlineparams != 0)
+					(dst++)->i = (UINT32)inst.param(inst.numparams() - 1).immediate();
 
 				// point past the end of the immediates
 				dst += immedwords;
@@ -473,6 +527,17 @@ bool drcbe_c::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - forget about code that has
+//  been evicted from the cache
+//-------------------------------------------------
+
+void drcbe_c::invalidate_code(drccodeptr start, drccodeptr end)
+{
+	m_hash.invalidate_range(start, end);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -495,7 +560,17 @@ int drcbe_c::execute(code_handle &entry)
 	// get the entry point
 	const drcbec_instruction *inst = (const drcbec_instruction *)entry.codeptr();
 	assert_in_cache(m_cache, inst);
+	return interpret(inst);
+}
+
+
+//-------------------------------------------------
+//  interpret - run generated code starting at
+//  the given instruction until an EXIT
+//-------------------------------------------------
 
+int drcbe_c::interpret(const drcbec_instruction *inst)
+{
 	// loop while we have cycles
 	const drcbec_instruction *callstack[32];
 	const drcbec_instruction *newinst;
@@ -504,28 +579,54 @@ int drcbe_c::execute(code_handle &entry)
 	int shift;
 	UINT8 flags = 0;
 	UINT8 sp = 0;
+	UINT32 opcode;
+#if DRCBEC_THREADED
+	void *handler;
+
+	// a NULL entry point means fill in the handler table: point every slot at
+	// the invalid opcode handler, then run each short opcode through the switch
+	if (inst == NULL)
+	{
+		opcode = ~0;
+	next_handler:
+		if (++opcode >= ARRAY_LENGTH(s_handler_table))
+			return 0;
+		s_handler_table[opcode] = &&invalid_opcode;
+		goto dispatch_switch;
+	}
+#endif
+
 	while (true)
 	{
-		UINT32 opcode = (inst++)->i;
+#if DRCBEC_THREADED
+		// each instruction starts with the address of its handler
+		handler = (inst++)->v;
+		opcode = (inst++)->i;
+		goto *handler;
+
+	dispatch_switch:
+#else
+		opcode = (inst++)->i;
+#endif
 
 		switch (OPCODE_GET_SHORT(opcode))
 		{
 			// ----------------------- Control Flow Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_HANDLE, 4, 0):    // HANDLE  handle
-			case MAKE_OPCODE_SHORT(OP_HASH, 4, 0):      // HASH    mode,pc
-			case MAKE_OPCODE_SHORT(OP_LABEL, 4, 0):     // LABEL   imm
-			case MAKE_OPCODE_SHORT(OP_COMMENT, 4, 0):   // COMMENT string
-			case MAKE_OPCODE_SHORT(OP_MAPVAR, 4, 0):    // MAPVAR  mapvar,value
+			OPCODE_CASE(OP_HANDLE, 4, 0):    // HANDLE  handle
+			OPCODE_CASE(OP_HASH, 4, 0):      // HASH    mode,pc
+			OPCODE_CASE(OP_LABEL, 4, 0):     // LABEL   imm
+			OPCODE_CASE(OP_COMMENT, 4, 0):   // COMMENT string
+			OPCODE_CASE(OP_MAPVAR, 4, 0):    // MAPVAR  mapvar,value
 
 				// these opcodes should be processed at compile-time only
 				fatalerror("Unexpected opcode\n");
 
-			case MAKE_OPCODE_SHORT(OP_DEBUG, 4, 0):     // DEBUG   pc
+			OPCODE_CASE(OP_DEBUG, 4, 0):     // DEBUG   pc
 				debugger_instruction_hook(&m_device, PARAM0);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_HASHJMP, 4, 0):   // HASHJMP mode,pc,handle
+			OPCODE_CASE(OP_HASHJMP, 4, 0):   // HASHJMP mode,pc,handle
 				sp = 0;
 				newinst = (const drcbec_instruction *)m_hash.get_codeptr(PARAM0, PARAM1);
 				if (newinst == NULL)
@@ -539,31 +640,31 @@ int drcbe_c::execute(code_handle &entry)
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_EXIT, 4, 1):      // EXIT    src1[,c]
+			OPCODE_CASE(OP_EXIT, 4, 1):      // EXIT    src1[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_EXIT, 4, 0):
+			OPCODE_CASE(OP_EXIT, 4, 0):
 				return PARAM0;
 
-			case MAKE_OPCODE_SHORT(OP_JMP, 4, 1):       // JMP     imm[,c]
+			OPCODE_CASE(OP_JMP, 4, 1):       // JMP     imm[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_JMP, 4, 0):
+			OPCODE_CASE(OP_JMP, 4, 0):
 				newinst = inst[0].inst;
 				assert_in_cache(m_cache, newinst);
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_CALLH, 4, 1):     // CALLH   handle[,c]
+			OPCODE_CASE(OP_CALLH, 4, 1):     // CALLH   handle[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_CALLH, 4, 0):
+			OPCODE_CASE(OP_CALLH, 4, 0):
 				assert(sp < ARRAY_LENGTH(callstack));
 				newinst = (const drcbec_instruction *)inst[0].handle->codeptr();
 				assert_in_cache(m_cache, newinst);
@@ -571,24 +672,24 @@ int drcbe_c::execute(code_handle &entry)
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_RET, 4, 1):       // RET     [c]
+			OPCODE_CASE(OP_RET, 4, 1):       // RET     [c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_RET, 4, 0):
+			OPCODE_CASE(OP_RET, 4, 0):
 				assert(sp > 0);
 				newinst = callstack[--sp];
 				assert_in_cache(m_cache, newinst);
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_EXH, 4, 1):       // EXH     handle,param[,c]
+			OPCODE_CASE(OP_EXH, 4, 1):       // EXH     handle,param[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_EXH, 4, 0):
+			OPCODE_CASE(OP_EXH, 4, 0):
 				assert(sp < ARRAY_LENGTH(callstack));
 				newinst = (const drcbec_instruction *)inst[0].handle->codeptr();
 				assert_in_cache(m_cache, newinst);
@@ -597,16 +698,16 @@ int drcbe_c::execute(code_handle &entry)
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_CALLC, 4, 1):     // CALLC   func,ptr[,c]
+			OPCODE_CASE(OP_CALLC, 4, 1):     // CALLC   func,ptr[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_CALLC, 4, 0):
+			OPCODE_CASE(OP_CALLC, 4, 0):
 				(*inst[0].cfunc)(inst[1].v);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RECOVER, 4, 0):   // RECOVER dst,mapvar
+			OPCODE_CASE(OP_RECOVER, 4, 0):   // RECOVER dst,mapvar
 				assert(sp > 0);
 				PARAM0 = m_map.get_value((drccodeptr)callstack[0], MAPVAR_M0 + PARAM1);
 				break;
@@ -614,29 +715,29 @@ int drcbe_c::execute(code_handle &entry)
 
 			// ----------------------- Internal Register Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_SETFMOD, 4, 0):   // SETFMOD src
+			OPCODE_CASE(OP_SETFMOD, 4, 0):   // SETFMOD src
 				m_state.fmod = PARAM0;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_GETFMOD, 4, 0):   // GETFMOD dst
+			OPCODE_CASE(OP_GETFMOD, 4, 0):   // GETFMOD dst
 				PARAM0 = m_state.fmod;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_GETEXP, 4, 0):    // GETEXP  dst
+			OPCODE_CASE(OP_GETEXP, 4, 0):    // GETEXP  dst
 				PARAM0 = m_state.exp;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_GETFLGS, 4, 0):   // GETFLGS dst[,f]
+			OPCODE_CASE(OP_GETFLGS, 4, 0):   // GETFLGS dst[,f]
 				PARAM0 = flags & PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAVE, 4, 0):      // SAVE    dst
+			OPCODE_CASE(OP_SAVE, 4, 0):      // SAVE    dst
 				*inst[0].state = m_state;
 				inst[0].state->flags = flags;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RESTORE, 4, 0):   // RESTORE dst
-			case MAKE_OPCODE_SHORT(OP_RESTORE, 4, 1):   // RESTORE dst
+			OPCODE_CASE(OP_RESTORE, 4, 0):   // RESTORE dst
+			OPCODE_CASE(OP_RESTORE, 4, 1):   // RESTORE dst
 				m_state = *inst[0].state;
 				flags = inst[0].state->flags;
 				break;
@@ -644,266 +745,266 @@ int drcbe_c::execute(code_handle &entry)
 
 			// ----------------------- 32-Bit Integer Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1, 4, 0):     // LOAD    dst,base,index,BYTE
+			OPCODE_CASE(OP_LOAD1, 4, 0):     // LOAD    dst,base,index,BYTE
 				PARAM0 = inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x2, 4, 0):   // LOAD    dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOAD1x2, 4, 0):   // LOAD    dst,base,index,BYTE_x2
 				PARAM0 = *(UINT8 *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x4, 4, 0):   // LOAD    dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOAD1x4, 4, 0):   // LOAD    dst,base,index,BYTE_x4
 				PARAM0 = *(UINT8 *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x8, 4, 0):   // LOAD    dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOAD1x8, 4, 0):   // LOAD    dst,base,index,BYTE_x8
 				PARAM0 = *(UINT8 *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x1, 4, 0):   // LOAD    dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOAD2x1, 4, 0):   // LOAD    dst,base,index,WORD_x1
 				PARAM0 = *(UINT16 *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2, 4, 0):     // LOAD    dst,base,index,WORD
+			OPCODE_CASE(OP_LOAD2, 4, 0):     // LOAD    dst,base,index,WORD
 				PARAM0 = inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x4, 4, 0):   // LOAD    dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOAD2x4, 4, 0):   // LOAD    dst,base,index,WORD_x4
 				PARAM0 = *(UINT16 *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x8, 4, 0):   // LOAD    dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOAD2x8, 4, 0):   // LOAD    dst,base,index,WORD_x8
 				PARAM0 = *(UINT16 *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x1, 4, 0):   // LOAD    dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOAD4x1, 4, 0):   // LOAD    dst,base,index,DWORD_x1
 				PARAM0 = *(UINT32 *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x2, 4, 0):   // LOAD    dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOAD4x2, 4, 0):   // LOAD    dst,base,index,DWORD_x2
 				PARAM0 = *(UINT32 *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4, 4, 0):     // LOAD    dst,base,index,DWORD
+			OPCODE_CASE(OP_LOAD4, 4, 0):     // LOAD    dst,base,index,DWORD
 				PARAM0 = inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x8, 4, 0):   // LOAD    dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOAD4x8, 4, 0):   // LOAD    dst,base,index,DWORD_x8
 				PARAM0 = *(UINT32 *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1, 4, 0):    // LOADS   dst,base,index,BYTE
+			OPCODE_CASE(OP_LOADS1, 4, 0):    // LOADS   dst,base,index,BYTE
 				PARAM0 = inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x2, 4, 0):  // LOADS   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOADS1x2, 4, 0):  // LOADS   dst,base,index,BYTE_x2
 				PARAM0 = *(INT8 *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x4, 4, 0):  // LOADS   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOADS1x4, 4, 0):  // LOADS   dst,base,index,BYTE_x4
 				PARAM0 = *(INT8 *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x8, 4, 0):  // LOADS   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOADS1x8, 4, 0):  // LOADS   dst,base,index,BYTE_x8
 				PARAM0 = *(INT8 *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x1, 4, 0):  // LOADS   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOADS2x1, 4, 0):  // LOADS   dst,base,index,WORD_x1
 				PARAM0 = *(INT16 *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2, 4, 0):    // LOADS   dst,base,index,WORD
+			OPCODE_CASE(OP_LOADS2, 4, 0):    // LOADS   dst,base,index,WORD
 				PARAM0 = inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x4, 4, 0):  // LOADS   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOADS2x4, 4, 0):  // LOADS   dst,base,index,WORD_x4
 				PARAM0 = *(INT16 *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x8, 4, 0):  // LOADS   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOADS2x8, 4, 0):  // LOADS   dst,base,index,WORD_x8
 				PARAM0 = *(INT16 *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x1, 4, 0):  // LOADS   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOADS4x1, 4, 0):  // LOADS   dst,base,index,DWORD_x1
 				PARAM0 = *(INT32 *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x2, 4, 0):  // LOADS   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOADS4x2, 4, 0):  // LOADS   dst,base,index,DWORD_x2
 				PARAM0 = *(INT32 *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4, 4, 0):    // LOADS   dst,base,index,DWORD
+			OPCODE_CASE(OP_LOADS4, 4, 0):    // LOADS   dst,base,index,DWORD
 				PARAM0 = inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x8, 4, 0):  // LOADS   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOADS4x8, 4, 0):  // LOADS   dst,base,index,DWORD_x8
 				PARAM0 = *(INT32 *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1, 4, 0):    // STORE   dst,base,index,BYTE
+			OPCODE_CASE(OP_STORE1, 4, 0):    // STORE   dst,base,index,BYTE
 				inst[0].puint8[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x2, 4, 0):  // STORE   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_STORE1x2, 4, 0):  // STORE   dst,base,index,BYTE_x2
 				*(UINT8 *)&inst[0].puint16[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x4, 4, 0):  // STORE   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_STORE1x4, 4, 0):  // STORE   dst,base,index,BYTE_x4
 				*(UINT8 *)&inst[0].puint32[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x8, 4, 0):  // STORE   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_STORE1x8, 4, 0):  // STORE   dst,base,index,BYTE_x8
 				*(UINT8 *)&inst[0].puint64[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x1, 4, 0):  // STORE   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_STORE2x1, 4, 0):  // STORE   dst,base,index,WORD_x1
 				*(UINT16 *)&inst[0].puint8[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2, 4, 0):    // STORE   dst,base,index,WORD
+			OPCODE_CASE(OP_STORE2, 4, 0):    // STORE   dst,base,index,WORD
 				inst[0].puint16[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x4, 4, 0):  // STORE   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_STORE2x4, 4, 0):  // STORE   dst,base,index,WORD_x4
 				*(UINT16 *)&inst[0].puint32[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x8, 4, 0):  // STORE   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_STORE2x8, 4, 0):  // STORE   dst,base,index,WORD_x8
 				*(UINT16 *)&inst[0].puint64[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x1, 4, 0):  // STORE   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_STORE4x1, 4, 0):  // STORE   dst,base,index,DWORD_x1
 				*(UINT32 *)&inst[0].puint8[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x2, 4, 0):  // STORE   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_STORE4x2, 4, 0):  // STORE   dst,base,index,DWORD_x2
 				*(UINT32 *)&inst[0].puint16[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4, 4, 0):    // STORE   dst,base,index,DWORD
+			OPCODE_CASE(OP_STORE4, 4, 0):    // STORE   dst,base,index,DWORD
 				inst[0].puint32[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x8, 4, 0):  // STORE   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_STORE4x8, 4, 0):  // STORE   dst,base,index,DWORD_x8
 				*(UINT32 *)&inst[0].puint64[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ1, 4, 0):     // READ    dst,src1,space_BYTE
+			OPCODE_CASE(OP_READ1, 4, 0):     // READ    dst,src1,space_BYTE
 				PARAM0 = m_space[PARAM2]->read_byte(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ2, 4, 0):     // READ    dst,src1,space_WORD
+			OPCODE_CASE(OP_READ2, 4, 0):     // READ    dst,src1,space_WORD
 				PARAM0 = m_space[PARAM2]->read_word(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ4, 4, 0):     // READ    dst,src1,space_DWORD
+			OPCODE_CASE(OP_READ4, 4, 0):     // READ    dst,src1,space_DWORD
 				PARAM0 = m_space[PARAM2]->read_dword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM2, 4, 0):    // READM   dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_READM2, 4, 0):    // READM   dst,src1,mask,space_WORD
 				PARAM0 = m_space[PARAM3]->read_word(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM4, 4, 0):    // READM   dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_READM4, 4, 0):    // READM   dst,src1,mask,space_DWORD
 				PARAM0 = m_space[PARAM3]->read_dword(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE1, 4, 0):    // WRITE   dst,src1,space_BYTE
+			OPCODE_CASE(OP_WRITE1, 4, 0):    // WRITE   dst,src1,space_BYTE
 				m_space[PARAM2]->write_byte(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE2, 4, 0):    // WRITE   dst,src1,space_WORD
+			OPCODE_CASE(OP_WRITE2, 4, 0):    // WRITE   dst,src1,space_WORD
 				m_space[PARAM2]->write_word(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE4, 4, 0):    // WRITE   dst,src1,space_DWORD
+			OPCODE_CASE(OP_WRITE4, 4, 0):    // WRITE   dst,src1,space_DWORD
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM2, 4, 0):   // WRITEM  dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_WRITEM2, 4, 0):   // WRITEM  dst,src1,mask,space_WORD
 				m_space[PARAM3]->write_word(PARAM0, PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM4, 4, 0):   // WRITEM  dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_WRITEM4, 4, 0):   // WRITEM  dst,src1,mask,space_DWORD
 				m_space[PARAM3]->write_dword(PARAM0, PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 4, 1):     // CARRY   src,bitnum
+			OPCODE_CASE(OP_CARRY, 4, 1):     // CARRY   src,bitnum
 				flags = (flags & ~FLAG_C) | ((PARAM0 >> (PARAM1 & 31)) & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 4, 1):       // MOV     dst,src[,c]
+			OPCODE_CASE(OP_MOV, 4, 1):       // MOV     dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 4, 0):
+			OPCODE_CASE(OP_MOV, 4, 0):
 				PARAM0 = PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SET, 4, 1):       // SET     dst,c
+			OPCODE_CASE(OP_SET, 4, 1):       // SET     dst,c
 				PARAM0 = OPCODE_FAIL_CONDITION(opcode, flags) ? 0 : 1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 4, 0):     // SEXT1   dst,src
+			OPCODE_CASE(OP_SEXT1, 4, 0):     // SEXT1   dst,src
 				PARAM0 = (INT8)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 4, 1):
+			OPCODE_CASE(OP_SEXT1, 4, 1):
 				temp32 = (INT8)PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 4, 0):     // SEXT2   dst,src
+			OPCODE_CASE(OP_SEXT2, 4, 0):     // SEXT2   dst,src
 				PARAM0 = (INT16)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 4, 1):
+			OPCODE_CASE(OP_SEXT2, 4, 1):
 				temp32 = (INT16)PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 4, 0):    // ROLAND  dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLAND, 4, 0):    // ROLAND  dst,src,count,mask[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = ((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 4, 1):
+			OPCODE_CASE(OP_ROLAND, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = ((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 4, 0):    // ROLINS  dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLINS, 4, 0):    // ROLINS  dst,src,count,mask[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = (PARAM0 & ~PARAM3) | (((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 4, 1):
+			OPCODE_CASE(OP_ROLINS, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (PARAM0 & ~PARAM3) | (((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3);
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 4, 0):       // ADD     dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADD, 4, 0):       // ADD     dst,src1,src2[,f]
 				PARAM0 = PARAM1 + PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 4, 1):
+			OPCODE_CASE(OP_ADD, 4, 1):
 				temp32 = PARAM1 + PARAM2;
 				flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 0):      // ADDC    dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADDC, 4, 0):      // ADDC    dst,src1,src2[,f]
 				PARAM0 = PARAM1 + PARAM2 + (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 1):
+			OPCODE_CASE(OP_ADDC, 4, 1):
 				temp32 = PARAM1 + PARAM2 + (flags & FLAG_C);
 				if (PARAM2 + 1 != 0)
 					flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
@@ -920,21 +1021,21 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 4, 0):       // SUB     dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUB, 4, 0):       // SUB     dst,src1,src2[,f]
 				PARAM0 = PARAM1 - PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 4, 1):
+			OPCODE_CASE(OP_SUB, 4, 1):
 				temp32 = PARAM1 - PARAM2;
 				flags = FLAGS32_NZCV_SUB(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 0):      // SUBB    dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUBB, 4, 0):      // SUBB    dst,src1,src2[,f]
 				PARAM0 = PARAM1 - PARAM2 - (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 1):
+			OPCODE_CASE(OP_SUBB, 4, 1):
 				temp32 = PARAM1 - PARAM2 - (flags & FLAG_C);
 				temp64 = (UINT64)PARAM1 - (UINT64)PARAM2 - (UINT64)(flags & FLAG_C);
 				if (PARAM2 + 1 != 0)
@@ -949,19 +1050,19 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CMP, 4, 1):       // CMP     src1,src2[,f]
+			OPCODE_CASE(OP_CMP, 4, 1):       // CMP     src1,src2[,f]
 				temp32 = PARAM0 - PARAM1;
 				flags = FLAGS32_NZCV_SUB(temp32, PARAM0, PARAM1);
 //                printf("CMP: %08x - %08x = flags %x\n", PARAM0, PARAM1, flags);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 4, 0):      // MULU    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULU, 4, 0):      // MULU    dst,edst,src1,src2[,f]
 				temp64 = (UINT64)(UINT32)PARAM2 * (UINT64)(UINT32)PARAM3;
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 4, 1):
+			OPCODE_CASE(OP_MULU, 4, 1):
 				temp64 = (UINT64)(UINT32)PARAM2 * (UINT64)(UINT32)PARAM3;
 				flags = FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
@@ -970,13 +1071,13 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 4, 0):      // MULS    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULS, 4, 0):      // MULS    dst,edst,src1,src2[,f]
 				temp64 = (INT64)(INT32)PARAM2 * (INT64)(INT32)PARAM3;
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 4, 1):
+			OPCODE_CASE(OP_MULS, 4, 1):
 				temp64 = (INT64)(INT32)PARAM2 * (INT64)(INT32)PARAM3;
 				temp32 = (INT32)temp64;
 				flags = FLAGS32_NZ(temp32);
@@ -986,7 +1087,7 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 4, 0):      // DIVU    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVU, 4, 0):      // DIVU    dst,edst,src1,src2[,f]
 				if (PARAM3 != 0)
 				{
 					temp32 = (UINT32)PARAM2 / (UINT32)PARAM3;
@@ -995,7 +1096,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 4, 1):
+			OPCODE_CASE(OP_DIVU, 4, 1):
 				if (PARAM3 != 0)
 				{
 					temp32 = (UINT32)PARAM2 / (UINT32)PARAM3;
@@ -1007,7 +1108,7 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 4, 0):      // DIVS    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVS, 4, 0):      // DIVS    dst,edst,src1,src2[,f]
 				if (PARAM3 != 0)
 				{
 					temp32 = (INT32)PARAM2 / (INT32)PARAM3;
@@ -1016,7 +1117,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 4, 1):
+			OPCODE_CASE(OP_DIVS, 4, 1):
 				if (PARAM3 != 0)
 				{
 					temp32 = (INT32)PARAM2 / (INT32)PARAM3;
@@ -1028,67 +1129,67 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 4, 0):       // AND     dst,src1,src2[,f]
+			OPCODE_CASE(OP_AND, 4, 0):       // AND     dst,src1,src2[,f]
 				PARAM0 = PARAM1 & PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 4, 1):
+			OPCODE_CASE(OP_AND, 4, 1):
 				temp32 = PARAM1 & PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TEST, 4, 1):      // TEST    src1,src2[,f]
+			OPCODE_CASE(OP_TEST, 4, 1):      // TEST    src1,src2[,f]
 				temp32 = PARAM0 & PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 4, 0):        // OR      dst,src1,src2[,f]
+			OPCODE_CASE(OP_OR, 4, 0):        // OR      dst,src1,src2[,f]
 				PARAM0 = PARAM1 | PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 4, 1):
+			OPCODE_CASE(OP_OR, 4, 1):
 				temp32 = PARAM1 | PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 4, 0):       // XOR     dst,src1,src2[,f]
+			OPCODE_CASE(OP_XOR, 4, 0):       // XOR     dst,src1,src2[,f]
 				PARAM0 = PARAM1 ^ PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 4, 1):
+			OPCODE_CASE(OP_XOR, 4, 1):
 				temp32 = PARAM1 ^ PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 4, 0):     // LZCNT   dst,src
+			OPCODE_CASE(OP_LZCNT, 4, 0):     // LZCNT   dst,src
 				PARAM0 = count_leading_zeros(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 4, 1):
+			OPCODE_CASE(OP_LZCNT, 4, 1):
 				temp32 = count_leading_zeros(PARAM1);
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 0):     // BSWAP   dst,src
+			OPCODE_CASE(OP_BSWAP, 4, 0):     // BSWAP   dst,src
 				temp32 = PARAM1;
 				PARAM0 = FLIPENDIAN_INT32(temp32);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 1):
+			OPCODE_CASE(OP_BSWAP, 4, 1):
 				temp32 = PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = FLIPENDIAN_INT32(temp32);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 4, 0):       // SHL     dst,src,count[,f]
+			OPCODE_CASE(OP_SHL, 4, 0):       // SHL     dst,src,count[,f]
 				PARAM0 = PARAM1 << (PARAM2 & 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 4, 1):
+			OPCODE_CASE(OP_SHL, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = PARAM1 << shift;
 				if (shift != 0)
@@ -1099,11 +1200,11 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 4, 0):       // SHR     dst,src,count[,f]
+			OPCODE_CASE(OP_SHR, 4, 0):       // SHR     dst,src,count[,f]
 				PARAM0 = PARAM1 >> (PARAM2 & 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 4, 1):
+			OPCODE_CASE(OP_SHR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = PARAM1 >> shift;
 				if (shift != 0)
@@ -1114,11 +1215,11 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 4, 0):       // SAR     dst,src,count[,f]
+			OPCODE_CASE(OP_SAR, 4, 0):       // SAR     dst,src,count[,f]
 				PARAM0 = (INT32)PARAM1 >> (PARAM2 & 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 4, 1):
+			OPCODE_CASE(OP_SAR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (INT32)PARAM1 >> shift;
 				if (shift != 0)
@@ -1129,12 +1230,12 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 4, 0):       // ROL     dst,src,count[,f]
+			OPCODE_CASE(OP_ROL, 4, 0):       // ROL     dst,src,count[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = (PARAM1 << shift) | (PARAM1 >> ((32 - shift) & 31));
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 4, 1):
+			OPCODE_CASE(OP_ROL, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (PARAM1 << shift) | (PARAM1 >> ((32 - shift) & 31));
 				if (shift != 0)
@@ -1145,7 +1246,7 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 0):      // ROLC    dst,src,count[,f]
+			OPCODE_CASE(OP_ROLC, 4, 0):      // ROLC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					PARAM0 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
@@ -1153,7 +1254,7 @@ int drcbe_c::execute(code_handle &entry)
 					PARAM0 = (PARAM1 << shift) | (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 1):
+			OPCODE_CASE(OP_ROLC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					temp32 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
@@ -1166,12 +1267,12 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 4, 0):       // ROR     dst,src,count[,f]
+			OPCODE_CASE(OP_ROR, 4, 0):       // ROR     dst,src,count[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = (PARAM1 >> shift) | (PARAM1 << ((32 - shift) & 31));
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 4, 1):
+			OPCODE_CASE(OP_ROR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (PARAM1 >> shift) | (PARAM1 << ((32 - shift) & 31));
 				flags = FLAGS32_NZ(temp32);
@@ -1179,7 +1280,7 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 4, 0):      // RORC    dst,src,count[,f]
+			OPCODE_CASE(OP_RORC, 4, 0):      // RORC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					PARAM0 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
@@ -1187,7 +1288,7 @@ int drcbe_c::execute(code_handle &entry)
 					PARAM0 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 4, 1):
+			OPCODE_CASE(OP_RORC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					temp32 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
@@ -1201,342 +1302,377 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 
+			// ----------------------- 32-Bit Inline Immediate Operations -----------------------
+
+			OPCODE_CASE(OP_MOVI, 4, 0):      // MOV     dst,imm
+				PARAM0 = inst[1].i;
+				break;
+
+			OPCODE_CASE(OP_ADDI, 4, 0):      // ADD     dst,src1,imm
+				PARAM0 = PARAM1 + inst[2].i;
+				break;
+
+			OPCODE_CASE(OP_SUBI, 4, 0):      // SUB     dst,src1,imm
+				PARAM0 = PARAM1 - inst[2].i;
+				break;
+
+			OPCODE_CASE(OP_ANDI, 4, 0):      // AND     dst,src1,imm
+				PARAM0 = PARAM1 & inst[2].i;
+				break;
+
+			OPCODE_CASE(OP_ORI, 4, 0):       // OR      dst,src1,imm
+				PARAM0 = PARAM1 | inst[2].i;
+				break;
+
+			OPCODE_CASE(OP_XORI, 4, 0):      // XOR     dst,src1,imm
+				PARAM0 = PARAM1 ^ inst[2].i;
+				break;
+
+			OPCODE_CASE(OP_SHLI, 4, 0):      // SHL     dst,src,imm
+				PARAM0 = PARAM1 << (inst[2].i & 31);
+				break;
+
+			OPCODE_CASE(OP_SHRI, 4, 0):      // SHR     dst,src,imm
+				PARAM0 = PARAM1 >> (inst[2].i & 31);
+				break;
+
+
 			// ----------------------- 64-Bit Integer Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1, 8, 0):     // DLOAD   dst,base,index,BYTE
+			OPCODE_CASE(OP_LOAD1, 8, 0):     // DLOAD   dst,base,index,BYTE
 				DPARAM0 = inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x2, 8, 0):   // DLOAD   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOAD1x2, 8, 0):   // DLOAD   dst,base,index,BYTE_x2
 				DPARAM0 = *(UINT8 *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x4, 8, 0):   // DLOAD   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOAD1x4, 8, 0):   // DLOAD   dst,base,index,BYTE_x4
 				DPARAM0 = *(UINT8 *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x8, 8, 0):   // DLOAD   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOAD1x8, 8, 0):   // DLOAD   dst,base,index,BYTE_x8
 				DPARAM0 = *(UINT8 *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x1, 8, 0):   // DLOAD   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOAD2x1, 8, 0):   // DLOAD   dst,base,index,WORD_x1
 				DPARAM0 = *(UINT16 *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2, 8, 0):     // DLOAD   dst,base,index,WORD
+			OPCODE_CASE(OP_LOAD2, 8, 0):     // DLOAD   dst,base,index,WORD
 				DPARAM0 = inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x4, 8, 0):   // DLOAD   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOAD2x4, 8, 0):   // DLOAD   dst,base,index,WORD_x4
 				DPARAM0 = *(UINT16 *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x8, 8, 0):   // DLOAD   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOAD2x8, 8, 0):   // DLOAD   dst,base,index,WORD_x8
 				DPARAM0 = *(UINT16 *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x1, 8, 0):   // DLOAD   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOAD4x1, 8, 0):   // DLOAD   dst,base,index,DWORD_x1
 				DPARAM0 = *(UINT32 *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x2, 8, 0):   // DLOAD   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOAD4x2, 8, 0):   // DLOAD   dst,base,index,DWORD_x2
 				DPARAM0 = *(UINT32 *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4, 8, 0):     // DLOAD   dst,base,index,DWORD
+			OPCODE_CASE(OP_LOAD4, 8, 0):     // DLOAD   dst,base,index,DWORD
 				DPARAM0 = inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x8, 8, 0):   // DLOAD   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOAD4x8, 8, 0):   // DLOAD   dst,base,index,DWORD_x8
 				DPARAM0 = *(UINT32 *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x1, 8, 0):   // DLOAD   dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_LOAD8x1, 8, 0):   // DLOAD   dst,base,index,QWORD_x1
 				DPARAM0 = *(UINT64 *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x2, 8, 0):   // DLOAD   dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_LOAD8x2, 8, 0):   // DLOAD   dst,base,index,QWORD_x2
 				DPARAM0 = *(UINT64 *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x4, 8, 0):   // DLOAD   dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_LOAD8x4, 8, 0):   // DLOAD   dst,base,index,QWORD_x4
 				DPARAM0 = *(UINT64 *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8, 8, 0):     // DLOAD   dst,base,index,QWORD
+			OPCODE_CASE(OP_LOAD8, 8, 0):     // DLOAD   dst,base,index,QWORD
 				DPARAM0 = inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1, 8, 0):    // DLOADS  dst,base,index,BYTE
+			OPCODE_CASE(OP_LOADS1, 8, 0):    // DLOADS  dst,base,index,BYTE
 				DPARAM0 = inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x2, 8, 0):  // DLOADS  dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOADS1x2, 8, 0):  // DLOADS  dst,base,index,BYTE_x2
 				DPARAM0 = *(INT8 *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x4, 8, 0):  // DLOADS  dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOADS1x4, 8, 0):  // DLOADS  dst,base,index,BYTE_x4
 				DPARAM0 = *(INT8 *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x8, 8, 0):  // DLOADS  dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOADS1x8, 8, 0):  // DLOADS  dst,base,index,BYTE_x8
 				DPARAM0 = *(INT8 *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x1, 8, 0):  // DLOADS  dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOADS2x1, 8, 0):  // DLOADS  dst,base,index,WORD_x1
 				DPARAM0 = *(INT16 *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2, 8, 0):    // DLOADS  dst,base,index,WORD
+			OPCODE_CASE(OP_LOADS2, 8, 0):    // DLOADS  dst,base,index,WORD
 				DPARAM0 = inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x4, 8, 0):  // DLOADS  dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOADS2x4, 8, 0):  // DLOADS  dst,base,index,WORD_x4
 				DPARAM0 = *(INT16 *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x8, 8, 0):  // DLOADS  dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOADS2x8, 8, 0):  // DLOADS  dst,base,index,WORD_x8
 				DPARAM0 = *(INT16 *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x1, 8, 0):  // DLOADS  dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOADS4x1, 8, 0):  // DLOADS  dst,base,index,DWORD_x1
 				DPARAM0 = *(INT32 *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x2, 8, 0):  // DLOADS  dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOADS4x2, 8, 0):  // DLOADS  dst,base,index,DWORD_x2
 				DPARAM0 = *(INT32 *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4, 8, 0):    // DLOADS  dst,base,index,DWORD
+			OPCODE_CASE(OP_LOADS4, 8, 0):    // DLOADS  dst,base,index,DWORD
 				DPARAM0 = inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x8, 8, 0):  // DLOADS  dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOADS4x8, 8, 0):  // DLOADS  dst,base,index,DWORD_x8
 				DPARAM0 = *(INT32 *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x1, 8, 0):  // DLOADS  dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_LOADS8x1, 8, 0):  // DLOADS  dst,base,index,QWORD_x1
 				DPARAM0 = *(INT64 *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x2, 8, 0):  // DLOADS  dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_LOADS8x2, 8, 0):  // DLOADS  dst,base,index,QWORD_x2
 				DPARAM0 = *(INT64 *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x4, 8, 0):  // DLOADS  dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_LOADS8x4, 8, 0):  // DLOADS  dst,base,index,QWORD_x4
 				DPARAM0 = *(INT64 *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8, 8, 0):    // DLOADS  dst,base,index,QWORD
+			OPCODE_CASE(OP_LOADS8, 8, 0):    // DLOADS  dst,base,index,QWORD
 				DPARAM0 = inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1, 8, 0):    // DSTORE  dst,base,index,BYTE
+			OPCODE_CASE(OP_STORE1, 8, 0):    // DSTORE  dst,base,index,BYTE
 				inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x2, 8, 0):  // DSTORE  dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_STORE1x2, 8, 0):  // DSTORE  dst,base,index,BYTE_x2
 				*(UINT8 *)&inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x4, 8, 0):  // DSTORE  dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_STORE1x4, 8, 0):  // DSTORE  dst,base,index,BYTE_x4
 				*(UINT8 *)&inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x8, 8, 0):  // DSTORE  dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_STORE1x8, 8, 0):  // DSTORE  dst,base,index,BYTE_x8
 				*(UINT8 *)&inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x1, 8, 0):  // DSTORE  dst,base,index,WORD_x1
+			OPCODE_CASE(OP_STORE2x1, 8, 0):  // DSTORE  dst,base,index,WORD_x1
 				*(UINT16 *)&inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2, 8, 0):    // DSTORE  dst,base,index,WORD
+			OPCODE_CASE(OP_STORE2, 8, 0):    // DSTORE  dst,base,index,WORD
 				inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x4, 8, 0):  // DSTORE  dst,base,index,WORD_x4
+			OPCODE_CASE(OP_STORE2x4, 8, 0):  // DSTORE  dst,base,index,WORD_x4
 				*(UINT16 *)&inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x8, 8, 0):  // DSTORE  dst,base,index,WORD_x8
+			OPCODE_CASE(OP_STORE2x8, 8, 0):  // DSTORE  dst,base,index,WORD_x8
 				*(UINT16 *)&inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x1, 8, 0):  // DSTORE  dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_STORE4x1, 8, 0):  // DSTORE  dst,base,index,DWORD_x1
 				*(UINT32 *)&inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x2, 8, 0):  // DSTORE  dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_STORE4x2, 8, 0):  // DSTORE  dst,base,index,DWORD_x2
 				*(UINT32 *)&inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4, 8, 0):    // DSTORE  dst,base,index,DWORD
+			OPCODE_CASE(OP_STORE4, 8, 0):    // DSTORE  dst,base,index,DWORD
 				inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x8, 8, 0):  // DSTORE  dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_STORE4x8, 8, 0):  // DSTORE  dst,base,index,DWORD_x8
 				*(UINT32 *)&inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x1, 8, 0):  // DSTORE  dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_STORE8x1, 8, 0):  // DSTORE  dst,base,index,QWORD_x1
 				*(UINT64 *)&inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x2, 8, 0):  // DSTORE  dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_STORE8x2, 8, 0):  // DSTORE  dst,base,index,QWORD_x2
 				*(UINT64 *)&inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x4, 8, 0):  // DSTORE  dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_STORE8x4, 8, 0):  // DSTORE  dst,base,index,QWORD_x4
 				*(UINT64 *)&inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8, 8, 0):    // DSTORE  dst,base,index,QWORD
+			OPCODE_CASE(OP_STORE8, 8, 0):    // DSTORE  dst,base,index,QWORD
 				inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ1, 8, 0):     // DREAD   dst,src1,space_BYTE
+			OPCODE_CASE(OP_READ1, 8, 0):     // DREAD   dst,src1,space_BYTE
 				DPARAM0 = m_space[PARAM2]->read_byte(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ2, 8, 0):     // DREAD   dst,src1,space_WORD
+			OPCODE_CASE(OP_READ2, 8, 0):     // DREAD   dst,src1,space_WORD
 				DPARAM0 = m_space[PARAM2]->read_word(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ4, 8, 0):     // DREAD   dst,src1,space_DWORD
+			OPCODE_CASE(OP_READ4, 8, 0):     // DREAD   dst,src1,space_DWORD
 				DPARAM0 = m_space[PARAM2]->read_dword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ8, 8, 0):     // DREAD   dst,src1,space_QOWRD
+			OPCODE_CASE(OP_READ8, 8, 0):     // DREAD   dst,src1,space_QOWRD
 				DPARAM0 = m_space[PARAM2]->read_qword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM2, 8, 0):    // DREADM  dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_READM2, 8, 0):    // DREADM  dst,src1,mask,space_WORD
 				DPARAM0 = m_space[PARAM3]->read_word(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM4, 8, 0):    // DREADM  dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_READM4, 8, 0):    // DREADM  dst,src1,mask,space_DWORD
 				DPARAM0 = m_space[PARAM3]->read_dword(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM8, 8, 0):    // DREADM  dst,src1,mask,space_QWORD
+			OPCODE_CASE(OP_READM8, 8, 0):    // DREADM  dst,src1,mask,space_QWORD
 				DPARAM0 = m_space[PARAM3]->read_qword(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE1, 8, 0):    // DWRITE  dst,src1,space_BYTE
+			OPCODE_CASE(OP_WRITE1, 8, 0):    // DWRITE  dst,src1,space_BYTE
 				m_space[PARAM2]->write_byte(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE2, 8, 0):    // DWRITE  dst,src1,space_WORD
+			OPCODE_CASE(OP_WRITE2, 8, 0):    // DWRITE  dst,src1,space_WORD
 				m_space[PARAM2]->write_word(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE4, 8, 0):    // DWRITE  dst,src1,space_DWORD
+			OPCODE_CASE(OP_WRITE4, 8, 0):    // DWRITE  dst,src1,space_DWORD
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE8, 8, 0):    // DWRITE  dst,src1,space_QWORD
+			OPCODE_CASE(OP_WRITE8, 8, 0):    // DWRITE  dst,src1,space_QWORD
 				m_space[PARAM2]->write_qword(PARAM0, DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM2, 8, 0):   // DWRITEM dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_WRITEM2, 8, 0):   // DWRITEM dst,src1,mask,space_WORD
 				m_space[PARAM3]->write_word(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM4, 8, 0):   // DWRITEM dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_WRITEM4, 8, 0):   // DWRITEM dst,src1,mask,space_DWORD
 				m_space[PARAM3]->write_dword(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM8, 8, 0):   // DWRITEM dst,src1,mask,space_QWORD
+			OPCODE_CASE(OP_WRITEM8, 8, 0):   // DWRITEM dst,src1,mask,space_QWORD
 				m_space[PARAM3]->write_qword(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 0):     // DCARRY  src,bitnum
+			OPCODE_CASE(OP_CARRY, 8, 0):     // DCARRY  src,bitnum
 				flags = (flags & ~FLAG_C) | ((DPARAM0 >> (DPARAM1 & 63)) & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 8, 1):       // DMOV    dst,src[,c]
+			OPCODE_CASE(OP_MOV, 8, 1):       // DMOV    dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 8, 0):
+			OPCODE_CASE(OP_MOV, 8, 0):
 				DPARAM0 = DPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SET, 8, 1):       // DSET    dst,c
+			OPCODE_CASE(OP_SET, 8, 1):       // DSET    dst,c
 				DPARAM0 = OPCODE_FAIL_CONDITION(opcode, flags) ? 0 : 1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 8, 0):     // DSEXT   dst,src,BYTE
+			OPCODE_CASE(OP_SEXT1, 8, 0):     // DSEXT   dst,src,BYTE
 				DPARAM0 = (INT8)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 8, 1):
+			OPCODE_CASE(OP_SEXT1, 8, 1):
 				temp64 = (INT8)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 8, 0):     // DSEXT   dst,src,WORD
+			OPCODE_CASE(OP_SEXT2, 8, 0):     // DSEXT   dst,src,WORD
 				DPARAM0 = (INT16)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 8, 1):
+			OPCODE_CASE(OP_SEXT2, 8, 1):
 				temp64 = (INT16)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT4, 8, 0):     // DSEXT   dst,src,DWORD
+			OPCODE_CASE(OP_SEXT4, 8, 0):     // DSEXT   dst,src,DWORD
 				DPARAM0 = (INT32)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT4, 8, 1):
+			OPCODE_CASE(OP_SEXT4, 8, 1):
 				temp64 = (INT32)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 8, 0):    // DROLAND dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLAND, 8, 0):    // DROLAND dst,src,count,mask[,f]
 				shift = DPARAM2 & 63;
 				DPARAM0 = ((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 8, 1):
+			OPCODE_CASE(OP_ROLAND, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = ((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 8, 0):    // DROLINS dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLINS, 8, 0):    // DROLINS dst,src,count,mask[,f]
 				shift = DPARAM2 & 63;
 				DPARAM0 = (DPARAM0 & ~DPARAM3) | (((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 8, 1):
+			OPCODE_CASE(OP_ROLINS, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM0 & ~DPARAM3) | (((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3);
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 8, 0):       // DADD    dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADD, 8, 0):       // DADD    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 + DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 8, 1):
+			OPCODE_CASE(OP_ADD, 8, 1):
 				temp64 = DPARAM1 + DPARAM2;
 				flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 0):      // DADDC   dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADDC, 8, 0):      // DADDC   dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 1):
+			OPCODE_CASE(OP_ADDC, 8, 1):
 				temp64 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
 				if (DPARAM2 + 1 != 0)
 					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
@@ -1545,21 +1681,21 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 8, 0):       // DSUB    dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUB, 8, 0):       // DSUB    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 - DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 8, 1):
+			OPCODE_CASE(OP_SUB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2;
 				flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 0):      // DSUBB   dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUBB, 8, 0):      // DSUBB   dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 1):
+			OPCODE_CASE(OP_SUBB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
 				if (DPARAM2 + 1 != 0)
 					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
@@ -1568,28 +1704,28 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CMP, 8, 1):       // DCMP    src1,src2[,f]
+			OPCODE_CASE(OP_CMP, 8, 1):       // DCMP    src1,src2[,f]
 				temp64 = DPARAM0 - DPARAM1;
 				flags = FLAGS64_NZCV_SUB(temp64, DPARAM0, DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 8, 0):      // DMULU   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULU, 8, 0):      // DMULU   dst,edst,src1,src2[,f]
 				dmulu(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, FALSE);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 8, 1):
+			OPCODE_CASE(OP_MULU, 8, 1):
 				flags = dmulu(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, TRUE);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 8, 0):      // DMULS   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULS, 8, 0):      // DMULS   dst,edst,src1,src2[,f]
 				dmuls(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, FALSE);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 8, 1):
+			OPCODE_CASE(OP_MULS, 8, 1):
 				flags = dmuls(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, TRUE);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 8, 0):      // DDIVU   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVU, 8, 0):      // DDIVU   dst,edst,src1,src2[,f]
 				if (DPARAM3 != 0)
 				{
 					temp64 = (UINT64)DPARAM2 / (UINT64)DPARAM3;
@@ -1598,7 +1734,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 8, 1):
+			OPCODE_CASE(OP_DIVU, 8, 1):
 				if (DPARAM3 != 0)
 				{
 					temp64 = (UINT64)DPARAM2 / (UINT64)DPARAM3;
@@ -1610,7 +1746,7 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 8, 0):      // DDIVS   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVS, 8, 0):      // DDIVS   dst,edst,src1,src2[,f]
 				if (DPARAM3 != 0)
 				{
 					temp64 = (INT64)DPARAM2 / (INT64)DPARAM3;
@@ -1619,7 +1755,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 8, 1):
+			OPCODE_CASE(OP_DIVS, 8, 1):
 				if (DPARAM3 != 0)
 				{
 					temp64 = (INT64)DPARAM2 / (INT64)DPARAM3;
@@ -1631,49 +1767,49 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 8, 0):       // DAND    dst,src1,src2[,f]
+			OPCODE_CASE(OP_AND, 8, 0):       // DAND    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 & DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 8, 1):
+			OPCODE_CASE(OP_AND, 8, 1):
 				temp64 = DPARAM1 & DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TEST, 8, 1):      // DTEST   src1,src2[,f]
+			OPCODE_CASE(OP_TEST, 8, 1):      // DTEST   src1,src2[,f]
 				temp64 = DPARAM1 & DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 8, 0):        // DOR     dst,src1,src2[,f]
+			OPCODE_CASE(OP_OR, 8, 0):        // DOR     dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 | DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 8, 1):
+			OPCODE_CASE(OP_OR, 8, 1):
 				temp64 = DPARAM1 | DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 8, 0):       // DXOR    dst,src1,src2[,f]
+			OPCODE_CASE(OP_XOR, 8, 0):       // DXOR    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 ^ DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 8, 1):
+			OPCODE_CASE(OP_XOR, 8, 1):
 				temp64 = DPARAM1 ^ DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 8, 0):     // DLZCNT  dst,src
+			OPCODE_CASE(OP_LZCNT, 8, 0):     // DLZCNT  dst,src
 				if ((UINT32)(DPARAM1 >> 32) != 0)
 					DPARAM0 = count_leading_zeros(DPARAM1 >> 32);
 				else
 					DPARAM0 = 32 + count_leading_zeros(DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 8, 1):
+			OPCODE_CASE(OP_LZCNT, 8, 1):
 				if ((UINT32)(DPARAM1 >> 32) != 0)
 					temp64 = count_leading_zeros(DPARAM1 >> 32);
 				else
@@ -1682,22 +1818,22 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 0):     // DBSWAP  dst,src
+			OPCODE_CASE(OP_BSWAP, 8, 0):     // DBSWAP  dst,src
 				temp64 = DPARAM1;
 				DPARAM0 = FLIPENDIAN_INT64(temp64);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 1):
+			OPCODE_CASE(OP_BSWAP, 8, 1):
 				temp64 = DPARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = FLIPENDIAN_INT64(temp64);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 8, 0):       // DSHL    dst,src,count[,f]
+			OPCODE_CASE(OP_SHL, 8, 0):       // DSHL    dst,src,count[,f]
 				DPARAM0 = DPARAM1 << (DPARAM2 & 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 8, 1):
+			OPCODE_CASE(OP_SHL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 << shift;
 				flags = FLAGS64_NZ(temp64);
@@ -1705,11 +1841,11 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 8, 0):       // DSHR    dst,src,count[,f]
+			OPCODE_CASE(OP_SHR, 8, 0):       // DSHR    dst,src,count[,f]
 				DPARAM0 = DPARAM1 >> (DPARAM2 & 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 8, 1):
+			OPCODE_CASE(OP_SHR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
@@ -1717,11 +1853,11 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 8, 0):       // DSAR    dst,src,count[,f]
+			OPCODE_CASE(OP_SAR, 8, 0):       // DSAR    dst,src,count[,f]
 				DPARAM0 = (INT64)DPARAM1 >> (DPARAM2 & 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 8, 1):
+			OPCODE_CASE(OP_SAR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (INT32)DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
@@ -1729,12 +1865,12 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 8, 0):       // DROL    dst,src,count[,f]
+			OPCODE_CASE(OP_ROL, 8, 0):       // DROL    dst,src,count[,f]
 				shift = DPARAM2 & 31;
 				DPARAM0 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 8, 1):
+			OPCODE_CASE(OP_ROL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
 				flags = FLAGS64_NZ(temp64);
@@ -1742,7 +1878,7 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 0):      // DROLC   dst,src,count[,f]
+			OPCODE_CASE(OP_ROLC, 8, 0):      // DROLC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					DPARAM0 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
@@ -1750,7 +1886,7 @@ int drcbe_c::execute(code_handle &entry)
 					DPARAM0 = (DPARAM1 << shift) | (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 1):
+			OPCODE_CASE(OP_ROLC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					temp64 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
@@ -1763,12 +1899,12 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 8, 0):       // DROR    dst,src,count[,f]
+			OPCODE_CASE(OP_ROR, 8, 0):       // DROR    dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				DPARAM0 = (DPARAM1 >> shift) | (DPARAM1 << ((64 - shift) & 63));
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 8, 1):
+			OPCODE_CASE(OP_ROR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM1 >> shift) | (DPARAM1 << ((64 - shift) & 63));
 				flags = FLAGS64_NZ(temp64);
@@ -1776,7 +1912,7 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 8, 0):      // DRORC   dst,src,count[,f]
+			OPCODE_CASE(OP_RORC, 8, 0):      // DRORC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					DPARAM0 = (DPARAM1 >> shift) | ((((UINT64)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
@@ -1784,7 +1920,7 @@ int drcbe_c::execute(code_handle &entry)
 					DPARAM0 = (DPARAM1 >> shift) | (((UINT64)flags & FLAG_C) << 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 8, 1):
+			OPCODE_CASE(OP_RORC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					temp64 = (DPARAM1 >> shift) | ((((UINT64)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
@@ -1800,278 +1936,283 @@ int drcbe_c::execute(code_handle &entry)
 
 			// ----------------------- 32-Bit Floating Point Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_FLOAD, 4, 0):     // FSLOAD  dst,base,index
+			OPCODE_CASE(OP_FLOAD, 4, 0):     // FSLOAD  dst,base,index
 				FSPARAM0 = inst[1].pfloat[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSTORE, 4, 0):    // FSSTORE dst,base,index
+			OPCODE_CASE(OP_FSTORE, 4, 0):    // FSSTORE dst,base,index
 				inst[0].pfloat[PARAM1] = FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FREAD, 4, 0):     // FSREAD  dst,src1,space
+			OPCODE_CASE(OP_FREAD, 4, 0):     // FSREAD  dst,src1,space
 				PARAM0 = m_space[PARAM2]->read_dword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FWRITE, 4, 0):    // FSWRITE dst,src1,space
+			OPCODE_CASE(OP_FWRITE, 4, 0):    // FSWRITE dst,src1,space
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 4, 1):      // FSMOV   dst,src[,c]
+			OPCODE_CASE(OP_FMOV, 4, 1):      // FSMOV   dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 4, 0):
+			OPCODE_CASE(OP_FMOV, 4, 0):
 				FSPARAM0 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4T, 4, 0):    // FSTOI4T dst,src1
+			OPCODE_CASE(OP_FTOI4T, 4, 0):    // FSTOI4T dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint32 = floor(FSPARAM1);
 				else
 					*inst[0].pint32 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4R, 4, 0):    // FSTOI4R dst,src1
+			OPCODE_CASE(OP_FTOI4R, 4, 0):    // FSTOI4R dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint32 = floor(FSPARAM1 + 0.5f);
 				else
 					*inst[0].pint32 = ceil(FSPARAM1 - 0.5f);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4F, 4, 0):    // FSTOI4F dst,src1
+			OPCODE_CASE(OP_FTOI4F, 4, 0):    // FSTOI4F dst,src1
 				*inst[0].pint32 = floor(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4C, 4, 0):    // FSTOI4C dst,src1
+			OPCODE_CASE(OP_FTOI4C, 4, 0):    // FSTOI4C dst,src1
 				*inst[0].pint32 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4, 4, 0):     // FSTOI4  dst,src1
+			OPCODE_CASE(OP_FTOI4, 4, 0):     // FSTOI4  dst,src1
 				*inst[0].pint32 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8T, 4, 0):    // FSTOI8T dst,src1
+			OPCODE_CASE(OP_FTOI8T, 4, 0):    // FSTOI8T dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint64 = floor(FSPARAM1);
 				else
 					*inst[0].pint64 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8R, 4, 0):    // FSTOI8R dst,src1
+			OPCODE_CASE(OP_FTOI8R, 4, 0):    // FSTOI8R dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint64 = floor(FSPARAM1 + 0.5f);
 				else
 					*inst[0].pint64 = ceil(FSPARAM1 - 0.5f);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8F, 4, 0):    // FSTOI8F dst,src1
+			OPCODE_CASE(OP_FTOI8F, 4, 0):    // FSTOI8F dst,src1
 				*inst[0].pint64 = floor(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8C, 4, 0):    // FSTOI8C dst,src1
+			OPCODE_CASE(OP_FTOI8C, 4, 0):    // FSTOI8C dst,src1
 				*inst[0].pint64 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8, 4, 0):     // FSTOI8  dst,src1
+			OPCODE_CASE(OP_FTOI8, 4, 0):     // FSTOI8  dst,src1
 				*inst[0].pint64 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI4, 4, 0):     // FSFRI4  dst,src1
+			OPCODE_CASE(OP_FFRI4, 4, 0):     // FSFRI4  dst,src1
 				FSPARAM0 = *inst[1].pint32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI8, 4, 0):     // FSFRI8  dst,src1
+			OPCODE_CASE(OP_FFRI8, 4, 0):     // FSFRI8  dst,src1
 				FSPARAM0 = *inst[1].pint64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRFD, 4, 0):     // FSFRFD  dst,src1
+			OPCODE_CASE(OP_FFRFD, 4, 0):     // FSFRFD  dst,src1
 				FSPARAM0 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FADD, 4, 0):      // FSADD   dst,src1,src2
+			OPCODE_CASE(OP_FADD, 4, 0):      // FSADD   dst,src1,src2
 				FSPARAM0 = FSPARAM1 + FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSUB, 4, 0):      // FSSUB   dst,src1,src2
+			OPCODE_CASE(OP_FSUB, 4, 0):      // FSSUB   dst,src1,src2
 				FSPARAM0 = FSPARAM1 - FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FCMP, 4, 1):      // FSCMP   src1,src2
+			OPCODE_CASE(OP_FCMP, 4, 1):      // FSCMP   src1,src2
 				if (isnan(FSPARAM0) || isnan(FSPARAM1))
 					flags = FLAG_U;
 				else
 					flags = (FSPARAM0 < FSPARAM1) | ((FSPARAM0 == FSPARAM1) << 2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMUL, 4, 0):      // FSMUL   dst,src1,src2
+			OPCODE_CASE(OP_FMUL, 4, 0):      // FSMUL   dst,src1,src2
 				FSPARAM0 = FSPARAM1 * FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FDIV, 4, 0):      // FSDIV   dst,src1,src2
+			OPCODE_CASE(OP_FDIV, 4, 0):      // FSDIV   dst,src1,src2
 				FSPARAM0 = FSPARAM1 / FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FNEG, 4, 0):      // FSNEG   dst,src1
+			OPCODE_CASE(OP_FNEG, 4, 0):      // FSNEG   dst,src1
 				FSPARAM0 = -FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FABS, 4, 0):      // FSABS   dst,src1
+			OPCODE_CASE(OP_FABS, 4, 0):      // FSABS   dst,src1
 				FSPARAM0 = fabs(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSQRT, 4, 0):     // FSSQRT  dst,src1
+			OPCODE_CASE(OP_FSQRT, 4, 0):     // FSSQRT  dst,src1
 				FSPARAM0 = sqrt(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRECIP, 4, 0):    // FSRECIP dst,src1
+			OPCODE_CASE(OP_FRECIP, 4, 0):    // FSRECIP dst,src1
 				FSPARAM0 = 1.0f / FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRSQRT, 4, 0):    // FSRSQRT dst,src1
+			OPCODE_CASE(OP_FRSQRT, 4, 0):    // FSRSQRT dst,src1
 				FSPARAM0 = 1.0f / sqrt(FSPARAM1);
 				break;
 
 
 			// ----------------------- 64-Bit Floating Point Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_FLOAD, 8, 0):     // FDLOAD  dst,base,index
+			OPCODE_CASE(OP_FLOAD, 8, 0):     // FDLOAD  dst,base,index
 				FDPARAM0 = inst[1].pdouble[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSTORE, 8, 0):    // FDSTORE dst,base,index
+			OPCODE_CASE(OP_FSTORE, 8, 0):    // FDSTORE dst,base,index
 				inst[0].pdouble[PARAM1] = FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FREAD, 8, 0):     // FDREAD  dst,src1,space
+			OPCODE_CASE(OP_FREAD, 8, 0):     // FDREAD  dst,src1,space
 				DPARAM0 = m_space[PARAM2]->read_qword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FWRITE, 8, 0):    // FDWRITE dst,src1,space
+			OPCODE_CASE(OP_FWRITE, 8, 0):    // FDWRITE dst,src1,space
 				m_space[PARAM2]->write_qword(PARAM0, DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 8, 1):      // FDMOV   dst,src[,c]
+			OPCODE_CASE(OP_FMOV, 8, 1):      // FDMOV   dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 8, 0):
+			OPCODE_CASE(OP_FMOV, 8, 0):
 				FDPARAM0 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4T, 8, 0):    // FDTOI4T dst,src1
+			OPCODE_CASE(OP_FTOI4T, 8, 0):    // FDTOI4T dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint32 = floor(FDPARAM1);
 				else
 					*inst[0].pint32 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4R, 8, 0):    // FDTOI4R dst,src1
+			OPCODE_CASE(OP_FTOI4R, 8, 0):    // FDTOI4R dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint32 = floor(FDPARAM1 + 0.5);
 				else
 					*inst[0].pint32 = ceil(FDPARAM1 - 0.5);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4F, 8, 0):    // FDTOI4F dst,src1
+			OPCODE_CASE(OP_FTOI4F, 8, 0):    // FDTOI4F dst,src1
 				*inst[0].pint32 = floor(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4C, 8, 0):    // FDTOI4C dst,src1
+			OPCODE_CASE(OP_FTOI4C, 8, 0):    // FDTOI4C dst,src1
 				*inst[0].pint32 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4, 8, 0):     // FDTOI4  dst,src1
+			OPCODE_CASE(OP_FTOI4, 8, 0):     // FDTOI4  dst,src1
 				*inst[0].pint32 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8T, 8, 0):    // FDTOI8T dst,src1
+			OPCODE_CASE(OP_FTOI8T, 8, 0):    // FDTOI8T dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint64 = floor(FDPARAM1);
 				else
 					*inst[0].pint64 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8R, 8, 0):    // FDTOI8R  dst,src1
+			OPCODE_CASE(OP_FTOI8R, 8, 0):    // FDTOI8R  dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint64 = floor(FDPARAM1 + 0.5);
 				else
 					*inst[0].pint64 = ceil(FDPARAM1 - 0.5);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8F, 8, 0):    // FDTOI8F dst,src1
+			OPCODE_CASE(OP_FTOI8F, 8, 0):    // FDTOI8F dst,src1
 				*inst[0].pint64 = floor(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8C, 8, 0):    // FDTOI8C dst,src1
+			OPCODE_CASE(OP_FTOI8C, 8, 0):    // FDTOI8C dst,src1
 				*inst[0].pint64 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8, 8, 0):     // FDTOI8  dst,src1
+			OPCODE_CASE(OP_FTOI8, 8, 0):     // FDTOI8  dst,src1
 				*inst[0].pint64 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI4, 8, 0):     // FDFRI4  dst,src1
+			OPCODE_CASE(OP_FFRI4, 8, 0):     // FDFRI4  dst,src1
 				FDPARAM0 = *inst[1].pint32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI8, 8, 0):     // FDFRI8  dst,src1
+			OPCODE_CASE(OP_FFRI8, 8, 0):     // FDFRI8  dst,src1
 				FDPARAM0 = *inst[1].pint64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRFS, 8, 0):     // FDFRFS  dst,src1
+			OPCODE_CASE(OP_FFRFS, 8, 0):     // FDFRFS  dst,src1
 				FDPARAM0 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRNDS, 8, 0):     // FDRNDS  dst,src1
+			OPCODE_CASE(OP_FRNDS, 8, 0):     // FDRNDS  dst,src1
 				FDPARAM0 = (float)FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FADD, 8, 0):      // FDADD   dst,src1,src2
+			OPCODE_CASE(OP_FADD, 8, 0):      // FDADD   dst,src1,src2
 				FDPARAM0 = FDPARAM1 + FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSUB, 8, 0):      // FDSUB   dst,src1,src2
+			OPCODE_CASE(OP_FSUB, 8, 0):      // FDSUB   dst,src1,src2
 				FDPARAM0 = FDPARAM1 - FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FCMP, 8, 1):      // FDCMP   src1,src2
+			OPCODE_CASE(OP_FCMP, 8, 1):      // FDCMP   src1,src2
 				if (isnan(FDPARAM0) || isnan(FDPARAM1))
 					flags = FLAG_U;
 				else
 					flags = (FDPARAM0 < FDPARAM1) | ((FDPARAM0 == FDPARAM1) << 2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMUL, 8, 0):      // FDMUL   dst,src1,src2
+			OPCODE_CASE(OP_FMUL, 8, 0):      // FDMUL   dst,src1,src2
 				FDPARAM0 = FDPARAM1 * FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FDIV, 8, 0):      // FDDIV   dst,src1,src2
+			OPCODE_CASE(OP_FDIV, 8, 0):      // FDDIV   dst,src1,src2
 				FDPARAM0 = FDPARAM1 / FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FNEG, 8, 0):      // FDNEG   dst,src1
+			OPCODE_CASE(OP_FNEG, 8, 0):      // FDNEG   dst,src1
 				FDPARAM0 = -FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FABS, 8, 0):      // FDABS   dst,src1
+			OPCODE_CASE(OP_FABS, 8, 0):      // FDABS   dst,src1
 				FDPARAM0 = fabs(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSQRT, 8, 0):     // FDSQRT  dst,src1
+			OPCODE_CASE(OP_FSQRT, 8, 0):     // FDSQRT  dst,src1
 				FDPARAM0 = sqrt(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRECIP, 8, 0):    // FDRECIP dst,src1
+			OPCODE_CASE(OP_FRECIP, 8, 0):    // FDRECIP dst,src1
 				FDPARAM0 = 1.0 / FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRSQRT, 8, 0):    // FDRSQRT dst,src1
+			OPCODE_CASE(OP_FRSQRT, 8, 0):    // FDRSQRT dst,src1
 				FDPARAM0 = 1.0 / sqrt(FDPARAM1);
 				break;
 
 			default:
+#if DRCBEC_THREADED
+				if (inst == NULL)
+					goto next_handler;
+			invalid_opcode:
+#endif
 				fatalerror("Unexpected opcode!\n");
 		}
 
@@ -2084,6 +2225,25 @@ int drcbe_c::execute(code_handle &entry)
 }
 
 
+//-------------------------------------------------
+//  output_opcode - output an opcode word,
+//  preceded by its handler address when using
+//  threaded dispatch
+//-------------------------------------------------
+
+void drcbe_c::output_opcode(drcbec_instruction **dstptr, UINT32 opcode)
+{
+	drcbec_instruction *dst = *dstptr;
+
+#if DRCBEC_THREADED
+	(dst++)->v = s_handler_table[OPCODE_GET_SHORT(opcode)];
+#endif
+	(dst++)->i = opcode;
+
+	*dstptr = dst;
+}
+
+
 //-------------------------------------------------
 //  output_parameter - output a parameter
 //-------------------------------------------------
@@ -18,6 +18,21 @@
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// with GCC-compatible compilers, build with -DDRCBEC_THREADED=1 to dispatch
+// through pre-resolved handler addresses instead of a switch; it is off by
+// default because it grows the code cache without a measurable speedup
+#ifndef DRCBEC_THREADED
+#define DRCBEC_THREADED     0
+#endif
+#if DRCBEC_THREADED && !defined(__GNUC__)
+#error DRCBEC_THREADED requires a compiler with computed goto support
+#endif
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -33,17 +48,20 @@ public:
 
 	// required overrides
 	virtual void reset();
-#ifdef ANDROID
-	virtual int execute(uml::code_handle &entry) __attribute__((optimize("-O0")));
-#else
 	virtual int execute(uml::code_handle &entry);
-#endif
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst);
 	virtual bool hash_exists(UINT32 mode, UINT32 pc);
+	virtual void invalidate_code(drccodeptr start, drccodeptr end);
 	virtual void get_info(drcbe_info &info);
 
 private:
 	// helpers
+#ifdef ANDROID
+	int interpret(const drcbec_instruction *inst) __attribute__((optimize("-O0")));
+#else
+	int interpret(const drcbec_instruction *inst);
+#endif
+	void output_opcode(drcbec_instruction **dstptr, UINT32 opcode);
 	void output_parameter(drcbec_instruction **dstptr, void **immedptr, int size, const uml::parameter &param);
 	void fixup_label(void *parameter, drccodeptr labelcodeptr);
 	int dmulu(UINT64 &dstlo, UINT64 &dsthi, UINT64 src1, UINT64 src2, int flags);
@@ -57,6 +75,9 @@ private:
 
 	static const UINT32     s_condition_map[32];
 	static UINT64           s_immediate_zero;
+#if DRCBEC_THREADED
+	static void *           s_handler_table[0x1000];
+#endif
 };
 
 
@@ -152,6 +152,27 @@ void drc_hash_table::set_default_codeptr(drccodeptr nocodeptr)
 }
 
 
+//-------------------------------------------------
+//  invalidate_range - point any entries that
+//  refer to code in the given range back to the
+//  default codeptr
+//-------------------------------------------------
+
+void drc_hash_table::invalidate_range(drccodeptr start, drccodeptr end)
+{
+	for (int modenum = 0; modenum < m_modes; modenum++)
+		if (m_base[modenum] != m_emptyl1)
+			for (int l1entry = 0; l1entry < (1 << m_l1bits); l1entry++)
+				if (m_base[modenum][l1entry] != m_emptyl2)
+					for (int l2entry = 0; l2entry < (1 << m_l2bits); l2entry++)
+					{
+						drccodeptr code = m_base[modenum][l1entry][l2entry];
+						if (code >= start && code < end)
+							m_base[modenum][l1entry][l2entry] = m_nocodeptr;
+					}
+}
+
+
 //-------------------------------------------------
 //  set_codeptr - set the codeptr for the given
 //  mode/pc
@@ -163,7 +184,7 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 	assert(mode < m_modes);
 	if (m_base[mode] == m_emptyl1)
 	{
-		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits);
+		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_table(sizeof(drccodeptr *) << m_l1bits);
 		if (newtable == NULL)
 			return false;
 		memcpy(newtable, m_emptyl1, sizeof(drccodeptr *) << m_l1bits);
@@ -174,7 +195,7 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 	UINT32 l1 = (pc >> m_l1shift) & m_l1mask;
 	if (m_base[mode][l1] == m_emptyl2)
 	{
-		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
+		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_table(sizeof(drccodeptr) << m_l2bits);
 		if (newtable == NULL)
 			return false;
 		memcpy(newtable, m_emptyl2, sizeof(drccodeptr) << m_l2bits);
@@ -356,7 +377,7 @@ UINT32 drc_map_variables::get_value(drccodeptr codebase, UINT32 mapvar) const
 
 	// get an aligned pointer to start scanning
 	UINT64 *curscan = (UINT64 *)(((FPTR)codebase | 7) + 1);
-	UINT64 *endscan = (UINT64 *)m_cache.top();
+	UINT64 *endscan = (UINT64 *)m_cache.region_end(codebase);
 
 	// look for the signature
 	while (curscan < endscan && *curscan++ != m_uniquevalue) ;
@@ -42,6 +42,7 @@ public:
 	// set up and configuration
 	bool reset();
 	void set_default_codeptr(drccodeptr code);
+	void invalidate_range(drccodeptr start, drccodeptr end);
 
 	// block begin/end
 	void block_begin(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst);
@@ -824,6 +824,17 @@ bool drcbe_x86::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - forget about code that has
+//  been evicted from the cache
+//-------------------------------------------------
+
+void drcbe_x86::invalidate_code(drccodeptr start, drccodeptr end)
+{
+	m_hash.invalidate_range(start, end);
+}
+
+
 //-------------------------------------------------
 //  drcbex86_get_info - return information about
 //  the back-end implementation
@@ -38,7 +38,20 @@ drc_cache::drc_cache(size_t bytes)
 		m_top(m_base),
 		m_end(m_near + bytes),
 		m_codegen(0),
-		m_size(bytes)
+		m_size(bytes),
+		m_generational(false),
+		m_static(m_base),
+		m_limit(m_end),
+		m_wrapend(m_base),
+		m_flushend(NULL),
+		m_pool(NULL),
+		m_poolend(NULL),
+		m_gensize(0),
+		m_gencount(0),
+		m_flushes(0),
+		m_evictions(0),
+		m_evicted_bytes(0),
+		m_generated_bytes(0)
 {
 	memset(m_free, 0, sizeof(m_free));
 	memset(m_nearfree, 0, sizeof(m_nearfree));
@@ -68,6 +81,14 @@ void drc_cache::flush()
 
 	// just reset the top back to the base and re-seed
 	m_top = m_base;
+	m_wrapend = m_base;
+	m_flushes++;
+
+	// drop all generations; tables allocated since the lock go too
+	m_generational = false;
+	m_gencount = 0;
+	if (m_flushend != NULL)
+		m_end = m_flushend;
 }
 
 
@@ -92,6 +113,16 @@ void *drc_cache::alloc(size_t bytes)
 		}
 	}
 
+	// once code has been locked, take from the pool so that m_end can be reset on a flush
+	if (m_pool != NULL)
+	{
+		drccodeptr ptr = (drccodeptr)ALIGN_PTR_UP(m_pool);
+		if (ptr + bytes > m_poolend)
+			return NULL;
+		m_pool = ptr + bytes;
+		return ptr;
+	}
+
 	// if no space, we just fail
 	drccodeptr ptr = (drccodeptr)ALIGN_PTR_DOWN(m_end - bytes);
 	if (m_top > ptr)
@@ -147,7 +178,7 @@ void *drc_cache::alloc_temporary(size_t bytes)
 
 	// if no space, we just fail
 	drccodeptr ptr = m_top;
-	if (ptr + bytes >= m_end)
+	if (ptr + bytes >= alloc_limit())
 		return NULL;
 
 	// otherwise, update the cache top
@@ -180,6 +211,162 @@ void drc_cache::dealloc(void *memory, size_t bytes)
 }
 
 
+//-------------------------------------------------
+//  alloc_table - allocate temporary memory that
+//  is referenced by generated code and so must
+//  survive until the next flush
+//-------------------------------------------------
+
+void *drc_cache::alloc_table(size_t bytes)
+{
+	// can't allocate in the middle of codegen
+	assert(m_codegen == NULL);
+
+	// without generations, this is the same as any other temporary memory
+	if (!m_generational)
+		return alloc_temporary(bytes);
+
+	// otherwise, carve it from the end of the cache, evicting any code in the way
+	drccodeptr ptr = (drccodeptr)ALIGN_PTR_DOWN(m_end - bytes);
+	if (ptr < m_top)
+		return NULL;
+	evict_generations(ptr, m_end);
+
+	// pull in the end of the cache
+	m_end = ptr;
+	if (m_limit > ptr)
+		m_limit = ptr;
+	if (m_wrapend > ptr)
+		m_wrapend = ptr;
+	return ptr;
+}
+
+
+//-------------------------------------------------
+//  lock_static - mark everything generated since
+//  the last flush as static; code generated after
+//  this is grouped into generations, and the
+//  oldest are evicted when the cache fills
+//-------------------------------------------------
+
+void drc_cache::lock_static()
+{
+	assert(m_codegen == NULL);
+
+	// the first time through, set aside permanent memory for later allocations
+	if (m_pool == NULL)
+	{
+		drccodeptr pool = (drccodeptr)ALIGN_PTR_DOWN(m_end - PERMANENT_POOL_SIZE);
+		if (pool < m_top)
+			return;
+		m_pool = pool;
+		m_poolend = m_end;
+		m_end = m_flushend = pool;
+	}
+
+	// split whatever remains into generations
+	m_generational = true;
+	m_static = m_top;
+	m_limit = m_end;
+	m_wrapend = m_top;
+	m_gensize = (m_end - m_static) / GENERATIONS;
+	m_gencount = 0;
+	new_generation();
+}
+
+
+//-------------------------------------------------
+//  reserve_block - make sure there is room for a
+//  block of code, evicting the oldest generations
+//  if needed
+//-------------------------------------------------
+
+void drc_cache::reserve_block(size_t bytes)
+{
+	// nothing to do until static code has been locked
+	if (!m_generational)
+		return;
+	assert(m_codegen == NULL);
+
+	// start a new generation once the current one is full
+	if (m_top - m_gen[m_gencount - 1].m_start >= m_gensize && m_gencount < GENERATIONS)
+		new_generation();
+
+	// wrap back to the start if the block won't fit before the end
+	if (m_top + bytes > m_end)
+	{
+		new_generation();
+		m_wrapend = m_top;
+		m_top = m_gen[m_gencount - 1].m_start = m_gen[m_gencount - 1].m_end = m_static;
+	}
+
+	// evict whatever is still living where the block will go
+	evict_generations(m_top, m_top + bytes);
+
+	// allocations may proceed up to the next live generation
+	m_limit = m_end;
+	for (int gennum = 0; gennum < m_gencount - 1; gennum++)
+		if (m_gen[gennum].m_start >= m_top && m_gen[gennum].m_start < m_limit)
+			m_limit = m_gen[gennum].m_start;
+}
+
+
+//-------------------------------------------------
+//  new_generation - close the current generation
+//  and start a new one at the top of the cache
+//-------------------------------------------------
+
+void drc_cache::new_generation()
+{
+	// close out the current generation, dropping it if empty
+	if (m_gencount > 0)
+	{
+		m_gen[m_gencount - 1].m_end = m_top;
+		if (m_gen[m_gencount - 1].m_start == m_top)
+			m_gencount--;
+	}
+
+	// if all slots are taken, the oldest generation has to go
+	if (m_gencount == GENERATIONS)
+		evict_generations(m_gen[0].m_start, m_gen[0].m_end);
+
+	// open the new one
+	m_gen[m_gencount].m_start = m_top;
+	m_gen[m_gencount].m_end = m_top;
+	m_gencount++;
+}
+
+
+//-------------------------------------------------
+//  evict_generations - evict every generation
+//  other than the newest that overlaps the given
+//  range
+//-------------------------------------------------
+
+void drc_cache::evict_generations(drccodeptr start, drccodeptr end)
+{
+	for (int gennum = 0; gennum < m_gencount - 1; )
+	{
+		generation &gen = m_gen[gennum];
+		if (gen.m_start < end && start < gen.m_end)
+		{
+			// tell our owner first, so it can forget pointers into the code
+			if (!m_evict.isnull())
+				m_evict(gen.m_start, gen.m_end);
+			m_evictions++;
+			m_evicted_bytes += gen.m_end - gen.m_start;
+
+			// then remove it from the list
+			for (int movenum = gennum + 1; movenum < m_gencount; movenum++)
+				m_gen[movenum - 1] = m_gen[movenum];
+			m_gencount--;
+		}
+		else
+			gennum++;
+	}
+}
+
+
 //-------------------------------------------------
 //  begin_codegen - begin code generation
 //-------------------------------------------------
@@ -192,7 +379,7 @@ drccodeptr *drc_cache::begin_codegen(UINT32 reserve_bytes)
 
 	// if still no space, we just fail
 	drccodeptr ptr = m_top;
-	if (ptr + reserve_bytes >= m_end)
+	if (ptr + reserve_bytes >= alloc_limit())
 		return NULL;
 
 	// otherwise, return a pointer to the cache top
@@ -224,6 +411,7 @@ drccodeptr drc_cache::end_codegen()
 	// update the cache top
 	m_top = (drccodeptr)ALIGN_PTR_UP(m_top);
 	m_codegen = NULL;
+	m_generated_bytes += m_top - result;
 
 	return result;
 }
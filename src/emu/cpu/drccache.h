@@ -36,6 +36,9 @@ typedef UINT8 *drccodeptr;
 // helper template for oob codegen
 typedef delegate<void (drccodeptr *, void *, void *)> drc_oob_delegate;
 
+// callback for code evicted from the cache
+typedef delegate<void (drccodeptr, drccodeptr)> drc_evict_delegate;
+
 
 // drc_cache
 class drc_cache
@@ -49,6 +52,8 @@ public:
 	drccodeptr near() const { return m_near; }
 	drccodeptr base() const { return m_base; }
 	drccodeptr top() const { return m_top; }
+	drccodeptr region_end(const void *ptr) const { return ((const drccodeptr)ptr < m_top) ? m_top : m_wrapend; }
+	bool generational() const { return m_generational; }
 
 	// pointer checking
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
@@ -61,6 +66,18 @@ public:
 	void *alloc_near(size_t bytes);
 	void *alloc_temporary(size_t bytes);
 	void dealloc(void *memory, size_t bytes);
+	void *alloc_table(size_t bytes);
+
+	// generational eviction
+	void lock_static();
+	void reserve_block(size_t bytes);
+	void set_evict_callback(drc_evict_delegate callback) { m_evict = callback; }
+
+	// statistics
+	UINT32 flushes() const { return m_flushes; }
+	UINT32 evictions() const { return m_evictions; }
+	UINT64 evicted_bytes() const { return m_evicted_bytes; }
+	UINT64 generated_bytes() const { return m_generated_bytes; }
 
 	// codegen helpers
 	drccodeptr *begin_codegen(UINT32 reserve_bytes);
@@ -80,6 +97,17 @@ private:
 	// size of "near" area at the base of the cache
 	static const size_t NEAR_CACHE_SIZE = 65536;
 
+	// number of generations the evictable part of the cache is divided into
+	static const int GENERATIONS = 16;
+
+	// permanent memory set aside for allocations made after code is locked
+	static const size_t PERMANENT_POOL_SIZE = 65536;
+
+	// internal helpers
+	drccodeptr alloc_limit() const { return m_generational ? m_limit : m_end; }
+	void new_generation();
+	void evict_generations(drccodeptr start, drccodeptr end);
+
 	// core parameters
 	drccodeptr          m_near;             // pointer to the near part of the cache
 	drccodeptr          m_neartop;          // top of the near part of the cache
@@ -89,6 +117,30 @@ private:
 	drccodeptr          m_codegen;          // start of generated code
 	size_t              m_size;             // size of the cache in bytes
 
+	// generational state
+	struct generation
+	{
+		drccodeptr      m_start;            // first byte of the generation
+		drccodeptr      m_end;              // end of the generation (m_top for the newest)
+	};
+	bool                m_generational;     // true once static code is locked
+	drccodeptr          m_static;           // end of the locked static code
+	drccodeptr          m_limit;            // limit for allocations in the current block
+	drccodeptr          m_wrapend;          // end of the code from before the last wrap
+	drccodeptr          m_flushend;         // value m_end returns to on a flush
+	drccodeptr          m_pool;             // next free byte in the permanent pool
+	drccodeptr          m_poolend;          // end of the permanent pool
+	size_t              m_gensize;          // target size of each generation
+	int                 m_gencount;         // number of live generations
+	generation          m_gen[GENERATIONS]; // live generations, oldest first
+	drc_evict_delegate  m_evict;            // callback for evicted code
+
+	// statistics
+	UINT32              m_flushes;          // number of full flushes
+	UINT32              m_evictions;        // number of generations evicted
+	UINT64              m_evicted_bytes;    // bytes of code evicted
+	UINT64              m_generated_bytes;  // bytes of code generated
+
 	// oob management
 	struct oob_handler
 	{
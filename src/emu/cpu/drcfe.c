@@ -25,6 +25,12 @@
 
 const UINT32 MAX_STACK_DEPTH = 100;
 
+// analysis cache parameters
+const UINT32 ANALYSIS_HASH_BUCKETS = 4096;
+const UINT32 ANALYSIS_MAX_DESCS = 65536;
+const UINT32 ANALYSIS_FILE_VERSION = 2;
+const char ANALYSIS_FILE_MAGIC[8] = "MAMEDFE";
+
 
 
 //**************************************************************************
@@ -39,6 +45,53 @@ struct pc_stack_entry
 };
 
 
+// an opcode_desc as stored in the analysis cache; the descriptions of any
+// delay slots follow their branch directly
+struct drc_analysis_desc
+{
+	offs_t              pc;
+	offs_t              physpc;
+	offs_t              targetpc;
+	UINT8               opptr[16];
+	UINT8               length;
+	UINT8               delayslots;
+	UINT8               skipslots;
+	UINT8               delaycount;                 // number of delay slot descriptions that follow
+	UINT32              flags;
+	UINT32              cycles;
+	UINT32              regin[4];
+	UINT32              regout[4];
+	UINT32              regreq[4];
+};
+
+
+// a cached analysis of the sequence starting at a given PC
+struct drc_analysis_block
+{
+	drc_analysis_block(offs_t startpc, UINT32 mode)
+		: m_next(NULL),
+			m_startpc(startpc),
+			m_mode(mode),
+			m_crc(0) { }
+
+	drc_analysis_block *    m_next;                 // next block in this hash bucket
+	offs_t                  m_startpc;              // PC the sequence was described from
+	UINT32                  m_mode;                 // CPU mode it was described in
+	UINT32                  m_crc;                  // CRC of the opcode bytes covered
+	dynamic_array<drc_analysis_desc> m_desc;        // descriptions in list order
+};
+
+
+// header of an analysis cache file
+struct drc_analysis_header
+{
+	char                magic[8];
+	UINT32              version;
+	UINT32              descsize;
+	UINT32              blocks;
+};
+
+
 
 //**************************************************************************
 //  DRC FRONTEND
@@ -55,8 +108,19 @@ drc_frontend::drc_frontend(device_t &cpu, UINT32 window_start, UINT32 window_end
 		m_cpudevice(downcast<cpu_device &>(cpu)),
 		m_program(m_cpudevice.space(AS_PROGRAM)),
 		m_pageshift(m_cpudevice.space_config(AS_PROGRAM)->m_page_shift),
-		m_desc_array(window_end + window_start + 2, 0)
+		m_desc_array(window_end + window_start + 2, 0),
+		m_analysis_enabled(m_cpudevice.machine().options().drc_analysis_cache()),
+		m_analysis_blocks(0),
+		m_analysis_hits(0),
+		m_analysis_misses(0)
 {
+	// load any analysis saved by a previous run, and save ours at exit
+	if (m_analysis_enabled)
+	{
+		m_analysis_hash.resize_and_clear(ANALYSIS_HASH_BUCKETS);
+		analysis_load();
+		m_cpudevice.machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(drc_frontend::analysis_save), this));
+	}
 }
 
 
@@ -68,6 +132,13 @@ drc_frontend::~drc_frontend()
 {
 	// release any descriptions we've accumulated
 	release_descriptions();
+
+	// release the analysis cache
+	if (m_analysis_enabled)
+	{
+		osd_printf_verbose("%s: %d cached sequences, %d reused, %d described\n", m_cpudevice.tag(), m_analysis_blocks, m_analysis_hits, m_analysis_misses);
+		analysis_free();
+	}
 }
 
 
@@ -77,11 +148,26 @@ drc_frontend::~drc_frontend()
 //  relative to the specified startpc
 //-------------------------------------------------
 
-const opcode_desc *drc_frontend::describe_code(offs_t startpc)
+const opcode_desc *drc_frontend::describe_code(offs_t startpc, UINT32 mode)
 {
 	// release any descriptions we've accumulated
 	release_descriptions();
 
+	// reuse a cached analysis if the code it covers is unchanged
+	drc_analysis_block *cached = NULL;
+	if (m_analysis_enabled)
+	{
+		UINT32 crc;
+		cached = analysis_find(startpc, mode);
+		if (cached != NULL && cached->m_desc.count() != 0 && analysis_checksum(*cached, crc) && crc == cached->m_crc)
+		{
+			m_analysis_hits++;
+			analysis_restore(*cached);
+			return m_desc_live_list.first();
+		}
+		m_analysis_misses++;
+	}
+
 	// add the initial PC to the stack
 	pc_stack_entry pcstack[MAX_STACK_DEPTH];
 	pc_stack_entry *pcstackptr = &pcstack[0];
@@ -146,6 +232,10 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 	// first from startpc -> maxpc, then from minpc -> startpc
 	build_sequence(startpc - minpc, maxpc - minpc, OPFLAG_REDISPATCH);
 	build_sequence(minpc - minpc, startpc - minpc, OPFLAG_RETURN_TO_START);
+
+	// remember the result for next time
+	if (m_analysis_enabled)
+		analysis_store(startpc, mode, cached);
 	return m_desc_live_list.first();
 }
 
@@ -376,3 +466,266 @@ void drc_frontend::release_descriptions()
 	// reclaim all the descriptors
 	m_desc_allocator.reclaim_all(m_desc_live_list);
 }
+
+
+//-------------------------------------------------
+//  analysis_find - find the cached analysis for
+//  the given start PC and mode, if any
+//-------------------------------------------------
+
+drc_analysis_block *drc_frontend::analysis_find(offs_t startpc, UINT32 mode)
+{
+	for (drc_analysis_block *block = m_analysis_hash[startpc % ANALYSIS_HASH_BUCKETS]; block != NULL; block = block->m_next)
+		if (block->m_startpc == startpc && block->m_mode == mode)
+			return block;
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  analysis_checksum - compute the CRC of the
+//  opcode bytes currently in memory under a
+//  cached analysis; returns false if any of them
+//  no longer translates to the same address
+//-------------------------------------------------
+
+bool drc_frontend::analysis_checksum(const drc_analysis_block &block, UINT32 &crc)
+{
+	direct_read_data &direct = m_program.direct();
+	crc32_creator creator;
+
+	for (int descnum = 0; descnum < block.m_desc.count(); descnum++)
+	{
+		const drc_analysis_desc &desc = block.m_desc[descnum];
+
+		// the PC must still map to the same physical address
+		offs_t physpc = desc.pc;
+		if (!m_cpudevice.translate(AS_PROGRAM, TRANSLATE_FETCH, physpc) || physpc != desc.physpc)
+			return false;
+
+		// accumulate the opcode bytes; an instruction can be longer than opptr holds
+		for (int bytenum = 0; bytenum < desc.length; bytenum++)
+		{
+			UINT8 opbyte = direct.read_decrypted_byte(physpc + bytenum);
+			creator.append(&opbyte, 1);
+		}
+	}
+	crc = creator.finish();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  analysis_restore - rebuild the live list of
+//  descriptions from a cached analysis
+//-------------------------------------------------
+
+void drc_frontend::analysis_restore(const drc_analysis_block &block)
+{
+	for (int index = 0; index < block.m_desc.count(); )
+		m_desc_live_list.append(*analysis_restore_one(block, index));
+}
+
+
+//-------------------------------------------------
+//  analysis_restore_one - rebuild a single
+//  description and, recursively, its delay slots
+//-------------------------------------------------
+
+opcode_desc *drc_frontend::analysis_restore_one(const drc_analysis_block &block, int &index)
+{
+	const drc_analysis_desc &src = block.m_desc[index++];
+	opcode_desc *desc = m_desc_allocator.alloc();
+
+	desc->m_next = NULL;
+	desc->branch = NULL;
+	desc->delay.reset();
+	desc->pc = src.pc;
+	desc->physpc = src.physpc;
+	desc->targetpc = src.targetpc;
+	memcpy(&desc->opptr, src.opptr, sizeof(desc->opptr));
+	desc->length = src.length;
+	desc->delayslots = src.delayslots;
+	desc->skipslots = src.skipslots;
+	desc->flags = src.flags;
+	desc->cycles = src.cycles;
+	memcpy(desc->regin, src.regin, sizeof(desc->regin));
+	memcpy(desc->regout, src.regout, sizeof(desc->regout));
+	memcpy(desc->regreq, src.regreq, sizeof(desc->regreq));
+
+	// delay slots follow directly
+	for (int slotnum = 0; slotnum < src.delaycount; slotnum++)
+	{
+		opcode_desc *delaydesc = analysis_restore_one(block, index);
+		delaydesc->branch = desc;
+		desc->delay.append(*delaydesc);
+	}
+	return desc;
+}
+
+
+//-------------------------------------------------
+//  analysis_store - save the live list of
+//  descriptions in the analysis cache, reusing
+//  the stale block for this PC and mode if there
+//  is one
+//-------------------------------------------------
+
+void drc_frontend::analysis_store(offs_t startpc, UINT32 mode, drc_analysis_block *block)
+{
+	// allocate a new block if we don't have one to reuse
+	bool newblock = (block == NULL);
+	if (newblock)
+		block = global_alloc(drc_analysis_block(startpc, mode));
+	block->m_desc.reset();
+
+	// flatten the list; sequences that hit page faults are not worth keeping
+	bool valid = true;
+	for (const opcode_desc *desc = m_desc_live_list.first(); desc != NULL && valid; desc = desc->next())
+		valid = analysis_store_one(*block, *desc);
+
+	// the checksum must be computable now for the block to be usable later
+	if (valid)
+		valid = analysis_checksum(*block, block->m_crc);
+
+	// link new blocks into the hash; drop invalid ones
+	if (newblock && valid)
+	{
+		drc_analysis_block *&bucket = m_analysis_hash[startpc % ANALYSIS_HASH_BUCKETS];
+		block->m_next = bucket;
+		bucket = block;
+		m_analysis_blocks++;
+	}
+	else if (newblock)
+		global_free(block);
+	else if (!valid)
+		block->m_desc.reset();
+}
+
+
+//-------------------------------------------------
+//  analysis_store_one - append a description
+//  and, recursively, its delay slots to a cached
+//  analysis
+//-------------------------------------------------
+
+bool drc_frontend::analysis_store_one(drc_analysis_block &block, const opcode_desc &desc)
+{
+	if ((desc.flags & (OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_COMPILER_UNMAPPED)) != 0 || block.m_desc.count() >= ANALYSIS_MAX_DESCS)
+		return false;
+
+	drc_analysis_desc &dst = block.m_desc.append();
+	dst.pc = desc.pc;
+	dst.physpc = desc.physpc;
+	dst.targetpc = desc.targetpc;
+	memcpy(dst.opptr, &desc.opptr, sizeof(dst.opptr));
+	dst.length = desc.length;
+	dst.delayslots = desc.delayslots;
+	dst.skipslots = desc.skipslots;
+	dst.delaycount = desc.delay.count();
+	dst.flags = desc.flags;
+	dst.cycles = desc.cycles;
+	memcpy(dst.regin, desc.regin, sizeof(dst.regin));
+	memcpy(dst.regout, desc.regout, sizeof(dst.regout));
+	memcpy(dst.regreq, desc.regreq, sizeof(dst.regreq));
+
+	for (const opcode_desc *delaydesc = desc.delay.first(); delaydesc != NULL; delaydesc = delaydesc->next())
+		if (!analysis_store_one(block, *delaydesc))
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  analysis_load - read the analysis cache saved
+//  by a previous run of this machine
+//-------------------------------------------------
+
+void drc_frontend::analysis_load()
+{
+	running_machine &machine = m_cpudevice.machine();
+	emu_file file(machine.options().drccache_directory(), OPEN_FLAG_READ);
+	if (file.open(machine.basename(), PATH_SEPARATOR, m_cpudevice.basetag(), ".dfe") != FILERR_NONE)
+		return;
+
+	// validate the header; the file is in native byte order
+	drc_analysis_header header;
+	if (file.read(&header, sizeof(header)) != sizeof(header) || memcmp(header.magic, ANALYSIS_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+		header.version != ANALYSIS_FILE_VERSION || header.descsize != sizeof(drc_analysis_desc))
+		return;
+
+	// read each block
+	for (UINT32 blocknum = 0; blocknum < header.blocks; blocknum++)
+	{
+		UINT32 info[4];
+		if (file.read(info, sizeof(info)) != sizeof(info) || info[3] == 0 || info[3] > ANALYSIS_MAX_DESCS || analysis_find(info[0], info[1]) != NULL)
+			break;
+
+		drc_analysis_block *block = global_alloc(drc_analysis_block(info[0], info[1]));
+		block->m_crc = info[2];
+		block->m_desc.resize(info[3]);
+		if (file.read(&block->m_desc[0], block->m_desc.bytes()) != block->m_desc.bytes())
+		{
+			global_free(block);
+			break;
+		}
+
+		drc_analysis_block *&bucket = m_analysis_hash[block->m_startpc % ANALYSIS_HASH_BUCKETS];
+		block->m_next = bucket;
+		bucket = block;
+		m_analysis_blocks++;
+	}
+}
+
+
+//-------------------------------------------------
+//  analysis_save - write the analysis cache out
+//  at machine exit
+//-------------------------------------------------
+
+void drc_frontend::analysis_save()
+{
+	running_machine &machine = m_cpudevice.machine();
+	emu_file file(machine.options().drccache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(machine.basename(), PATH_SEPARATOR, m_cpudevice.basetag(), ".dfe") != FILERR_NONE)
+		return;
+
+	// count the blocks worth saving
+	drc_analysis_header header;
+	memcpy(header.magic, ANALYSIS_FILE_MAGIC, sizeof(header.magic));
+	header.version = ANALYSIS_FILE_VERSION;
+	header.descsize = sizeof(drc_analysis_desc);
+	header.blocks = 0;
+	for (int bucketnum = 0; bucketnum < m_analysis_hash.count(); bucketnum++)
+		for (drc_analysis_block *block = m_analysis_hash[bucketnum]; block != NULL; block = block->m_next)
+			if (block->m_desc.count() != 0)
+				header.blocks++;
+	file.write(&header, sizeof(header));
+
+	// then write them
+	for (int bucketnum = 0; bucketnum < m_analysis_hash.count(); bucketnum++)
+		for (drc_analysis_block *block = m_analysis_hash[bucketnum]; block != NULL; block = block->m_next)
+			if (block->m_desc.count() != 0)
+			{
+				UINT32 info[4] = { block->m_startpc, block->m_mode, block->m_crc, UINT32(block->m_desc.count()) };
+				file.write(info, sizeof(info));
+				file.write(&block->m_desc[0], block->m_desc.bytes());
+			}
+}
+
+
+//-------------------------------------------------
+//  analysis_free - release all cached analyses
+//-------------------------------------------------
+
+void drc_frontend::analysis_free()
+{
+	for (int bucketnum = 0; bucketnum < m_analysis_hash.count(); bucketnum++)
+		while (m_analysis_hash[bucketnum] != NULL)
+		{
+			drc_analysis_block *block = m_analysis_hash[bucketnum];
+			m_analysis_hash[bucketnum] = block->m_next;
+			global_free(block);
+		}
+	m_analysis_blocks = 0;
+}
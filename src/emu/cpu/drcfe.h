@@ -27,6 +27,13 @@
     walkthrough is finished, these descriptions are assembled together into
     a linked list and returned for further processing by the backend.
 
+    With -drc_analysis_cache, the finished description lists are also kept
+    per start PC and CPU mode, together with a CRC of the opcode bytes they
+    cover, and saved to the drccache directory at exit. A later request for
+    the same start PC in the same mode reuses the stored list if the covered
+    code still translates to the same physical addresses and still has the
+    same CRC.
+
 ***************************************************************************/
 
 #pragma once
@@ -122,6 +129,10 @@ struct opcode_desc
 };
 
 
+// a cached analysis of one sequence (opaque)
+struct drc_analysis_block;
+
+
 // DRC frontend state
 class drc_frontend
 {
@@ -130,8 +141,9 @@ public:
 	drc_frontend(device_t &cpu, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
 	virtual ~drc_frontend();
 
-	// describe a block
-	const opcode_desc *describe_code(offs_t startpc);
+	// describe a block; mode is whatever the CPU's describe() depends on
+	// besides the code itself, e.g. ARM vs Thumb
+	const opcode_desc *describe_code(offs_t startpc, UINT32 mode = 0);
 
 protected:
 	// required overrides
@@ -144,6 +156,17 @@ private:
 	void accumulate_required_backwards(opcode_desc &desc, UINT32 *reqmask);
 	void release_descriptions();
 
+	// analysis cache helpers
+	drc_analysis_block *analysis_find(offs_t startpc, UINT32 mode);
+	bool analysis_checksum(const drc_analysis_block &block, UINT32 &crc);
+	void analysis_restore(const drc_analysis_block &block);
+	opcode_desc *analysis_restore_one(const drc_analysis_block &block, int &index);
+	void analysis_store(offs_t startpc, UINT32 mode, drc_analysis_block *block);
+	bool analysis_store_one(drc_analysis_block &block, const opcode_desc &desc);
+	void analysis_load();
+	void analysis_save();
+	void analysis_free();
+
 	// configuration parameters
 	UINT32              m_window_start;             // code window start offset = startpc - window_start
 	UINT32              m_window_end;               // code window end offset = startpc + window_end
@@ -158,6 +181,13 @@ private:
 	simple_list<opcode_desc> m_desc_live_list;      // list of live descriptions
 	fixed_allocator<opcode_desc> m_desc_allocator;  // fixed allocator for descriptions
 	dynamic_array<opcode_desc *> m_desc_array;      // array of descriptions in PC order
+
+	// analysis cache
+	bool                m_analysis_enabled;         // true if the analysis cache is in use
+	dynamic_array<drc_analysis_block *> m_analysis_hash; // hash buckets by start PC
+	UINT32              m_analysis_blocks;          // number of cached sequences
+	UINT32              m_analysis_hits;            // sequences reused from the cache
+	UINT32              m_analysis_misses;          // sequences described from scratch
 };
 
 
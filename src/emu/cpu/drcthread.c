@@ -0,0 +1,298 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    drcthread.c
+
+    Shared code generation for call-threaded recompilers.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcthread.h"
+#include "drcumlsh.h"
+
+using namespace uml;
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  alloc_handle - allocate a handle if not
+//  already allocated
+//-------------------------------------------------
+
+inline void alloc_handle(drcuml_state &drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == NULL)
+		*handleptr = drcuml.handle_alloc(name);
+}
+
+
+
+//**************************************************************************
+//  DRC THREADED COMPILER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_threaded_compiler - constructor
+//-------------------------------------------------
+
+drc_threaded_compiler::drc_threaded_compiler(device_t &cpu, size_t cache_bytes, int modes, int ignorebits, UINT32 &nextpc)
+	: m_cpu(cpu),
+		m_cache(cache_bytes),
+		m_drcuml(cpu, m_cache, 0, modes, 32, ignorebits),
+		m_dispatch(NULL),
+		m_nocode(NULL),
+		m_nextpc(nextpc),
+		m_dirty(true),
+		m_labelnum(1)
+{
+	m_drcuml.symbol_add(&m_nextpc, sizeof(m_nextpc), "nextpc");
+}
+
+
+//-------------------------------------------------
+//  ~drc_threaded_compiler - destructor
+//-------------------------------------------------
+
+drc_threaded_compiler::~drc_threaded_compiler()
+{
+}
+
+
+//-------------------------------------------------
+//  execute - run compiled code, compiling or
+//  interpreting whatever is missing, until the
+//  dispatcher runs out of cycles
+//-------------------------------------------------
+
+void drc_threaded_compiler::execute()
+{
+	int result;
+
+	do
+	{
+		// the code may have moved since the last exit
+		if (m_dirty)
+			flush_cache();
+
+		prepare_execute();
+		result = m_drcuml.execute(*m_dispatch);
+
+		// compile what the front end can see; interpret anything else
+		if (result == EXECUTE_MISSING_CODE)
+		{
+			if (m_dirty)
+				flush_cache();
+			if (!compile_current())
+				interpret();
+		}
+		else if (result == EXECUTE_INTERPRET)
+			interpret();
+		else if (result != EXECUTE_OUT_OF_CYCLES)
+			handle_exit(result);
+	} while (result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+//-------------------------------------------------
+//  sequence_starts_at - return true if a sequence
+//  in the block starts at the given PC and so
+//  has a label
+//-------------------------------------------------
+
+bool drc_threaded_compiler::sequence_starts_at(const opcode_desc *desclist, offs_t pc)
+{
+	bool head = true;
+	for (const opcode_desc *desc = desclist; desc != NULL; desc = desc->next())
+	{
+		if (head && desc->pc == pc)
+			return true;
+		head = ((desc->flags & OPFLAG_END_SEQUENCE) != 0);
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  flush_cache - flush the cache and regenerate
+//  static code
+//-------------------------------------------------
+
+void drc_threaded_compiler::flush_cache()
+{
+	// empty the transient cache contents
+	m_drcuml.reset();
+
+	try
+	{
+		// generate the out-of-code handler; it exits with the PC where code is missing
+		drcuml_block *block = m_drcuml.begin_block(10);
+		alloc_handle(m_drcuml, &m_nocode, "nocode");
+		UML_HANDLE(block, *m_nocode);                                                       // handle  nocode
+		generate_nocode(block);
+		block->end();
+
+		// generate the dispatcher, which every block also leaves through
+		block = m_drcuml.begin_block(40);
+		alloc_handle(m_drcuml, &m_dispatch, "dispatch");
+		UML_HANDLE(block, *m_dispatch);                                                     // handle  dispatch
+		generate_dispatch(block);
+		block->end();
+
+		// from here on, evict old blocks rather than flushing when the cache fills
+		m_drcuml.lock_static_code();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate static code for %s\n", m_cpu.tag());
+	}
+
+	m_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  compile_block - compile the sequences in a
+//  description list
+//-------------------------------------------------
+
+void drc_threaded_compiler::compile_block(const opcode_desc *desclist, UINT32 mode)
+{
+	const opcode_desc *seqhead, *seqlast;
+	bool override = false;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	// if we get an error back, flush the cache and try again
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			// start the block
+			drcuml_block *block = m_drcuml.begin_block(8192);
+			m_labelnum = 1;
+
+			// loop until we get through all instruction sequences
+			for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			{
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != NULL);
+
+				// if we don't have a hash for this PC, or if we are overriding all, add one
+				if (override || !m_drcuml.hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,seqhead->pc
+
+				// if we already have a hash, and this is the first sequence, assume that we
+				// are recompiling due to being out of sync and allow future overrides
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,seqhead->pc
+				}
+
+				// otherwise, redispatch to that fixed PC and skip the rest of the processing
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp mode,seqhead->pc,nocode
+					continue;
+				}
+
+				// every sequence can be jumped to locally
+				UML_LABEL(block, seqhead->pc | 0x80000000);                                 // label   seqhead->pc | 0x80000000
+
+				// validate the sequence if the CPU wants to
+				if (!(seqhead->flags & OPFLAG_INVALID_OPCODE))
+					generate_sequence_check(block, seqhead, seqlast);
+
+				// iterate over instructions in the sequence and compile them
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_instruction(block, desclist, curdesc, curdesc == seqlast);
+			}
+
+			// end the sequence
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			flush_cache();
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_nocode - generate the rest of the
+//  out-of-code handler; by default the CPU state
+//  already says where to compile
+//-------------------------------------------------
+
+void drc_threaded_compiler::generate_nocode(drcuml_block *block)
+{
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                                  // exit    EXECUTE_MISSING_CODE
+}
+
+
+//-------------------------------------------------
+//  generate_invalid - generate the code for an
+//  instruction the front end couldn't describe
+//-------------------------------------------------
+
+void drc_threaded_compiler::generate_invalid(drcuml_block *block, const opcode_desc *desc)
+{
+	UML_EXIT(block, EXECUTE_INTERPRET);                                                     // exit    EXECUTE_INTERPRET
+}
+
+
+//-------------------------------------------------
+//  generate_instruction - generate the code for
+//  one instruction and the check of where it
+//  left the CPU
+//-------------------------------------------------
+
+void drc_threaded_compiler::generate_instruction(drcuml_block *block, const opcode_desc *desclist, const opcode_desc *desc, bool last)
+{
+	offs_t nextpc = desc->pc + desc->length;
+
+	// code the front end couldn't describe goes to the interpreter
+	if (desc->flags & OPFLAG_INVALID_OPCODE)
+	{
+		generate_invalid(block, desc);
+		return;
+	}
+
+	// run the instruction
+	generate_call(block, desc);
+
+	// take static branches to targets compiled in this block
+	if ((desc->flags & OPFLAG_INTRABLOCK_BRANCH) && desc->targetpc != BRANCH_TARGET_DYNAMIC && sequence_starts_at(desclist, desc->targetpc))
+	{
+		UML_CMP(block, mem(&m_nextpc), expected_nextpc(desc, desc->targetpc));              // cmp     [nextpc],desc->targetpc
+		UML_JMPc(block, COND_E, desc->targetpc | 0x80000000);                               // jmp     desc->targetpc | 0x80000000,e
+	}
+
+	// within a sequence, fall through to the next instruction
+	if (!last)
+	{
+		UML_CMP(block, mem(&m_nextpc), expected_nextpc(desc, nextpc));                      // cmp     [nextpc],nextpc
+		UML_EXHc(block, COND_NE, *m_dispatch, 0);                                           // exh     dispatch,0,ne
+		return;
+	}
+
+	// at the end of one, jump to the next if it is compiled here, or redispatch
+	if (!(desc->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH) && sequence_starts_at(desclist, nextpc))
+	{
+		UML_CMP(block, mem(&m_nextpc), expected_nextpc(desc, nextpc));                      // cmp     [nextpc],nextpc
+		UML_JMPc(block, COND_E, nextpc | 0x80000000);                                       // jmp     nextpc | 0x80000000,e
+	}
+	UML_EXH(block, *m_dispatch, 0);                                                         // exh     dispatch,0
+}
@@ -0,0 +1,107 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    drcthread.h
+
+    Shared code generation for call-threaded recompilers.
+
+****************************************************************************
+
+    Concepts:
+
+    A call-threaded recompiler compiles each instruction into a call to
+    the interpreter's handler for it, so the two cores cannot disagree
+    about what an instruction does; what goes away is the per-instruction
+    fetch and the loop around it. Instructions that are worth it may be
+    compiled to UML directly instead, falling back to the call when the
+    fast path doesn't apply.
+
+    After each instruction the CPU leaves the address it will fetch from
+    next in a "nextpc" variable, or ~0 to leave the block (out of cycles,
+    a mode change, or anything else the generated code must not assume).
+    The generated code compares it with the instruction's static
+    successors: those compiled in the same block are jumped to directly,
+    anything else redispatches through the hash table.
+
+    This class owns the code cache and UML state, the dispatcher and
+    out-of-code handlers, the block compiler and the run loop. Each CPU
+    derives from it to supply the dispatcher's checks, the code for one
+    instruction, and what to do with code that isn't compiled.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCTHREAD_H__
+#define __DRCTHREAD_H__
+
+#include "drccache.h"
+#include "drcfe.h"
+#include "drcuml.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> drc_threaded_compiler
+
+class drc_threaded_compiler
+{
+public:
+	// exit codes from the generated code; CPUs number their own from EXECUTE_CPU_SPECIFIC
+	enum
+	{
+		EXECUTE_OUT_OF_CYCLES = 0,
+		EXECUTE_MISSING_CODE,
+		EXECUTE_INTERPRET,
+		EXECUTE_CPU_SPECIFIC
+	};
+
+	// construction/destruction
+	drc_threaded_compiler(device_t &cpu, size_t cache_bytes, int modes, int ignorebits, UINT32 &nextpc);
+	virtual ~drc_threaded_compiler();
+
+	// run compiled code until the dispatcher runs out of cycles
+	void execute();
+
+	// throw away everything compiled before the next run
+	void set_dirty() { m_dirty = true; }
+
+protected:
+	// run loop hooks: compile or interpret code at the current PC
+	virtual bool compile_current() = 0;
+	virtual void interpret() = 0;
+	virtual void prepare_execute() { }
+	virtual void handle_exit(int result) { }
+
+	// code generation hooks
+	virtual void generate_dispatch(drcuml_block *block) = 0;
+	virtual void generate_nocode(drcuml_block *block);
+	virtual void generate_sequence_check(drcuml_block *block, const opcode_desc *seqhead, const opcode_desc *seqlast) { }
+	virtual void generate_invalid(drcuml_block *block, const opcode_desc *desc);
+	virtual void generate_call(drcuml_block *block, const opcode_desc *desc) = 0;
+	virtual UINT32 expected_nextpc(const opcode_desc *desc, offs_t pc) { return pc; }
+
+	// helpers
+	void compile_block(const opcode_desc *desclist, UINT32 mode);
+	uml::code_label alloc_label() { return m_labelnum++; }
+	static bool sequence_starts_at(const opcode_desc *desclist, offs_t pc);
+
+	// internal state
+	device_t &          m_cpu;              // CPU we are compiling for
+	drc_cache           m_cache;            // code cache
+	drcuml_state        m_drcuml;           // UML generator state
+	uml::code_handle *  m_dispatch;         // dispatcher and entry point
+	uml::code_handle *  m_nocode;           // exit when no code exists for a PC
+	UINT32 &            m_nextpc;           // where the last instruction left the CPU, ~0 to leave the block
+	bool                m_dirty;            // true if the cache must be flushed before running
+	uml::code_label     m_labelnum;         // next free local label in the current block
+
+private:
+	void flush_cache();
+	void generate_instruction(drcuml_block *block, const opcode_desc *desclist, const opcode_desc *desc, bool last);
+};
+
+
+#endif /* __DRCTHREAD_H__ */
@@ -10,9 +10,6 @@
 
     Future improvements/changes:
 
-    * UML optimizer:
-        - constant folding
-
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
         - checks behavior of all opcodes
@@ -53,6 +50,16 @@ using namespace uml;
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// cache space kept free when starting a block: per instruction, plus room for map data
+const size_t BLOCK_CACHE_BYTES_PER_INST = 32;
+const size_t BLOCK_CACHE_SLOP_BYTES = 65536;
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -69,6 +76,337 @@ struct bevalidate_test
 
 
 
+// tracks register and memory values that are known while optimizing a block
+class uml_value_tracker
+{
+public:
+	// construction
+	uml_value_tracker() { reset(); }
+
+	// tracking
+	void reset();
+	void substitute(instruction &inst) const;
+	void update(instruction &inst);
+
+private:
+	// a memory location known to hold an immediate or the value of a register
+	struct memory_value
+	{
+		void *          m_base;             // pointer to the memory
+		UINT8           m_size;             // size of the access in bytes
+		parameter       m_value;            // immediate or integer register
+	};
+
+	// internal helpers
+	int find_memory(void *base, UINT8 size) const;
+	void forget_register(int regnum);
+	void forget_memory(void *base, UINT8 size);
+	void remember_memory(void *base, UINT8 size, const parameter &value);
+
+	// constants
+	static const int MAX_MEMORY_VALUES = 16;
+
+	// internal state
+	UINT8           m_regsize[REG_I_COUNT];         // bytes of each register with a known value
+	UINT64          m_regvalue[REG_I_COUNT];        // known value of each register
+	int             m_memcount;                     // number of known memory locations
+	memory_value    m_memory[MAX_MEMORY_VALUES];    // known memory locations
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  is_block_boundary - return true if control can
+//  enter or leave the block at this instruction,
+//  or if it may read or modify arbitrary state
+//-------------------------------------------------
+
+inline bool is_block_boundary(const instruction &inst)
+{
+	switch (inst.opcode())
+	{
+		case OP_HANDLE:
+		case OP_HASH:
+		case OP_LABEL:
+		case OP_DEBUG:
+		case OP_EXIT:
+		case OP_HASHJMP:
+		case OP_JMP:
+		case OP_EXH:
+		case OP_CALLH:
+		case OP_RET:
+		case OP_CALLC:
+		case OP_RECOVER:
+		case OP_SAVE:
+		case OP_RESTORE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  is_integer_op - return true if the opcode is
+//  one of the integer operations
+//-------------------------------------------------
+
+inline bool is_integer_op(const instruction &inst)
+{
+	return (inst.opcode() >= OP_LOAD && inst.opcode() <= OP_RORC);
+}
+
+
+//-------------------------------------------------
+//  has_side_effects - return true if executing the
+//  instruction does more than write its output
+//  parameters
+//-------------------------------------------------
+
+inline bool has_side_effects(const instruction &inst)
+{
+	switch (inst.opcode())
+	{
+		case OP_LOAD:   case OP_LOADS:  case OP_SET:    case OP_MOV:
+		case OP_SEXT:   case OP_ROLAND: case OP_ROLINS: case OP_ADD:
+		case OP_ADDC:   case OP_SUB:    case OP_SUBB:   case OP_MULU:
+		case OP_MULS:   case OP_DIVU:   case OP_DIVS:   case OP_AND:
+		case OP_OR:     case OP_XOR:    case OP_LZCNT:  case OP_BSWAP:
+		case OP_SHL:    case OP_SHR:    case OP_SAR:    case OP_ROL:
+		case OP_ROLC:   case OP_ROR:    case OP_RORC:
+			return false;
+
+		default:
+			return true;
+	}
+}
+
+
+//-------------------------------------------------
+//  size_mask - return a mask covering an access
+//  of the given size in bytes
+//-------------------------------------------------
+
+inline UINT64 size_mask(UINT8 size)
+{
+	return (size >= 8) ? ~U64(0) : ((U64(1) << (size * 8)) - 1);
+}
+
+
+
+//**************************************************************************
+//  UML VALUE TRACKER
+//**************************************************************************
+
+//-------------------------------------------------
+//  reset - forget everything we know
+//-------------------------------------------------
+
+void uml_value_tracker::reset()
+{
+	memset(m_regsize, 0, sizeof(m_regsize));
+	memset(m_regvalue, 0, sizeof(m_regvalue));
+	m_memcount = 0;
+}
+
+
+//-------------------------------------------------
+//  substitute - replace input parameters with
+//  known immediates or register copies
+//-------------------------------------------------
+
+void uml_value_tracker::substitute(instruction &inst) const
+{
+	// only integer operations are rewritten
+	if (!is_integer_op(inst))
+		return;
+
+	for (int pnum = 0; pnum < inst.numparams(); pnum++)
+	{
+		// only pure inputs can be replaced
+		if (!inst.param_is_input(pnum) || inst.param_is_output(pnum))
+			continue;
+		parameter param = inst.param(pnum);
+		UINT8 size = inst.param_size(pnum);
+
+		// memory whose contents are known becomes an immediate or a register
+		if (param.is_memory() && inst.param_allows(pnum, parameter::PTYPE_INT_REGISTER))
+		{
+			int memnum = find_memory(param.memory(), size);
+			if (memnum != -1 && inst.param_allows(pnum, m_memory[memnum].m_value.type()))
+				param = m_memory[memnum].m_value;
+		}
+
+		// registers whose contents are known become immediates
+		if (param.is_int_register() && m_regsize[param.ireg() - REG_I0] >= size && inst.param_allows(pnum, parameter::PTYPE_IMMEDIATE))
+			param = m_regvalue[param.ireg() - REG_I0] & size_mask(size);
+
+		if (param != inst.param(pnum))
+			inst.set_param(pnum, param);
+	}
+}
+
+
+//-------------------------------------------------
+//  update - account for the effects of an
+//  instruction, removing stores of values that
+//  memory already holds
+//-------------------------------------------------
+
+void uml_value_tracker::update(instruction &inst)
+{
+	// anything that transfers control or calls out invalidates everything
+	if (is_block_boundary(inst))
+	{
+		reset();
+		return;
+	}
+
+	// a store of the value the memory already holds can be removed
+	bool always = (inst.condition() == COND_ALWAYS);
+	if (inst.opcode() == OP_MOV && always && inst.param(0).is_memory())
+	{
+		int memnum = find_memory(inst.param(0).memory(), inst.size());
+		if (memnum != -1 && m_memory[memnum].m_value == inst.param(1))
+		{
+			inst.nop();
+			return;
+		}
+	}
+
+	// memory handlers and indexed stores may modify any memory
+	switch (inst.opcode())
+	{
+		case OP_STORE:
+		case OP_READ:
+		case OP_READM:
+		case OP_WRITE:
+		case OP_WRITEM:
+		case OP_FSTORE:
+		case OP_FREAD:
+		case OP_FWRITE:
+			m_memcount = 0;
+			break;
+
+		default:
+			break;
+	}
+
+	// forget anything the outputs overwrite
+	for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		if (inst.param_is_output(pnum))
+		{
+			const parameter &param = inst.param(pnum);
+			if (param.is_int_register())
+				forget_register(param.ireg());
+			else if (param.is_memory())
+				forget_memory(param.memory(), inst.param_size(pnum));
+		}
+
+	// only unconditional moves establish new values
+	if (inst.opcode() != OP_MOV || !always)
+		return;
+	const parameter &dst = inst.param(0);
+	const parameter &src = inst.param(1);
+	UINT8 size = inst.size();
+
+	if (dst.is_int_register())
+	{
+		int regnum = dst.ireg() - REG_I0;
+		if (src.is_immediate())
+		{
+			m_regsize[regnum] = size;
+			m_regvalue[regnum] = src.immediate() & size_mask(size);
+		}
+		else if (src.is_memory())
+			remember_memory(src.memory(), size, dst);
+	}
+	else if (dst.is_memory())
+	{
+		if (src.is_immediate())
+			remember_memory(dst.memory(), size, src.immediate() & size_mask(size));
+		else if (src.is_int_register())
+			remember_memory(dst.memory(), size, src);
+	}
+}
+
+
+//-------------------------------------------------
+//  find_memory - find a known memory location of
+//  exactly the given size
+//-------------------------------------------------
+
+int uml_value_tracker::find_memory(void *base, UINT8 size) const
+{
+	for (int memnum = 0; memnum < m_memcount; memnum++)
+		if (m_memory[memnum].m_base == base && m_memory[memnum].m_size == size)
+			return memnum;
+	return -1;
+}
+
+
+//-------------------------------------------------
+//  forget_register - forget the value of a
+//  register and any memory copies of it
+//-------------------------------------------------
+
+void uml_value_tracker::forget_register(int regnum)
+{
+	m_regsize[regnum - REG_I0] = 0;
+	for (int memnum = 0; memnum < m_memcount; )
+		if (m_memory[memnum].m_value.is_int_register() && m_memory[memnum].m_value.ireg() == regnum)
+			m_memory[memnum] = m_memory[--m_memcount];
+		else
+			memnum++;
+}
+
+
+//-------------------------------------------------
+//  forget_memory - forget any known memory
+//  locations overlapping the given range
+//-------------------------------------------------
+
+void uml_value_tracker::forget_memory(void *base, UINT8 size)
+{
+	UINT8 *start = reinterpret_cast<UINT8 *>(base);
+	for (int memnum = 0; memnum < m_memcount; )
+	{
+		UINT8 *memstart = reinterpret_cast<UINT8 *>(m_memory[memnum].m_base);
+		if (memstart < start + size && start < memstart + m_memory[memnum].m_size)
+			m_memory[memnum] = m_memory[--m_memcount];
+		else
+			memnum++;
+	}
+}
+
+
+//-------------------------------------------------
+//  remember_memory - note that a memory location
+//  holds the given value, dropping the oldest
+//  entry if we are full
+//-------------------------------------------------
+
+void uml_value_tracker::remember_memory(void *base, UINT8 size, const parameter &value)
+{
+	if (m_memcount == MAX_MEMORY_VALUES)
+	{
+		for (int memnum = 1; memnum < MAX_MEMORY_VALUES; memnum++)
+			m_memory[memnum - 1] = m_memory[memnum];
+		m_memcount--;
+	}
+	m_memory[m_memcount].m_base = base;
+	m_memory[m_memcount].m_size = size;
+	m_memory[m_memcount].m_value = value;
+	m_memcount++;
+}
+
+
+
 //**************************************************************************
 //  DRC BACKEND INTERFACE
 //**************************************************************************
@@ -124,8 +462,14 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 		m_beintf(device.machine().options().drc_use_c() ?
 			*static_cast<drcbe_interface *>(auto_alloc(device.machine(), drcbe_c(*this, device, cache, flags, modes, addrbits, ignorebits))) :
 			*static_cast<drcbe_interface *>(auto_alloc(device.machine(), drcbe_native(*this, device, cache, flags, modes, addrbits, ignorebits)))),
-		m_umllog(NULL)
+		m_umllog(NULL),
+		m_blocks(0),
+		m_dispatches(0),
+		m_generate_ticks(0)
 {
+	// forget about any code the cache evicts
+	m_cache.set_evict_callback(drc_evict_delegate(FUNC(drcuml_state::evict_code), this));
+
 	// if we're to log, create the logfile
 	if (device.machine().options().drc_log_uml())
 	{
@@ -141,6 +485,16 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 
 drcuml_state::~drcuml_state()
 {
+	// report how the cache behaved
+	if (m_blocks > 0)
+	{
+		double seconds = (double)m_generate_ticks / (double)osd_ticks_per_second();
+		osd_printf_verbose("%s: %u blocks compiled (%.1f KB/s), %u flushes, %u evictions (%u KB), %.1f%% of dispatches found code\n",
+				m_device.tag(), m_blocks, (seconds > 0) ? (double)m_cache.generated_bytes() / 1024.0 / seconds : 0.0,
+				m_cache.flushes(), m_cache.evictions(), UINT32(m_cache.evicted_bytes() / 1024),
+				(m_dispatches > m_blocks) ? 100.0 * (double)(m_dispatches - m_blocks) / (double)m_dispatches : 0.0);
+	}
+
 	// free the back-end
 	auto_free(m_device.machine(), &m_beintf);
 
@@ -188,6 +542,50 @@ void drcuml_state::reset()
 }
 
 
+//-------------------------------------------------
+//  lock_static_code - mark the code generated
+//  since the last reset as static; blocks
+//  generated later are evicted oldest first when
+//  the cache fills, instead of requiring a reset
+//-------------------------------------------------
+
+void drcuml_state::lock_static_code()
+{
+	m_cache.lock_static();
+}
+
+
+//-------------------------------------------------
+//  generate - generate native code for a block
+//  via the back-end
+//-------------------------------------------------
+
+void drcuml_state::generate(drcuml_block &block, instruction *instructions, UINT32 count)
+{
+	osd_ticks_t start = osd_ticks();
+	m_beintf.generate(block, instructions, count);
+	m_generate_ticks += osd_ticks() - start;
+	m_blocks++;
+}
+
+
+//-------------------------------------------------
+//  evict_code - forget about any code in the
+//  given range, which the cache has evicted
+//-------------------------------------------------
+
+void drcuml_state::evict_code(drccodeptr start, drccodeptr end)
+{
+	// handles should only ever point to static code
+	for (code_handle *handle = m_handlelist.first(); handle != NULL; handle = handle->next())
+		if (*handle->m_code >= start && *handle->m_code < end)
+			*handle->m_code = NULL;
+
+	// let the back-end drop its hash entries
+	m_beintf.invalidate_code(start, end);
+}
+
+
 //-------------------------------------------------
 //  begin_block - begin a new code block
 //-------------------------------------------------
@@ -204,6 +602,9 @@ drcuml_block *drcuml_state::begin_block(UINT32 maxinst)
 	if (bestblock == NULL)
 		bestblock = &m_blocklist.append(*global_alloc(drcuml_block(*this, maxinst * 3/2)));
 
+	// make sure the cache has room for it
+	m_cache.reserve_block(bestblock->maxinst() * BLOCK_CACHE_BYTES_PER_INST + BLOCK_CACHE_SLOP_BYTES);
+
 	// start the block
 	bestblock->begin();
 	return bestblock;
@@ -411,6 +812,7 @@ void drcuml_block::append_comment(const char *format, ...)
 void drcuml_block::optimize()
 {
 	UINT32 mapvar[MAPVAR_COUNT] = { 0 };
+	uml_value_tracker tracker;
 
 	// iterate over instructions
 	for (int instnum = 0; instnum < m_nextinst; instnum++)
@@ -444,8 +846,76 @@ void drcuml_block::optimize()
 				if (inst.param(pnum).is_mapvar())
 					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - MAPVAR_M0]);
 
-		// now that flags are correct, simplify the instruction
+		// fold in known register and memory values, then simplify the instruction
+		tracker.substitute(inst);
 		inst.simplify();
+		tracker.update(inst);
+	}
+
+	// finally, drop any register writes that are never read
+	remove_dead_code();
+}
+
+
+//-------------------------------------------------
+//  remove_dead_code - walk the block backwards
+//  and turn integer register writes that are
+//  overwritten before being read into NOPs
+//-------------------------------------------------
+
+void drcuml_block::remove_dead_code()
+{
+	// registers are live at the end of the block; the upper halves are tracked separately
+	const UINT32 alllive = (1 << REG_I_COUNT) - 1;
+	UINT32 livelo = alllive;
+	UINT32 livehi = alllive;
+
+	for (int instnum = m_nextinst - 1; instnum >= 0; instnum--)
+	{
+		instruction &inst = m_inst[instnum];
+
+		// control may enter or leave here, so assume everything is read
+		if (is_block_boundary(inst))
+		{
+			livelo = livehi = alllive;
+			continue;
+		}
+
+		// see if all of the outputs are registers that nobody reads
+		bool always = (inst.condition() == COND_ALWAYS);
+		bool dead = (always && inst.flags() == 0 && !has_side_effects(inst));
+		for (int pnum = 0; dead && pnum < inst.numparams(); pnum++)
+			if (inst.param_is_output(pnum))
+			{
+				const parameter &param = inst.param(pnum);
+				dead = (param.is_int_register() && ((livelo | livehi) & (1 << (param.ireg() - REG_I0))) == 0);
+			}
+		if (dead)
+		{
+			inst.nop();
+			continue;
+		}
+
+		// unconditional writes end the liveness of what they overwrite
+		if (always)
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param_is_output(pnum) && inst.param(pnum).is_int_register())
+				{
+					UINT32 regmask = 1 << (inst.param(pnum).ireg() - REG_I0);
+					livelo &= ~regmask;
+					if (inst.param_size(pnum) == 8)
+						livehi &= ~regmask;
+				}
+
+		// inputs are live before the instruction
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (inst.param_is_input(pnum) && inst.param(pnum).is_int_register())
+			{
+				UINT32 regmask = 1 << (inst.param(pnum).ireg() - REG_I0);
+				livelo |= regmask;
+				if (inst.param_size(pnum) == 8)
+					livehi |= regmask;
+			}
 	}
 }
 
@@ -120,6 +120,7 @@ public:
 private:
 	// internal helpers
 	void optimize();
+	void remove_dead_code();
 	void disassemble();
 	const char *get_comment_text(const uml::instruction &inst, astring &comment);
 
@@ -146,6 +147,7 @@ public:
 	virtual int execute(uml::code_handle &entry) = 0;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) = 0;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) = 0;
+	virtual void invalidate_code(drccodeptr start, drccodeptr end) = 0;
 	virtual void get_info(drcbe_info &info) = 0;
 	virtual bool logging() const { return false; }
 
@@ -174,7 +176,8 @@ public:
 
 	// reset the state
 	void reset();
-	int execute(uml::code_handle &entry) { return m_beintf.execute(entry); }
+	void lock_static_code();
+	int execute(uml::code_handle &entry) { m_dispatches++; return m_beintf.execute(entry); }
 
 	// code generation
 	drcuml_block *begin_block(UINT32 maxinst);
@@ -182,7 +185,7 @@ public:
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf.get_info(info); }
 	bool hash_exists(UINT32 mode, UINT32 pc) { return m_beintf.hash_exists(mode, pc); }
-	void generate(drcuml_block &block, uml::instruction *instructions, UINT32 count) { m_beintf.generate(block, instructions, count); }
+	void generate(drcuml_block &block, uml::instruction *instructions, UINT32 count);
 
 	// handle management
 	uml::code_handle *handle_alloc(const char *name);
@@ -223,6 +226,9 @@ private:
 		astring                 m_name;             // name of the symbol
 	};
 
+	// internal helpers
+	void evict_code(drccodeptr start, drccodeptr end);
+
 	// internal state
 	device_t &                  m_device;           // CPU device we are associated with
 	drc_cache &                 m_cache;            // pointer to the codegen cache
@@ -231,6 +237,11 @@ private:
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
+
+	// statistics
+	UINT32                      m_blocks;           // number of blocks generated
+	UINT64                      m_dispatches;       // number of calls to execute
+	osd_ticks_t                 m_generate_ticks;   // time spent generating code
 };
 
 
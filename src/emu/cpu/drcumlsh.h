@@ -32,7 +32,7 @@
 #define UML_NOP(block)                                      do { block->append().nop(); } while (0)
 #define UML_DEBUG(block, pc)                                do { block->append().debug(pc); } while (0)
 #define UML_EXIT(block, param)                              do { block->append().exit(param); } while (0)
-#define UML_EXITc(block, cond, param)                       do { block->append().exit(param, cond); } while (0)
+#define UML_EXITc(block, cond, param)                       do { block->append().exit(cond, param); } while (0)
 #define UML_HASHJMP(block, mode, pc, handle)                do { block->append().hashjmp(mode, pc, handle); } while (0)
 #define UML_JMP(block, label)                               do { block->append().jmp(label); } while (0)
 #define UML_JMPc(block, cond, label)                        do { block->append().jmp(cond, label); } while (0)
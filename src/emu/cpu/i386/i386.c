@@ -43,6 +43,8 @@ i386_device::i386_device(const machine_config &mconfig, const char *tag, device_
 	: cpu_device(mconfig, I386, "I386", tag, owner, clock, "i386", __FILE__)
 	, m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, 32, 16, 0)
+	, m_drcenabled(false)
+	, m_drc(NULL)
 	, m_smiact(*this)
 {
 	m_program_config.m_logaddr_width = 32;
@@ -54,6 +56,8 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	: cpu_device(mconfig, type, name, tag, owner, clock, shortname, source)
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
+	, m_drcenabled(false)
+	, m_drc(NULL)
 	, m_smiact(*this)
 {
 	m_program_config.m_logaddr_width = 32;
@@ -3293,6 +3297,17 @@ void i386_device::i386_common_init(int tlbsize)
 	m_smiact.resolve_safe();
 
 	m_icountptr = &m_cycles;
+
+	// the recompiler is allocated on first use; the front end reads opcode
+	// bytes the way FETCH does, which assumes a little-endian host
+	m_drcenabled = machine().options().drc() && machine().options().drc_i386() && ENDIANNESS_NATIVE == ENDIANNESS_LITTLE;
+	m_drcblocked = ~0;
+	m_drcfastram_select = 0;
+}
+
+void i386_device::device_stop()
+{
+	drc_exit();
 }
 
 void i386_device::device_start()
@@ -3864,6 +3879,7 @@ void i386_device::execute_set_input(int irqline, int state)
 			m_irq_state = state;
 		}
 	}
+	m_drcblocked = drc_blocked();
 }
 
 void pentium_device::execute_set_input(int irqline, int state)
@@ -3875,6 +3891,7 @@ void pentium_device::execute_set_input(int irqline, int state)
 			m_smi_latched = true;
 		}
 		m_smi = state;
+		m_drcblocked = drc_blocked();
 	}
 	else
 	{
@@ -3894,6 +3911,7 @@ void i386_device::i386_set_a20_line(int state)
 	}
 	// TODO: how does A20M and the tlb interact
 	vtlb_flush_dynamic(m_vtlb);
+	m_drcblocked = drc_blocked();
 }
 
 void i386_device::execute_run()
@@ -3909,51 +3927,112 @@ void i386_device::execute_run()
 		return;
 	}
 
-	while( m_cycles > 0 )
+	/* the recompiler leaves the debugger to the interpreter */
+	if (m_drcenabled && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+		execute_run_drc();
+	else
 	{
-		i386_check_irq_line();
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
+		while( m_cycles > 0 )
+			i386_execute_one();
+	}
+	m_tsc += (cycles - m_cycles);
+}
 
-		m_ext = 1;
-		int old_tf = m_TF;
+void i386_device::i386_execute_one()
+{
+	i386_check_irq_line();
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
 
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
+	m_ext = 1;
+	int old_tf = m_TF;
 
-		debugger_instruction_hook(this, m_pc);
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
 
-		if(m_delayed_interrupt_enable != 0)
-		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
+	debugger_instruction_hook(this, m_pc);
+
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
 #ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
 #endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(UINT64 e)
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
 		{
+			m_prev_eip = m_eip;
 			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+			i386_trap(1,0,0);
 		}
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
 	}
-	m_tsc += (cycles - m_cycles);
+	catch(UINT64 e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+	}
+}
+
+void i386_device::func_execute_one()
+{
+	UINT32 mode = m_drcmode;
+
+	i386_execute_one();
+
+	/* the generated code compares this with the address it expects; ~0 never matches */
+	m_drcmode = drc_mode();
+	m_drcblocked = drc_blocked();
+	m_drcnextpc = (m_cycles > 0 && m_drcmode == mode) ? m_pc : ~0;
+}
+
+/* compiled code is only valid for the mode it was compiled in */
+UINT32 i386_device::drc_mode()
+{
+	return (m_sreg[CS].d ? 1 : 0) | ((m_cr[0] & 0x80000000) ? 2 : 0) | ((m_CPL == 3) ? 4 : 0) | ((m_a20_mask & (1 << 20)) ? 0 : 8);
+}
+
+/* compiled code runs the simple cases of a few instructions itself; this is what it can't check */
+UINT32 i386_device::drc_blocked()
+{
+	UINT32 blocked = 0;
+
+	if (!PROTECTED_MODE || V8086_MODE || m_TF || m_delayed_interrupt_enable || (m_irq_state && m_IF) || (m_smi && !m_smm) || drc_mode() != m_drcmode)
+		blocked |= DRC_BLOCKED_PENDING;
+	if (!m_sreg[SS].d)
+		blocked |= DRC_BLOCKED_STACK;
+
+	/* i386_translate can't fault on a valid 4GB segment that isn't expand-down */
+	for (int segment = ES; segment <= GS; segment++)
+	{
+		const I386_SREG &sreg = m_sreg[segment];
+		bool flat = sreg.valid && sreg.limit == 0xffffffff && !((sreg.flags & 0x0018) == 0x0010 && (sreg.flags & 0x0004));
+		if (!flat || ((sreg.flags & 8) && !(sreg.flags & 2)))
+			blocked |= DRC_BLOCKED_READ << segment;
+		if (!flat || (sreg.flags & 8) || !(sreg.flags & 2))
+			blocked |= DRC_BLOCKED_WRITE << segment;
+	}
+	return blocked;
+}
+
+/* translate a fetch address, loading the TLB entry on the way */
+bool i386_device::drc_translate_fetch(UINT32 &address)
+{
+	UINT32 error;
+
+	if (!translate_address(m_CPL, TRANSLATE_FETCH, &address, &error))
+		return false;
+	address &= m_a20_mask;
+	return true;
 }
 
 /*************************************************************************/
@@ -15,6 +15,13 @@
 #define INPUT_LINE_SMI      2
 
 
+// forward declarations
+class i386_frontend;
+class i386_recompiler;
+
+#define I386_MAX_FASTRAM    4
+
+
 // mingw has this defined for 32-bit compiles
 #undef i386
 
@@ -38,9 +45,18 @@ public:
 	UINT64 debug_segofftovirt(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_virttophys(symbol_table &table, int params, const UINT64 *param);
 
+	// recompiler configuration and callouts
+	void i386drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
+	void func_execute_one();
+	void func_fill_tlb();
+
+	friend class i386_frontend;
+	friend class i386_recompiler;
+
 protected:
 	// device-level overrides
 	virtual void device_start();
+	virtual void device_stop();
 	virtual void device_reset();
 	virtual void device_debug_setup();
 
@@ -267,6 +283,30 @@ struct I386_CALL_GATE
 
 	vtlb_state *m_vtlb;
 
+	// recompiler state
+	bool m_drcenabled;
+	i386_recompiler *m_drc;       // allocated on first use
+	UINT32 m_drcmode;             // hash mode: code size, paging, user and A20
+	UINT32 m_drcnextpc;           // where the last compiled instruction left the PC
+	UINT32 m_drcblocked;          // DRC_BLOCKED_* reasons compiled code must call the interpreter
+	UINT32 m_drcfastram_select;
+	struct
+	{
+		offs_t start;             // start of the RAM block
+		offs_t end;               // end of the RAM block
+		UINT8 readonly;           // TRUE if read-only
+		void *base;               // base in memory where the RAM lives
+	} m_drcfastram[I386_MAX_FASTRAM];
+
+	// what compiled code can't check for itself; segment flags are shifted by the segment number
+	enum
+	{
+		DRC_BLOCKED_PENDING = 0x000001,   // not protected mode, or an interrupt, trap or mode change is due
+		DRC_BLOCKED_STACK   = 0x000002,   // SS isn't a 32-bit segment
+		DRC_BLOCKED_READ    = 0x000100,   // the segment isn't flat and readable
+		DRC_BLOCKED_WRITE   = 0x010000    // the segment isn't flat and writable
+	};
+
 	bool m_smm;
 	bool m_smi;
 	bool m_smi_latched;
@@ -1411,7 +1451,16 @@ struct I386_CALL_GATE
 	void pentium_smi();
 	void zero_state();
 	void i386_set_a20_line(int state);
-
+	void i386_execute_one();
+
+	// recompiler
+	UINT32 drc_mode();
+	UINT32 drc_blocked();
+	bool drc_translate_fetch(UINT32 &address);
+	void drc_exit();
+	void drc_set_dirty();
+	void execute_run_drc();
+	void drc_interpret(int count);
 };
 
 
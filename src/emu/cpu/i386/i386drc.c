@@ -0,0 +1,980 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Phil Bennett
+/***************************************************************************
+
+    i386drc.c
+    Universal machine language-based 386/486/Pentium recompiler.
+
+    The front end walks the code once, sizing each instruction with the
+    disassembler. The unprefixed 32-bit MOV, PUSH, POP and LEA forms are
+    compiled to UML: the effective address, the segment base, a vtlb_table
+    lookup when paging is on, and then a load or store straight into RAM
+    registered with i386drc_add_fastram or through the address space.
+    Everything else -- system instructions, the x87 ops in x87ops.inc,
+    and any access that is unaligned, misses the TLB, or goes through a
+    segment that isn't flat -- is compiled into a call into the
+    interpreter's decoder, so it behaves exactly as it does in i386.c.
+    Static branches within a block jump straight to their target, and
+    everything else redispatches through the hash table, keyed by linear
+    PC and by the mode -- code size, paging, CPL 3 and the A20 gate --
+    the code was compiled for. With paging on, the generated code checks
+    the vtlb entry of each page it runs from, so a block compiled for
+    another address space is recompiled rather than run.
+
+    The opcode bytes themselves are never trusted: calls read them live,
+    and compiled instructions compare them first, so self-modifying code
+    just works. If an instruction turns out to be a different length than
+    it was compiled as, the PC it leaves doesn't match and the block is
+    left through the dispatcher.
+
+    Interrupts, traps, mode changes and segments the compiled code can't
+    handle are summed up by the interpreter in m_drcblocked whenever they
+    can change, and compiled instructions call the interpreter if any
+    they care about is set.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "cpu/drcthread.h"
+#include "cpu/drcumlsh.h"
+#include "i386.h"
+#include "cycles.h"
+
+extern int i386_dasm_one(char *buffer, UINT32 pc, const UINT8 *oprom, int mode);
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                  (32 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES     128
+#define COMPILE_FORWARDS_BYTES      512
+#define COMPILE_MAX_SEQUENCE        64
+
+/* instructions interpreted each time code can't be compiled */
+#define INTERPRET_INSTRUCTIONS      64
+
+/* hash modes; see i386_device::drc_mode */
+#define DRC_MODES                   16
+#define DRC_MODE_CODE32             1
+#define DRC_MODE_PAGING             2
+#define DRC_MODE_USER               4
+
+/* set in vtlb entries for pages that have been written; see i386priv.h */
+#define VTLB_FLAG_DIRTY             0x100
+
+/* register and segment numbers, as in DREGS and SREGS in i386priv.h */
+#define REG_ESP                     4
+#define REG_EBP                     5
+#define SEG_SS                      2
+#define SEG_DS                      3
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)                    mem(&m_i386.m_reg.d[reg])
+
+
+/***************************************************************************
+    FRONT END
+***************************************************************************/
+
+class i386_frontend : public drc_frontend
+{
+public:
+	i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	void describe_flow(opcode_desc &desc, bool code32);
+
+	i386_device *m_i386;
+};
+
+i386_frontend::i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence),
+		m_i386(device)
+{
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	direct_read_data &direct = *m_i386->m_direct;
+	UINT32 address = desc.pc;
+
+	/* pages that don't translate, and code in handlers, are left to the interpreter; */
+	/* the debug translation leaves the accessed bits of code that hasn't run alone */
+	desc.length = 1;
+	if (!m_i386->memory_translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, address) || direct.read_decrypted_ptr(address) == NULL)
+	{
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return false;
+	}
+	desc.physpc = address;
+
+	/* copy as many bytes as an instruction can span, following the translation onto the next page */
+	for (int bytenum = 0; bytenum < 15; bytenum++)
+	{
+		offs_t byteaddress = desc.pc + bytenum;
+		if (((byteaddress ^ desc.pc) & ~0xfff) == 0)
+			byteaddress = desc.physpc + bytenum;
+		else if (!m_i386->memory_translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, byteaddress))
+			break;
+
+		const UINT8 *byteptr = (const UINT8 *)direct.read_decrypted_ptr(byteaddress);
+		if (byteptr == NULL)
+			break;
+		desc.opptr.b[bytenum] = *byteptr;
+	}
+
+	/* the disassembler knows the length of everything the decoder does */
+	char buffer[256];
+	bool code32 = (m_i386->drc_mode() & DRC_MODE_CODE32) != 0;
+	UINT32 length = i386_dasm_one(buffer, desc.pc, desc.opptr.b, code32 ? 32 : 16) & DASMFLAG_LENGTHMASK;
+	if (length == 0 || length > 15)
+	{
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return false;
+	}
+	desc.length = length;
+	desc.cycles = 1;
+
+	describe_flow(desc, code32);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_flow - flag branches, and the system
+    instructions that can change the translation
+    of the code that follows them
+-------------------------------------------------*/
+
+void i386_frontend::describe_flow(opcode_desc &desc, bool code32)
+{
+	const UINT8 *op = desc.opptr.b;
+	offs_t nextpc = desc.pc + desc.length;
+	bool operand32 = code32;
+	int index;
+
+	/* skip the prefixes */
+	for (index = 0; index < desc.length - 1; index++)
+	{
+		if (op[index] == 0x66)
+			operand32 = !code32;
+		else if (op[index] != 0x26 && op[index] != 0x2e && op[index] != 0x36 && op[index] != 0x3e &&
+				op[index] != 0x64 && op[index] != 0x65 && op[index] != 0x67 &&
+				op[index] != 0xf0 && op[index] != 0xf2 && op[index] != 0xf3)
+			break;
+	}
+
+	const UINT8 *imm = &op[index + 1];
+	INT32 rel8 = (INT8)imm[0];
+	INT32 relv = operand32 ? (INT32)(imm[0] | (imm[1] << 8) | (imm[2] << 16) | (imm[3] << 24)) : (INT16)(imm[0] | (imm[1] << 8));
+
+	switch (op[index])
+	{
+		/* Jcc, LOOPcc and JCXZ rel8 */
+		case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+		case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+		case 0xe0: case 0xe1: case 0xe2: case 0xe3:
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.targetpc = nextpc + rel8;
+			break;
+
+		/* JMP rel8 */
+		case 0xeb:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = nextpc + rel8;
+			break;
+
+		/* CALL and JMP rel16/32 */
+		case 0xe8:
+		case 0xe9:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = nextpc + relv;
+			break;
+
+		/* RET, RETF, IRET and far JMP/CALL */
+		case 0xc2: case 0xc3: case 0xca: case 0xcb: case 0xcf:
+		case 0x9a: case 0xea:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			break;
+
+		/* INT3, INT and INTO */
+		case 0xcc: case 0xcd: case 0xce:
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+			break;
+
+		/* HLT */
+		case 0xf4:
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		/* indirect CALL and JMP, near and far */
+		case 0xff:
+			if (((imm[0] >> 3) & 7) >= 2 && ((imm[0] >> 3) & 7) <= 5)
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x0f:
+			switch (imm[0])
+			{
+				/* Jcc rel16/32 */
+				case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:
+				case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+					desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+					desc.targetpc = nextpc + (operand32 ? (INT32)(imm[1] | (imm[2] << 8) | (imm[3] << 16) | (imm[4] << 24)) : (INT16)(imm[1] | (imm[2] << 8)));
+					break;
+
+				/* descriptor tables, INVLPG, CLTS, cache control, MOV CRn/DRn/TRn, WRMSR, SYSENTER/SYSEXIT and RSM */
+				case 0x00: case 0x01: case 0x06: case 0x08: case 0x09:
+				case 0x20: case 0x21: case 0x22: case 0x23: case 0x24: case 0x26:
+				case 0x30: case 0x34: case 0x35: case 0xaa:
+					desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_MODIFIES_TRANSLATION | OPFLAG_END_SEQUENCE;
+					break;
+			}
+			break;
+	}
+}
+
+
+/***************************************************************************
+    RECOMPILER
+***************************************************************************/
+
+class i386_recompiler : public drc_threaded_compiler
+{
+public:
+	i386_recompiler(i386_device &i386);
+
+protected:
+	/* the page moved under compiled code */
+	enum { EXECUTE_TLB_MISMATCH = EXECUTE_CPU_SPECIFIC };
+
+	virtual bool compile_current();
+	virtual void interpret();
+	virtual void prepare_execute();
+	virtual void handle_exit(int result);
+	virtual void generate_dispatch(drcuml_block *block);
+	virtual void generate_sequence_check(drcuml_block *block, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	virtual void generate_call(drcuml_block *block, const opcode_desc *desc);
+
+private:
+	/* a decoded 32-bit ModRM operand */
+	struct effective_address
+	{
+		int     base;               // base register, or -1
+		int     index;              // index register, or -1
+		int     scale;              // index shift
+		INT32   disp;               // displacement
+		int     segment;            // default segment
+		int     length;             // bytes of ModRM, SIB and displacement
+	};
+
+	void generate_tlb_check(drcuml_block *block, const opcode_desc *desc);
+	void generate_execute_one(drcuml_block *block, const opcode_desc *desc);
+	bool generate_native(drcuml_block *block, const opcode_desc *desc);
+	void generate_entry_check(drcuml_block *block, const opcode_desc *desc, UINT32 blocked, code_label calllabel);
+	void generate_ea(drcuml_block *block, const effective_address &ea, bool segmented);
+	void generate_translate(drcuml_block *block, bool write, code_label calllabel);
+	void generate_commit(drcuml_block *block, const opcode_desc *desc);
+	void generate_access(drcuml_block *block, bool write);
+	void generate_advance(drcuml_block *block, const opcode_desc *desc, int cycles);
+	static bool decode_ea(const UINT8 *modrm, effective_address &ea);
+
+	i386_device &m_i386;
+	i386_frontend m_frontend;
+	offs_t m_checkedpage;         // page whose translation the current sequence has checked
+};
+
+
+i386_recompiler::i386_recompiler(i386_device &i386)
+	: drc_threaded_compiler(i386, CACHE_SIZE, DRC_MODES, 0, i386.m_drcnextpc),
+		m_i386(i386),
+		m_frontend(&i386, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE),
+		m_checkedpage(~0)
+{
+	m_drcuml.symbol_add(&i386.m_pc, sizeof(i386.m_pc), "pc");
+	m_drcuml.symbol_add(&i386.m_cycles, sizeof(i386.m_cycles), "icount");
+	m_drcuml.symbol_add(&i386.m_drcmode, sizeof(i386.m_drcmode), "mode");
+	m_drcuml.symbol_add(&i386.m_drcblocked, sizeof(i386.m_drcblocked), "blocked");
+	m_drcuml.symbol_add(&i386.m_eip, sizeof(i386.m_eip), "eip");
+
+	static const char *const regnames[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_drcuml.symbol_add(&i386.m_reg.d[regnum], sizeof(UINT32), regnames[regnum]);
+}
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    cfunc_execute_one - C callback to run one
+    compiled instruction
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((i386_device *)param)->func_execute_one();
+}
+
+
+/*-------------------------------------------------
+    cfunc_fill_tlb - C callback to load the TLB
+    entry for the current PC
+-------------------------------------------------*/
+
+static void cfunc_fill_tlb(void *param)
+{
+	((i386_device *)param)->func_fill_tlb();
+}
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_exit - free the recompiler
+-------------------------------------------------*/
+
+void i386_device::drc_exit()
+{
+	if (m_drc != NULL)
+		auto_free(machine(), m_drc);
+	m_drc = NULL;
+}
+
+
+/*-------------------------------------------------
+    drc_set_dirty - throw away compiled code
+    before the next run
+-------------------------------------------------*/
+
+void i386_device::drc_set_dirty()
+{
+	if (m_drc != NULL)
+		m_drc->set_dirty();
+}
+
+
+/*-------------------------------------------------
+    i386drc_add_fastram - add a new fastram region
+    of physical memory that compiled loads and
+    stores can access directly
+-------------------------------------------------*/
+
+void i386_device::i386drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
+{
+	if (m_drcfastram_select < ARRAY_LENGTH(m_drcfastram))
+	{
+		m_drcfastram[m_drcfastram_select].start = start;
+		m_drcfastram[m_drcfastram_select].end = end;
+		m_drcfastram[m_drcfastram_select].readonly = readonly;
+		m_drcfastram[m_drcfastram_select].base = base;
+		m_drcfastram_select++;
+		drc_set_dirty();
+	}
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - run compiled code until the
+    timeslice is used up
+-------------------------------------------------*/
+
+void i386_device::execute_run_drc()
+{
+	if (m_drc == NULL)
+		m_drc = auto_alloc(machine(), i386_recompiler(*this));
+
+	m_drc->execute();
+}
+
+
+/*-------------------------------------------------
+    drc_interpret - interpret a few instructions
+    from the current PC
+-------------------------------------------------*/
+
+void i386_device::drc_interpret(int count)
+{
+	while (count-- > 0 && m_cycles > 0)
+		i386_execute_one();
+}
+
+
+/*-------------------------------------------------
+    func_fill_tlb - load the TLB entry for the
+    current PC; a fault is left for the
+    interpreter to raise
+-------------------------------------------------*/
+
+void i386_device::func_fill_tlb()
+{
+	UINT32 address = m_pc;
+	drc_translate_fetch(address);
+}
+
+
+/*-------------------------------------------------
+    prepare_execute - interrupts and state loads
+    change the mode behind the generated code's
+    back
+-------------------------------------------------*/
+
+void i386_recompiler::prepare_execute()
+{
+	m_i386.m_drcmode = m_i386.drc_mode();
+	m_i386.m_drcblocked = m_i386.drc_blocked();
+}
+
+
+/*-------------------------------------------------
+    compile_current - compile a block of code at
+    the current PC; the front end marks anything
+    it can't describe for the interpreter
+-------------------------------------------------*/
+
+bool i386_recompiler::compile_current()
+{
+	UINT32 mode = m_i386.drc_mode();
+	compile_block(m_frontend.describe_code(m_i386.m_pc, mode), mode);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    interpret - interpret a few instructions from
+    the current PC
+-------------------------------------------------*/
+
+void i386_recompiler::interpret()
+{
+	m_i386.drc_interpret(INTERPRET_INSTRUCTIONS);
+}
+
+
+/*-------------------------------------------------
+    handle_exit - the page moved under compiled
+    code: recompile it, or let the interpreter
+    fault
+-------------------------------------------------*/
+
+void i386_recompiler::handle_exit(int result)
+{
+	if (result == EXECUTE_TLB_MISMATCH)
+	{
+		UINT32 address = m_i386.m_pc;
+		if (!m_i386.drc_translate_fetch(address) || !compile_current())
+			interpret();
+	}
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_dispatch - generate the checks made
+    before every hash lookup
+-------------------------------------------------*/
+
+void i386_recompiler::generate_dispatch(drcuml_block *block)
+{
+	/* leave when out of cycles */
+	UML_CMP(block, mem(&m_i386.m_cycles), 0);                                               // cmp     [icount],0
+	UML_EXITc(block, COND_LE, EXECUTE_OUT_OF_CYCLES);                                       // exit    EXECUTE_OUT_OF_CYCLES,le
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, mem(&m_i386.m_drcmode), mem(&m_i386.m_pc), *m_nocode);               // hashjmp [mode],[pc],nocode
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_check - start checking the
+    translation of each page a new sequence runs
+    from
+-------------------------------------------------*/
+
+void i386_recompiler::generate_sequence_check(drcuml_block *block, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	m_checkedpage = ~0;
+}
+
+
+/*-------------------------------------------------
+    generate_tlb_check - generate code to check
+    that the page an instruction is on still maps
+    where it did when it was compiled
+-------------------------------------------------*/
+
+void i386_recompiler::generate_tlb_check(drcuml_block *block, const opcode_desc *desc)
+{
+	const vtlb_entry *tlbtable = vtlb_table(m_i386.m_vtlb);
+	vtlb_entry allowed = (m_i386.drc_mode() & DRC_MODE_USER) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED;
+	UINT32 mask = (m_i386.m_a20_mask & 0xfffff000) | VTLB_FLAG_VALID | allowed;
+	UINT32 expected = (desc->physpc & 0xfffff000) | VTLB_FLAG_VALID | allowed;
+
+	if (m_drcuml.logging())
+		block->append_comment("[TLB check for %08X]", desc->pc);                           // comment
+
+	/* an entry flushed since then is reloaded and checked again */
+	UML_LOAD(block, I0, &tlbtable[desc->pc >> 12], 0, SIZE_DWORD, SCALE_x4);                // load    i0,tlbtable[desc->pc >> 12],0,dword
+	UML_AND(block, I0, I0, mask);                                                           // and     i0,i0,mask
+	UML_CMP(block, I0, expected);                                                           // cmp     i0,expected
+	UML_CALLCc(block, COND_NE, cfunc_fill_tlb, &m_i386);                                    // callc   fill_tlb,i386,ne
+	UML_LOAD(block, I0, &tlbtable[desc->pc >> 12], 0, SIZE_DWORD, SCALE_x4);                // load    i0,tlbtable[desc->pc >> 12],0,dword
+	UML_AND(block, I0, I0, mask);                                                           // and     i0,i0,mask
+	UML_CMP(block, I0, expected);                                                           // cmp     i0,expected
+	UML_EXITc(block, COND_NE, EXECUTE_TLB_MISMATCH);                                        // exit    EXECUTE_TLB_MISMATCH,ne
+}
+
+
+/*-------------------------------------------------
+    generate_call - generate the code for one
+    instruction, checking the translation of
+    every page the sequence runs from
+-------------------------------------------------*/
+
+void i386_recompiler::generate_call(drcuml_block *block, const opcode_desc *desc)
+{
+	if ((m_i386.m_cr[0] & 0x80000000) && (desc->pc >> 12) != m_checkedpage)
+	{
+		generate_tlb_check(block, desc);
+		m_checkedpage = desc->pc >> 12;
+	}
+
+	/* add a disassembly comment */
+	if (m_drcuml.logging())
+	{
+		char buffer[256];
+		i386_dasm_one(buffer, desc->pc, desc->opptr.b, (m_i386.drc_mode() & DRC_MODE_CODE32) ? 32 : 16);
+		block->append_comment("%08X: %s", desc->pc, buffer);                               // comment
+	}
+
+	if (!generate_native(block, desc))
+		generate_execute_one(block, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_execute_one - generate a call to the
+    interpreter for one instruction
+-------------------------------------------------*/
+
+void i386_recompiler::generate_execute_one(drcuml_block *block, const opcode_desc *desc)
+{
+	UML_CALLC(block, cfunc_execute_one, &m_i386);                                           // callc   execute_one,i386
+}
+
+
+/*-------------------------------------------------
+    decode_ea - decode a 32-bit ModRM operand
+    that addresses memory; returns false for a
+    register operand
+-------------------------------------------------*/
+
+bool i386_recompiler::decode_ea(const UINT8 *modrm, effective_address &ea)
+{
+	int mod = modrm[0] >> 6;
+	int rm = modrm[0] & 7;
+	int dispbytes = (mod == 1) ? 1 : (mod == 2) ? 4 : 0;
+	const UINT8 *disp;
+
+	if (mod == 3)
+		return false;
+
+	ea.index = -1;
+	ea.scale = 0;
+	if (rm == 4)
+	{
+		/* SIB: EBP as a base means disp32 with no base when mod is 0 */
+		int base = modrm[1] & 7;
+		int index = (modrm[1] >> 3) & 7;
+		ea.base = (base == 5 && mod == 0) ? -1 : base;
+		ea.index = (index == 4) ? -1 : index;
+		ea.scale = modrm[1] >> 6;
+		ea.segment = (ea.base == REG_ESP || ea.base == REG_EBP) ? SEG_SS : SEG_DS;
+		if (ea.base == -1)
+			dispbytes = 4;
+		disp = &modrm[2];
+		ea.length = 2 + dispbytes;
+	}
+	else
+	{
+		/* EBP as a base means disp32 with no base when mod is 0 */
+		ea.base = (rm == 5 && mod == 0) ? -1 : rm;
+		ea.segment = (ea.base == REG_EBP) ? SEG_SS : SEG_DS;
+		if (ea.base == -1)
+			dispbytes = 4;
+		disp = &modrm[1];
+		ea.length = 1 + dispbytes;
+	}
+
+	if (dispbytes == 1)
+		ea.disp = (INT8)disp[0];
+	else if (dispbytes == 4)
+		ea.disp = disp[0] | (disp[1] << 8) | (disp[2] << 16) | (disp[3] << 24);
+	else
+		ea.disp = 0;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    generate_native - generate UML for the simple
+    forms of the common data moves; returns false,
+    having generated nothing, for anything else
+-------------------------------------------------*/
+
+bool i386_recompiler::generate_native(drcuml_block *block, const opcode_desc *desc)
+{
+	const UINT8 *op = desc->opptr.b;
+	effective_address ea;
+	bool memory = false;
+
+	/* 32-bit code only, and it must be in one page of memory we can compare it with */
+	if (!(m_i386.drc_mode() & DRC_MODE_CODE32) || (desc->pc & 0xfff) + desc->length > 0x1000)
+		return false;
+	const UINT8 *code = (const UINT8 *)m_i386.m_direct->read_decrypted_ptr(desc->physpc);
+	if (code == NULL || (const UINT8 *)m_i386.m_direct->read_decrypted_ptr(desc->physpc + desc->length - 1) != code + desc->length - 1)
+		return false;
+
+	/* check that we know the instruction, and how long it is, before generating anything */
+	switch (op[0])
+	{
+		case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:    /* PUSH r32 */
+		case 0x58: case 0x59: case 0x5a: case 0x5b: case 0x5c: case 0x5d: case 0x5e: case 0x5f:    /* POP r32 */
+		case 0x90:                                                                                  /* NOP */
+			if (desc->length != 1)
+				return false;
+			break;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:    /* MOV r32,imm32 */
+			if (desc->length != 5)
+				return false;
+			break;
+
+		case 0x89:                                                                                  /* MOV r/m32,r32 */
+		case 0x8b:                                                                                  /* MOV r32,r/m32 */
+		case 0x8d:                                                                                  /* LEA r32,m */
+		case 0xc7:                                                                                  /* MOV r/m32,imm32 */
+			memory = decode_ea(&op[1], ea);
+			if (op[0] == 0x8d && !memory)
+				return false;
+			if (op[0] == 0xc7 && ((op[1] >> 3) & 7) != 0)
+				return false;
+			if (desc->length != 1 + (memory ? ea.length : 1) + (op[0] == 0xc7 ? 4 : 0))
+				return false;
+			break;
+
+		default:
+			return false;
+	}
+
+	code_label calllabel = alloc_label();
+	code_label donelabel = alloc_label();
+	int reg = (op[1] >> 3) & 7;
+	int rm = op[1] & 7;
+	const UINT8 *imm;
+
+	switch (op[0])
+	{
+		case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:    /* PUSH r32 */
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING | i386_device::DRC_BLOCKED_STACK | (i386_device::DRC_BLOCKED_WRITE << SEG_SS), calllabel);
+			UML_SUB(block, I0, R32(REG_ESP), 4);                                            // sub     i0,esp,4
+			UML_ADD(block, I0, I0, mem(&m_i386.m_sreg[SEG_SS].base));                       // add     i0,i0,[ss.base]
+			generate_translate(block, true, calllabel);
+			generate_commit(block, desc);
+			UML_MOV(block, I1, R32(op[0] & 7));                                             // mov     i1,reg
+			generate_access(block, true);
+			UML_SUB(block, R32(REG_ESP), R32(REG_ESP), 4);                                  // sub     esp,esp,4
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_PUSH_REG_SHORT]);
+			break;
+
+		case 0x58: case 0x59: case 0x5a: case 0x5b: case 0x5c: case 0x5d: case 0x5e: case 0x5f:    /* POP r32 */
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING | i386_device::DRC_BLOCKED_STACK | (i386_device::DRC_BLOCKED_READ << SEG_SS), calllabel);
+			UML_ADD(block, I0, R32(REG_ESP), mem(&m_i386.m_sreg[SEG_SS].base));             // add     i0,esp,[ss.base]
+			generate_translate(block, false, calllabel);
+			generate_commit(block, desc);
+			generate_access(block, false);
+			UML_ADD(block, R32(REG_ESP), R32(REG_ESP), 4);                                  // add     esp,esp,4
+			UML_MOV(block, R32(op[0] & 7), I1);                                             // mov     reg,i1
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_POP_REG_SHORT]);
+			break;
+
+		case 0x90:                                                                          /* NOP */
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING, calllabel);
+			generate_commit(block, desc);
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_NOP]);
+			break;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:    /* MOV r32,imm32 */
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING, calllabel);
+			generate_commit(block, desc);
+			UML_MOV(block, R32(op[0] & 7), op[1] | (op[2] << 8) | (op[3] << 16) | (op[4] << 24));  // mov     reg,imm
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_MOV_IMM_REG]);
+			break;
+
+		case 0x89:                                                                          /* MOV r/m32,r32 */
+			if (!memory)
+			{
+				generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING, calllabel);
+				generate_commit(block, desc);
+				UML_MOV(block, R32(rm), R32(reg));                                          // mov     rm,reg
+				generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_MOV_REG_REG]);
+				break;
+			}
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING | (i386_device::DRC_BLOCKED_WRITE << ea.segment), calllabel);
+			generate_ea(block, ea, true);
+			generate_translate(block, true, calllabel);
+			generate_commit(block, desc);
+			UML_MOV(block, I1, R32(reg));                                                   // mov     i1,reg
+			generate_access(block, true);
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_MOV_REG_MEM]);
+			break;
+
+		case 0x8b:                                                                          /* MOV r32,r/m32 */
+			if (!memory)
+			{
+				generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING, calllabel);
+				generate_commit(block, desc);
+				UML_MOV(block, R32(reg), R32(rm));                                          // mov     reg,rm
+				generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_MOV_REG_REG]);
+				break;
+			}
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING | (i386_device::DRC_BLOCKED_READ << ea.segment), calllabel);
+			generate_ea(block, ea, true);
+			generate_translate(block, false, calllabel);
+			generate_commit(block, desc);
+			generate_access(block, false);
+			UML_MOV(block, R32(reg), I1);                                                   // mov     reg,i1
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_MOV_MEM_REG]);
+			break;
+
+		case 0x8d:                                                                          /* LEA r32,m */
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING, calllabel);
+			generate_commit(block, desc);
+			generate_ea(block, ea, false);
+			UML_MOV(block, R32(reg), I0);                                                   // mov     reg,i0
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_LEA]);
+			break;
+
+		case 0xc7:                                                                          /* MOV r/m32,imm32 */
+			imm = &op[1 + (memory ? ea.length : 1)];
+			if (!memory)
+			{
+				generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING, calllabel);
+				generate_commit(block, desc);
+				UML_MOV(block, R32(rm), imm[0] | (imm[1] << 8) | (imm[2] << 16) | (imm[3] << 24));  // mov     rm,imm
+				generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_MOV_IMM_REG]);
+				break;
+			}
+			generate_entry_check(block, desc, i386_device::DRC_BLOCKED_PENDING | (i386_device::DRC_BLOCKED_WRITE << ea.segment), calllabel);
+			generate_ea(block, ea, true);
+			generate_translate(block, true, calllabel);
+			generate_commit(block, desc);
+			UML_MOV(block, I1, imm[0] | (imm[1] << 8) | (imm[2] << 16) | (imm[3] << 24));   // mov     i1,imm
+			generate_access(block, true);
+			generate_advance(block, desc, m_i386.m_cycle_table_pm[CYCLES_MOV_IMM_MEM]);
+			break;
+	}
+
+	/* anything the checks turned away goes to the interpreter, which faults if it must */
+	UML_JMP(block, donelabel);                                                              // jmp     done
+	UML_LABEL(block, calllabel);                                                            // call:
+	generate_execute_one(block, desc);
+	UML_LABEL(block, donelabel);                                                            // done:
+	return true;
+}
+
+
+/*-------------------------------------------------
+    generate_entry_check - jump to the call if
+    any of the given reasons is set, or the
+    opcode bytes aren't what were compiled
+-------------------------------------------------*/
+
+void i386_recompiler::generate_entry_check(drcuml_block *block, const opcode_desc *desc, UINT32 blocked, code_label calllabel)
+{
+	const UINT8 *code = (const UINT8 *)m_i386.m_direct->read_decrypted_ptr(desc->physpc);
+
+	UML_TEST(block, mem(&m_i386.m_drcblocked), blocked);                                    // test    [blocked],blocked
+	UML_JMPc(block, COND_NZ, calllabel);                                                    // jmp     call,nz
+
+	for (int offset = 0; offset < desc->length; )
+	{
+		const UINT8 *bytes = &desc->opptr.b[offset];
+		if (desc->length - offset >= 4)
+		{
+			UML_LOAD(block, I0, code + offset, 0, SIZE_DWORD, SCALE_x1);                   // load    i0,code+offset,0,dword
+			UML_CMP(block, I0, bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24));  // cmp     i0,bytes
+			offset += 4;
+		}
+		else if (desc->length - offset >= 2)
+		{
+			UML_LOAD(block, I0, code + offset, 0, SIZE_WORD, SCALE_x1);                    // load    i0,code+offset,0,word
+			UML_CMP(block, I0, bytes[0] | (bytes[1] << 8));                                 // cmp     i0,bytes
+			offset += 2;
+		}
+		else
+		{
+			UML_LOAD(block, I0, code + offset, 0, SIZE_BYTE, SCALE_x1);                    // load    i0,code+offset,0,byte
+			UML_CMP(block, I0, bytes[0]);                                                   // cmp     i0,bytes
+			offset += 1;
+		}
+		UML_JMPc(block, COND_NE, calllabel);                                                // jmp     call,ne
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_ea - compute an effective address in
+    I0, adding the segment base if asked
+-------------------------------------------------*/
+
+void i386_recompiler::generate_ea(drcuml_block *block, const effective_address &ea, bool segmented)
+{
+	if (ea.base != -1)
+		UML_ADD(block, I0, R32(ea.base), ea.disp);                                          // add     i0,base,disp
+	else
+		UML_MOV(block, I0, ea.disp);                                                        // mov     i0,disp
+	if (ea.index != -1)
+	{
+		UML_SHL(block, I1, R32(ea.index), ea.scale);                                        // shl     i1,index,scale
+		UML_ADD(block, I0, I0, I1);                                                         // add     i0,i0,i1
+	}
+	if (segmented)
+		UML_ADD(block, I0, I0, mem(&m_i386.m_sreg[ea.segment].base));                      // add     i0,i0,[seg.base]
+}
+
+
+/*-------------------------------------------------
+    generate_translate - translate the linear
+    address in I0 to a physical one as
+    translate_address would, going to the call for
+    unaligned accesses and TLB misses
+-------------------------------------------------*/
+
+void i386_recompiler::generate_translate(drcuml_block *block, bool write, code_label calllabel)
+{
+	UINT32 mode = m_i386.drc_mode();
+
+	UML_TEST(block, I0, 3);                                                                 // test    i0,3
+	UML_JMPc(block, COND_NZ, calllabel);                                                    // jmp     call,nz
+
+	if (mode & DRC_MODE_PAGING)
+	{
+		const vtlb_entry *tlbtable = vtlb_table(m_i386.m_vtlb);
+		vtlb_entry allowed;
+		if (mode & DRC_MODE_USER)
+			allowed = write ? VTLB_USER_WRITE_ALLOWED : VTLB_USER_READ_ALLOWED;
+		else
+			allowed = write ? VTLB_WRITE_ALLOWED : VTLB_READ_ALLOWED;
+		vtlb_entry required = VTLB_FLAG_VALID | allowed | (write ? VTLB_FLAG_DIRTY : 0);
+
+		UML_SHR(block, I1, I0, 12);                                                         // shr     i1,i0,12
+		UML_LOAD(block, I1, tlbtable, I1, SIZE_DWORD, SCALE_x4);                            // load    i1,tlbtable,i1,dword
+		UML_AND(block, I2, I1, required);                                                   // and     i2,i1,required
+		UML_CMP(block, I2, required);                                                       // cmp     i2,required
+		UML_JMPc(block, COND_NE, calllabel);                                                // jmp     call,ne
+		UML_ROLINS(block, I0, I1, 0, 0xfffff000);                                           // rolins  i0,i1,0,0xfffff000
+	}
+
+	/* READ32 applies the A20 gate; WRITE32 masks the wrong variable, and so doesn't */
+	if (!write && m_i386.m_a20_mask != 0xffffffff)
+		UML_AND(block, I0, I0, m_i386.m_a20_mask);                                          // and     i0,i0,a20_mask
+}
+
+
+/*-------------------------------------------------
+    generate_commit - move EIP and PC past the
+    instruction once nothing can go to the call,
+    so handlers see them as the interpreter
+    leaves them
+-------------------------------------------------*/
+
+void i386_recompiler::generate_commit(drcuml_block *block, const opcode_desc *desc)
+{
+	UML_ADD(block, mem(&m_i386.m_eip), mem(&m_i386.m_eip), desc->length);                   // add     [eip],[eip],length
+	UML_MOV(block, mem(&m_i386.m_pc), desc->pc + desc->length);                             // mov     [pc],pc+length
+}
+
+
+/*-------------------------------------------------
+    generate_access - read I1 from, or write I1
+    to, the physical address in I0, directly if
+    it's in fast RAM
+-------------------------------------------------*/
+
+void i386_recompiler::generate_access(drcuml_block *block, bool write)
+{
+	code_label donelabel = 0;
+
+	for (int ramnum = 0; ramnum < m_i386.m_drcfastram_select; ramnum++)
+	{
+		if (write && m_i386.m_drcfastram[ramnum].readonly)
+			continue;
+
+		code_label skiplabel = alloc_label();
+		void *fastbase = (UINT8 *)m_i386.m_drcfastram[ramnum].base - m_i386.m_drcfastram[ramnum].start;
+		if (donelabel.label() == 0)
+			donelabel = alloc_label();
+
+		UML_CMP(block, I0, m_i386.m_drcfastram[ramnum].start);                             // cmp     i0,start
+		UML_JMPc(block, COND_B, skiplabel);                                                 // jmp     skip,b
+		UML_CMP(block, I0, m_i386.m_drcfastram[ramnum].end - 3);                           // cmp     i0,end-3
+		UML_JMPc(block, COND_A, skiplabel);                                                 // jmp     skip,a
+		if (write)
+			UML_STORE(block, fastbase, I0, I1, SIZE_DWORD, SCALE_x1);                      // store   fastbase,i0,i1,dword
+		else
+			UML_LOAD(block, I1, fastbase, I0, SIZE_DWORD, SCALE_x1);                       // load    i1,fastbase,i0,dword
+		UML_JMP(block, donelabel);                                                          // jmp     done
+		UML_LABEL(block, skiplabel);                                                        // skip:
+	}
+
+	if (write)
+		UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                                // write   i0,i1,dword
+	else
+		UML_READ(block, I1, I0, SIZE_DWORD, SPACE_PROGRAM);                                 // read    i1,i0,dword
+
+	if (donelabel.label() != 0)
+		UML_LABEL(block, donelabel);                                                        // done:
+}
+
+
+/*-------------------------------------------------
+    generate_advance - charge the cycles of a
+    compiled instruction and set the PC the
+    sequence checks expect, leaving the block when
+    the cycles run out as func_execute_one does
+-------------------------------------------------*/
+
+void i386_recompiler::generate_advance(drcuml_block *block, const opcode_desc *desc, int cycles)
+{
+	UML_SUB(block, mem(&m_i386.m_cycles), mem(&m_i386.m_cycles), cycles);                   // sub     [cycles],[cycles],cycles
+	UML_MOV(block, mem(&m_nextpc), desc->pc + desc->length);                                // mov     [nextpc],pc+length
+	UML_MOVc(block, COND_LE, mem(&m_nextpc), ~0);                                           // mov     [nextpc],~0,le
+}
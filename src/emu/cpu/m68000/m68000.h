@@ -115,6 +115,12 @@ unsigned int m68k_disassemble_raw(char* str_buff, unsigned int pc, const unsigne
 
 class m68000_base_device;
 
+/* recompiler class, only needed by m68kdrc.c */
+class m68k_recompiler;
+
+/* fast RAM ranges the recompiler may access directly */
+#define M68K_MAX_FASTRAM        4
+
 
 extern const device_type M68K;
 
@@ -370,6 +376,20 @@ public:
 	read32_delegate instruction_hook;
 
 
+	/* recompiler state, allocated on first use when -drc_m68k is set */
+	bool                m_drcenabled;       /* true if the recompiler may be used */
+	m68k_recompiler *   m_drc;              /* code cache, generator and front end */
+	UINT32              m_drcnextpc;        /* PC after the last compiled instruction, ~0 to leave the block */
+	UINT32              m_drcfastram_select;
+	struct
+	{
+		offs_t              start;              /* start of the RAM block */
+		offs_t              end;                /* end of the RAM block */
+		UINT8               readonly;           /* TRUE if read-only */
+		void *              base;               /* base in memory where the RAM lives */
+	} m_drcfastram[M68K_MAX_FASTRAM];
+
+
 
 	void init_cpu_common(void);
 	void init_cpu_m68000(void);
@@ -395,6 +415,16 @@ public:
 	void reset_cpu(void);
 	inline void cpu_execute(void);
 
+	/* recompiler (m68kdrc.c) */
+	void execute_run_drc(void);
+	void drc_exit(void);
+	void drc_set_dirty(void);
+	void drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
+	void drc_execute_one(void);
+	void drc_interpret(int count);
+	void drc_address_error(void);
+	bool drc_code_is_fixed(offs_t address);
+
 	// device_state_interface overrides
 	virtual void state_import(const device_state_entry &entry);
 	virtual void state_export(const device_state_entry &entry);
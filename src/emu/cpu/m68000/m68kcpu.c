@@ -1038,6 +1038,8 @@ void m68000_base_device::init_cpu_common(void)
 	m_icountptr = &remaining_cycles;
 	remaining_cycles = 0;
 
+	/* the recompiler is allocated on first use */
+	m_drcenabled = machine().options().drc() && machine().options().drc_m68k();
 }
 
 void m68000_base_device::reset_cpu(void)
@@ -2485,11 +2487,24 @@ void m68000_base_device::clear_all()
 	}
 
 	internal = 0;
+
+	m_drcenabled = false;
+	m_drc = NULL;
+	m_drcnextpc = ~0;
+	m_drcfastram_select = 0;
+	memset(m_drcfastram, 0, sizeof(m_drcfastram));
 }
 
 
 void m68000_base_device::execute_run()
 {
+	/* the recompiler runs without an MMU, an external hook or the debugger */
+	if (m_drcenabled && !has_pmmu && !has_hmmu && instruction_hook.isnull() && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	cpu_execute();
 }
 
@@ -2500,10 +2515,14 @@ void m68000_base_device::device_start()
 void m68000_base_device::device_reset()
 {
 	reset_cpu();
+
+	/* drivers may patch ROM on reset */
+	drc_set_dirty();
 }
 
 void m68000_base_device::device_stop()
 {
+	drc_exit();
 }
 
 
@@ -0,0 +1,1158 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    m68kdrc.c
+
+    Universal machine language-based 680x0 recompiler.
+
+    This is a call-threaded recompiler: the front end walks the code in
+    fixed ROM once, and each instruction is compiled into a store of its
+    opcode and a call to the interpreter's handler for it. What goes away
+    is the per-instruction opcode fetch, the prefetch and the dispatch
+    loop; static branches within a block jump straight to their target,
+    and everything else redispatches through the hash table.
+
+    After every instruction the generated code checks that the CPU ended
+    up where the block expected it to and that cycles remain. Anything
+    unusual -- exceptions, interrupts taken on an SR change, trace mode,
+    STOP, code outside fixed ROM or in encrypted ROM -- leaves the block
+    and is handled by the dispatcher or by interpreting a few instructions.
+
+    The most common ALU, move and branch instructions on data registers
+    are compiled to UML directly, as are MOVE.L/W between a data register
+    and memory that a driver has registered with drc_add_fastram. The
+    native code is left out when the debugger or the idle loop detector
+    needs to see every instruction.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "m68kcpu.h"
+#include "cpu/drcthread.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                  (16 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES     128
+#define COMPILE_FORWARDS_BYTES      512
+#define COMPILE_MAX_SEQUENCE        64
+
+/* instructions interpreted each time code can't be compiled */
+#define INTERPRET_INSTRUCTIONS      64
+
+/* longest instruction the front end will size, in bytes */
+#define MAX_INSTRUCTION_BYTES       24
+
+
+/***************************************************************************
+    FRONT END
+***************************************************************************/
+
+class m68k_frontend : public drc_frontend
+{
+public:
+	m68k_frontend(m68000_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	void describe_branch(opcode_desc &desc, UINT32 flags, offs_t targetpc);
+
+	m68000_base_device *m_m68k;
+};
+
+
+m68k_frontend::m68k_frontend(m68000_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_m68k(device)
+{
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool m68k_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT8 oprom[MAX_INSTRUCTION_BYTES];
+	char buffer[256];
+
+	/* only code in fixed ROM is compiled; the rest is left to the interpreter */
+	if ((desc.pc & 1) != 0 || !m_m68k->drc_code_is_fixed(desc.physpc))
+	{
+		desc.length = 2;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return false;
+	}
+
+	/* fetch the longest possible instruction and let the disassembler size it */
+	for (int wordnum = 0; wordnum < MAX_INSTRUCTION_BYTES / 2; wordnum++)
+	{
+		UINT16 word = m_m68k->readimm16(desc.physpc + wordnum * 2);
+		oprom[wordnum * 2 + 0] = word >> 8;
+		oprom[wordnum * 2 + 1] = word;
+	}
+	memcpy(desc.opptr.b, oprom, sizeof(desc.opptr.b));
+	desc.length = m_m68k->disassemble(buffer, desc.pc, oprom, oprom) & DASMFLAG_LENGTHMASK;
+
+	UINT16 opcode = (oprom[0] << 8) | oprom[1];
+	UINT16 ext1 = (oprom[2] << 8) | oprom[3];
+	UINT32 ext2 = (ext1 << 16) | (oprom[4] << 8) | oprom[5];
+	desc.cycles = m_m68k->cyc_instruction[opcode];
+
+	/* Bcc, BRA and BSR */
+	if ((opcode & 0xf000) == 0x6000)
+	{
+		INT32 disp = (INT8)opcode;
+		if ((opcode & 0xff) == 0x00)
+			disp = (INT16)ext1;
+		else if ((opcode & 0xff) == 0xff && CPU_TYPE_IS_EC020_PLUS(m_m68k->cpu_type))
+			disp = (INT32)ext2;
+		describe_branch(desc, ((opcode & 0x0f00) <= 0x0100) ? OPFLAG_IS_UNCONDITIONAL_BRANCH : OPFLAG_IS_CONDITIONAL_BRANCH, desc.pc + 2 + disp);
+	}
+
+	/* DBcc */
+	else if ((opcode & 0xf0f8) == 0x50c8)
+		describe_branch(desc, OPFLAG_IS_CONDITIONAL_BRANCH, desc.pc + 2 + (INT16)ext1);
+
+	/* JMP and JSR; only absolute and PC-relative targets are static */
+	else if ((opcode & 0xff80) == 0x4e80)
+	{
+		offs_t targetpc = BRANCH_TARGET_DYNAMIC;
+		switch (opcode & 0x3f)
+		{
+			case 0x38:  targetpc = (INT16)ext1;                 break;
+			case 0x39:  targetpc = ext2;                        break;
+			case 0x3a:  targetpc = desc.pc + 2 + (INT16)ext1;   break;
+		}
+		describe_branch(desc, OPFLAG_IS_UNCONDITIONAL_BRANCH, targetpc);
+	}
+
+	/* RTS, RTR, RTD and RTE; RTE also rewrites SR */
+	else if (opcode == 0x4e75 || opcode == 0x4e77 || opcode == 0x4e74 || opcode == 0x4e73)
+	{
+		describe_branch(desc, OPFLAG_IS_UNCONDITIONAL_BRANCH, BRANCH_TARGET_DYNAMIC);
+		if (opcode == 0x4e73)
+			desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+	}
+
+	/* MOVE to SR and ANDI/ORI/EORI to SR may start tracing or unmask interrupts */
+	else if ((opcode & 0xffc0) == 0x46c0 || opcode == 0x027c || opcode == 0x007c || opcode == 0x0a7c)
+		desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+
+	/* TRAP, TRAPV, STOP, RESET, ILLEGAL and the A/F lines end the sequence */
+	else if ((opcode & 0xfff0) == 0x4e40 || opcode == 0x4e76 || opcode == 0x4e72 || opcode == 0x4e70 || opcode == 0x4afc ||
+				(opcode & 0xf000) == 0xa000 || (opcode & 0xf000) == 0xf000)
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_branch - mark an instruction as a
+    branch, keeping the target only if it can
+    hold code
+-------------------------------------------------*/
+
+void m68k_frontend::describe_branch(opcode_desc &desc, UINT32 flags, offs_t targetpc)
+{
+	desc.flags |= flags;
+	if (flags == OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	if (targetpc != BRANCH_TARGET_DYNAMIC && (targetpc & 1) == 0)
+		desc.targetpc = targetpc;
+}
+
+
+/***************************************************************************
+    RECOMPILER
+***************************************************************************/
+
+class m68k_recompiler : public drc_threaded_compiler
+{
+public:
+	m68k_recompiler(m68000_base_device &m68k);
+
+protected:
+	virtual bool compile_current();
+	virtual void interpret();
+	virtual void generate_dispatch(drcuml_block *block);
+	virtual void generate_nocode(drcuml_block *block);
+	virtual void generate_invalid(drcuml_block *block, const opcode_desc *desc);
+	virtual void generate_call(drcuml_block *block, const opcode_desc *desc);
+
+private:
+	void generate_execute_one(drcuml_block *block, const opcode_desc *desc);
+	bool generate_native(drcuml_block *block, const opcode_desc *desc);
+	bool generate_move_memory(drcuml_block *block, const opcode_desc *desc, UINT16 opcode);
+	void generate_branch_if_false(drcuml_block *block, int condition, code_label falselabel);
+	void generate_flags_logic(drcuml_block *block, parameter res, int size);
+	void generate_flags_add(drcuml_block *block, bool setx);
+	void generate_flags_sub(drcuml_block *block, bool setx);
+	void generate_fastram_read(drcuml_block *block, int size, code_label slowlabel);
+	void generate_fastram_write(drcuml_block *block, int size, code_label slowlabel);
+	void generate_advance(drcuml_block *block, const opcode_desc *desc, offs_t pc, UINT32 cycles);
+	UINT8 *fastram_pointer(offs_t address, int size, bool iswrite);
+	bool have_fastram(bool iswrite);
+
+	m68000_base_device &m_m68k;
+	m68k_frontend m_frontend;
+	bool m_native;
+};
+
+
+m68k_recompiler::m68k_recompiler(m68000_base_device &m68k)
+	: drc_threaded_compiler(m68k, CACHE_SIZE, 1, 1, m68k.m_drcnextpc)
+	, m_m68k(m68k)
+	, m_frontend(&m68k, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE)
+{
+	m_drcuml.symbol_add(&m68k.pc, sizeof(m68k.pc), "pc");
+	m_drcuml.symbol_add(&m68k.ir, sizeof(m68k.ir), "ir");
+	m_drcuml.symbol_add(&m68k.remaining_cycles, sizeof(m68k.remaining_cycles), "remaining_cycles");
+
+	/* the debugger and the idle loop detector must see every instruction */
+	m_native = (m68k.machine().debug_flags & (DEBUG_FLAG_ENABLED | DEBUG_FLAG_IDLE_HOOK)) == 0;
+}
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    cfunc_execute_one - C callback to run one
+    compiled instruction
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((m68000_base_device *)param)->drc_execute_one();
+}
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    execute_run_drc - run compiled code until the
+    timeslice is used up
+-------------------------------------------------*/
+
+void m68000_base_device::execute_run_drc()
+{
+	if (m_drc == NULL)
+		m_drc = auto_alloc(machine(), m68k_recompiler(*this));
+
+	initial_cycles = remaining_cycles;
+
+	/* eat up any reset cycles */
+	if (reset_cycles)
+	{
+		int rc = reset_cycles;
+		reset_cycles = 0;
+		remaining_cycles -= rc;
+
+		if (remaining_cycles <= 0)
+			return;
+	}
+
+	/* see if interrupts came in */
+	m68ki_check_interrupts(this);
+
+	/* execute */
+	m_drc->execute();
+
+	/* a stopped or halted CPU eats the rest of its timeslice */
+	if (stopped && remaining_cycles > 0)
+		remaining_cycles = 0;
+
+	/* set previous PC to current PC for the next entry into the loop */
+	REG_PPC(this) = REG_PC(this);
+}
+
+
+/*-------------------------------------------------
+    drc_exit - free the recompiler
+-------------------------------------------------*/
+
+void m68000_base_device::drc_exit()
+{
+	if (m_drc != NULL)
+		auto_free(machine(), m_drc);
+	m_drc = NULL;
+}
+
+
+/*-------------------------------------------------
+    drc_set_dirty - throw away compiled code
+    before the next run
+-------------------------------------------------*/
+
+void m68000_base_device::drc_set_dirty()
+{
+	if (m_drc != NULL)
+		m_drc->set_dirty();
+}
+
+
+/*-------------------------------------------------
+    drc_add_fastram - add a new fastram region
+    that MOVEs can access directly
+-------------------------------------------------*/
+
+void m68000_base_device::drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
+{
+	if (m_drcfastram_select < ARRAY_LENGTH(m_drcfastram))
+	{
+		m_drcfastram[m_drcfastram_select].start = start;
+		m_drcfastram[m_drcfastram_select].end = end;
+		m_drcfastram[m_drcfastram_select].readonly = readonly;
+		m_drcfastram[m_drcfastram_select].base = base;
+		m_drcfastram_select++;
+		drc_set_dirty();
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_execute_one - run the instruction in IR
+    at PC, as the interpreter loop would
+-------------------------------------------------*/
+
+void m68000_base_device::drc_execute_one()
+{
+	debugger_instruction_hook(this, REG_PC(this));
+
+	REG_PPC(this) = REG_PC(this);
+	REG_PC(this) += 2;
+	run_mode = RUN_MODE_NORMAL;
+
+	try
+	{
+		jump_table[ir](this);
+		remaining_cycles -= cyc_instruction[ir];
+	}
+	catch (int error)
+	{
+		if (error != 10)
+			throw;
+		drc_address_error();
+	}
+
+	/* the generated code compares this with the PC it expects next; ~0 never
+	   matches, and also sends a newly traced instruction to the interpreter */
+	m_drcnextpc = (remaining_cycles > 0 && !stopped && (t1_flag | t0_flag) == 0) ? REG_PC(this) : ~0;
+}
+
+
+/*-------------------------------------------------
+    drc_interpret - interpret a few instructions
+    from the current PC
+-------------------------------------------------*/
+
+void m68000_base_device::drc_interpret(int count)
+{
+	while (count-- > 0 && remaining_cycles > 0 && !stopped)
+	{
+		/* Set tracing accodring to T1. (T0 is done inside instruction) */
+		m68ki_trace_t1(this); /* auto-disable (see m68kcpu.h) */
+
+		/* Call external hook to peek at CPU */
+		debugger_instruction_hook(this, REG_PC(this));
+
+		/* Record previous program counter */
+		REG_PPC(this) = REG_PC(this);
+
+		try
+		{
+			run_mode = RUN_MODE_NORMAL;
+			/* Read an instruction and call its handler */
+			ir = m68ki_read_imm_16(this);
+			jump_table[ir](this);
+			remaining_cycles -= cyc_instruction[ir];
+		}
+		catch (int error)
+		{
+			if (error != 10)
+				throw;
+			drc_address_error();
+			continue;
+		}
+
+		/* Trace m68k_exception, if necessary */
+		m68ki_exception_if_trace(this); /* auto-disable (see m68kcpu.h) */
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_address_error - take an address error
+    the way cpu_execute does; a second one while
+    stacking the first halts the CPU
+-------------------------------------------------*/
+
+void m68000_base_device::drc_address_error()
+{
+	try
+	{
+		m68ki_exception_address_error(this);
+	}
+	catch (int error)
+	{
+		if (error != 10)
+			throw;
+		REG_PPC(this) = REG_PC(this);
+		m68ki_exception_address_error(this);
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_code_is_fixed - return true if the given
+    address is in ROM that no bank can switch out
+    and whose opcodes are read as plain data
+-------------------------------------------------*/
+
+bool m68000_base_device::drc_code_is_fixed(offs_t address)
+{
+	address &= program->bytemask();
+	void *raw = program->get_read_ptr(address);
+	if (program->get_write_ptr(address) != NULL || raw == NULL)
+		return false;
+
+	/* opcodes from a separate decrypted region (FD1094 swaps it at will) or
+	   redirected by a direct update handler are left to the interpreter */
+	if (m_direct->read_decrypted_ptr(address) != raw)
+		return false;
+
+	/* named banks can be switched at any time; anonymous ones are plain ROM */
+	for (memory_bank *bank = machine().memory().first_bank(); bank != NULL; bank = bank->next())
+		if (!bank->anonymous() && bank->fully_covers(address, address) && bank->references_space(*program, ROW_READ))
+			return false;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    compile_current - compile the code at the
+    current PC if it is in fixed ROM
+-------------------------------------------------*/
+
+bool m68k_recompiler::compile_current()
+{
+	if (!m_m68k.drc_code_is_fixed(REG_PC(&m_m68k)))
+		return false;
+
+	compile_block(m_frontend.describe_code(REG_PC(&m_m68k)), 0);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    interpret - interpret a few instructions from
+    the current PC
+-------------------------------------------------*/
+
+void m68k_recompiler::interpret()
+{
+	m_m68k.drc_interpret(INTERPRET_INSTRUCTIONS);
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_dispatch - generate the checks made
+    before every hash lookup
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_dispatch(drcuml_block *block)
+{
+	/* leave when out of cycles or stopped */
+	UML_CMP(block, mem(&m_m68k.remaining_cycles), 0);                                       // cmp     [remaining_cycles],0
+	UML_EXITc(block, COND_LE, EXECUTE_OUT_OF_CYCLES);                                       // exit    EXECUTE_OUT_OF_CYCLES,le
+	UML_CMP(block, mem(&m_m68k.stopped), 0);                                                // cmp     [stopped],0
+	UML_EXITc(block, COND_NE, EXECUTE_OUT_OF_CYCLES);                                       // exit    EXECUTE_OUT_OF_CYCLES,ne
+
+	/* tracing and odd PCs are left to the interpreter */
+	UML_OR(block, I0, mem(&m_m68k.t1_flag), mem(&m_m68k.t0_flag));                          // or      i0,[t1_flag],[t0_flag]
+	UML_EXITc(block, COND_NZ, EXECUTE_INTERPRET);                                           // exit    EXECUTE_INTERPRET,nz
+	UML_TEST(block, mem(&m_m68k.pc), 1);                                                    // test    [pc],1
+	UML_EXITc(block, COND_NZ, EXECUTE_INTERPRET);                                           // exit    EXECUTE_INTERPRET,nz
+
+	/* generate a hash jump via the current PC */
+	UML_HASHJMP(block, 0, mem(&m_m68k.pc), *m_nocode);                                      // hashjmp 0,[pc],nocode
+}
+
+
+/*-------------------------------------------------
+    generate_nocode - generate the rest of the
+    out-of-code handler, which gets the PC from
+    the exception parameter
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_nocode(drcuml_block *block)
+{
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_MOV(block, mem(&m_m68k.pc), I0);                                                    // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                                  // exit    EXECUTE_MISSING_CODE
+}
+
+
+/*-------------------------------------------------
+    generate_invalid - send code outside fixed
+    ROM to the interpreter
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_invalid(drcuml_block *block, const opcode_desc *desc)
+{
+	UML_MOV(block, mem(&m_m68k.pc), desc->pc);                                              // mov     [pc],desc->pc
+	UML_EXIT(block, EXECUTE_INTERPRET);                                                     // exit    EXECUTE_INTERPRET
+}
+
+
+/*-------------------------------------------------
+    generate_call - generate the code for one
+    instruction
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_call(drcuml_block *block, const opcode_desc *desc)
+{
+	/* add a disassembly comment */
+	if (m_drcuml.logging())
+	{
+		char buffer[256];
+		m_m68k.disassemble(buffer, desc->pc, desc->opptr.b, desc->opptr.b);
+		block->append_comment("%08X: %s", desc->pc, buffer);                               // comment
+	}
+
+	/* compile it to UML if we can, otherwise call the handler */
+	if (!m_native || !generate_native(block, desc))
+		generate_execute_one(block, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_execute_one - generate the call to
+    the handler for one instruction
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_execute_one(drcuml_block *block, const opcode_desc *desc)
+{
+	UML_MOV(block, mem(&m_m68k.ir), (desc->opptr.b[0] << 8) | desc->opptr.b[1]);            // mov     [ir],opcode
+	UML_CALLC(block, cfunc_execute_one, &m_m68k);                                           // callc   execute_one,m68k
+}
+
+
+/*-------------------------------------------------
+    generate_native - compile an instruction to
+    UML; returns false if it must be called
+-------------------------------------------------*/
+
+bool m68k_recompiler::generate_native(drcuml_block *block, const opcode_desc *desc)
+{
+	UINT16 opcode = (desc->opptr.b[0] << 8) | desc->opptr.b[1];
+	UINT16 ext1 = (desc->opptr.b[2] << 8) | desc->opptr.b[3];
+	UINT32 ext2 = (ext1 << 16) | (desc->opptr.b[4] << 8) | desc->opptr.b[5];
+	UINT32 *dx = &m_m68k.dar[(opcode >> 9) & 7];
+	UINT32 *dy = &m_m68k.dar[opcode & 7];
+	UINT32 *ay = &m_m68k.dar[8 + (opcode & 7)];
+	UINT32 quick = (((opcode >> 9) - 1) & 7) + 1;
+	UINT32 cycles = m_m68k.cyc_instruction[opcode];
+	offs_t nextpc = desc->pc + desc->length;
+
+	/* MOVEQ */
+	if ((opcode & 0xf100) == 0x7000)
+	{
+		UINT32 res = (INT8)opcode;
+		UML_MOV(block, mem(dx), res);                                                      // mov     [dx],res
+		generate_flags_logic(block, res, 4);
+	}
+
+	/* MOVE.L/W/B Dy,Dx */
+	else if ((opcode & 0xf1f8) == 0x2000)
+	{
+		UML_MOV(block, I2, mem(dy));                                                       // mov     i2,[dy]
+		UML_MOV(block, mem(dx), I2);                                                       // mov     [dx],i2
+		generate_flags_logic(block, I2, 4);
+	}
+	else if ((opcode & 0xf1f8) == 0x3000 || (opcode & 0xf1f8) == 0x1000)
+	{
+		UINT32 mask = ((opcode & 0xf000) == 0x3000) ? 0xffff : 0xff;
+		UML_AND(block, I2, mem(dy), mask);                                                 // and     i2,[dy],mask
+		UML_ROLINS(block, mem(dx), I2, 0, mask);                                           // rolins  [dx],i2,0,mask
+		generate_flags_logic(block, I2, (mask == 0xffff) ? 2 : 1);
+	}
+
+	/* MOVE.L/W #imm,Dx */
+	else if ((opcode & 0xf1ff) == 0x203c)
+	{
+		UML_MOV(block, mem(dx), ext2);                                                     // mov     [dx],ext2
+		generate_flags_logic(block, ext2, 4);
+	}
+	else if ((opcode & 0xf1ff) == 0x303c)
+	{
+		UML_ROLINS(block, mem(dx), ext1, 0, 0xffff);                                       // rolins  [dx],ext1,0,0xffff
+		generate_flags_logic(block, ext1, 2);
+	}
+
+	/* ADD.L, SUB.L and CMP.L Dy,Dx */
+	else if ((opcode & 0xf1f8) == 0xd080 || (opcode & 0xf1f8) == 0x9080 || (opcode & 0xf1f8) == 0xb080)
+	{
+		UML_MOV(block, I0, mem(dy));                                                       // mov     i0,[dy]
+		UML_MOV(block, I1, mem(dx));                                                       // mov     i1,[dx]
+		if ((opcode & 0xf000) == 0xd000)
+		{
+			UML_ADD(block, I2, I1, I0);                                                    // add     i2,i1,i0
+			generate_flags_add(block, true);
+		}
+		else
+		{
+			UML_SUB(block, I2, I1, I0);                                                    // sub     i2,i1,i0
+			generate_flags_sub(block, (opcode & 0xf000) == 0x9000);
+		}
+		if ((opcode & 0xf000) != 0xb000)
+			UML_MOV(block, mem(dx), I2);                                                   // mov     [dx],i2
+	}
+
+	/* AND.L and OR.L Dy,Dx, EOR.L Dx,Dy */
+	else if ((opcode & 0xf1f8) == 0xc080 || (opcode & 0xf1f8) == 0x8080)
+	{
+		if ((opcode & 0xf000) == 0xc000)
+			UML_AND(block, I2, mem(dx), mem(dy));                                          // and     i2,[dx],[dy]
+		else
+			UML_OR(block, I2, mem(dx), mem(dy));                                           // or      i2,[dx],[dy]
+		UML_MOV(block, mem(dx), I2);                                                       // mov     [dx],i2
+		generate_flags_logic(block, I2, 4);
+	}
+	else if ((opcode & 0xf1f8) == 0xb180)
+	{
+		UML_XOR(block, I2, mem(dy), mem(dx));                                              // xor     i2,[dy],[dx]
+		UML_MOV(block, mem(dy), I2);                                                       // mov     [dy],i2
+		generate_flags_logic(block, I2, 4);
+	}
+
+	/* ADDQ.L and SUBQ.L #q,Dy */
+	else if ((opcode & 0xf1f8) == 0x5080 || (opcode & 0xf1f8) == 0x5180)
+	{
+		UML_MOV(block, I0, quick);                                                         // mov     i0,quick
+		UML_MOV(block, I1, mem(dy));                                                       // mov     i1,[dy]
+		if ((opcode & 0x0100) == 0)
+		{
+			UML_ADD(block, I2, I1, I0);                                                    // add     i2,i1,i0
+			generate_flags_add(block, true);
+		}
+		else
+		{
+			UML_SUB(block, I2, I1, I0);                                                    // sub     i2,i1,i0
+			generate_flags_sub(block, true);
+		}
+		UML_MOV(block, mem(dy), I2);                                                       // mov     [dy],i2
+	}
+
+	/* ADDQ.L and SUBQ.L #q,Ay */
+	else if ((opcode & 0xf1f8) == 0x5088)
+		UML_ADD(block, mem(ay), mem(ay), quick);                                           // add     [ay],[ay],quick
+	else if ((opcode & 0xf1f8) == 0x5188)
+		UML_SUB(block, mem(ay), mem(ay), quick);                                           // sub     [ay],[ay],quick
+
+	/* TST.L Dy */
+	else if ((opcode & 0xfff8) == 0x4a80)
+		generate_flags_logic(block, mem(dy), 4);
+
+	/* BRA and Bcc; BSR pushes, and BRA to itself burns the timeslice */
+	else if ((opcode & 0xf000) == 0x6000)
+	{
+		int condition = (opcode >> 8) & 0x0f;
+		INT32 disp = (INT8)opcode;
+		UINT32 notake = m_m68k.cyc_bcc_notake_b;
+		if ((opcode & 0xff) == 0x00)
+		{
+			disp = (INT16)ext1;
+			notake = m_m68k.cyc_bcc_notake_w;
+		}
+		offs_t targetpc = desc->pc + 2 + disp;
+		if (condition == 1 || (opcode & 0xff) == 0xff || (targetpc & 1) != 0 || (condition == 0 && targetpc == desc->pc))
+			return false;
+
+		if (condition == 0)
+		{
+			generate_advance(block, desc, targetpc, cycles);
+			return true;
+		}
+
+		code_label notlabel = alloc_label();
+		code_label donelabel = alloc_label();
+		generate_branch_if_false(block, condition, notlabel);
+		generate_advance(block, desc, targetpc, cycles);
+		UML_JMP(block, donelabel);                                                         // jmp     done
+		UML_LABEL(block, notlabel);                                                        // not:
+		generate_advance(block, desc, nextpc, cycles + notake);
+		UML_LABEL(block, donelabel);                                                       // done:
+		return true;
+	}
+
+	/* DBRA */
+	else if ((opcode & 0xfff8) == 0x51c8)
+	{
+		offs_t targetpc = desc->pc + 2 + (INT16)ext1;
+		if ((targetpc & 1) != 0)
+			return false;
+
+		code_label explabel = alloc_label();
+		code_label donelabel = alloc_label();
+		UML_SUB(block, I0, mem(dy), 1);                                                    // sub     i0,[dy],1
+		UML_AND(block, I0, I0, 0xffff);                                                    // and     i0,i0,0xffff
+		UML_ROLINS(block, mem(dy), I0, 0, 0xffff);                                         // rolins  [dy],i0,0,0xffff
+		UML_CMP(block, I0, 0xffff);                                                        // cmp     i0,0xffff
+		UML_JMPc(block, COND_E, explabel);                                                 // jmp     exp,e
+		generate_advance(block, desc, targetpc, cycles + m_m68k.cyc_dbcc_f_noexp);
+		UML_JMP(block, donelabel);                                                         // jmp     done
+		UML_LABEL(block, explabel);                                                        // exp:
+		generate_advance(block, desc, nextpc, cycles + m_m68k.cyc_dbcc_f_exp);
+		UML_LABEL(block, donelabel);                                                       // done:
+		return true;
+	}
+
+	/* MOVEs between a data register and memory */
+	else
+		return generate_move_memory(block, desc, opcode);
+
+	generate_advance(block, desc, nextpc, cycles);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    generate_move_memory - compile a MOVE.L/W
+    between a data register and (An) or an
+    absolute address that lives in fast RAM
+-------------------------------------------------*/
+
+bool m68k_recompiler::generate_move_memory(drcuml_block *block, const opcode_desc *desc, UINT16 opcode)
+{
+	UINT16 ext1 = (desc->opptr.b[2] << 8) | desc->opptr.b[3];
+	UINT32 ext2 = (ext1 << 16) | (desc->opptr.b[4] << 8) | desc->opptr.b[5];
+	UINT32 cycles = m_m68k.cyc_instruction[opcode];
+	offs_t nextpc = desc->pc + desc->length;
+	UINT32 *dx = &m_m68k.dar[(opcode >> 9) & 7];
+	UINT32 *dy = &m_m68k.dar[opcode & 7];
+	bool iswrite, absolute;
+	offs_t address = 0;
+
+	/* fast RAM is kept as native 16-bit words */
+	if (m_m68k.program->data_width() != 16)
+		return false;
+
+	/* MOVE.L and MOVE.W only */
+	if ((opcode & 0xe000) != 0x2000)
+		return false;
+	int size = ((opcode & 0xf000) == 0x2000) ? 4 : 2;
+
+	/* (Ay),Dx and Dy,(Ax) */
+	if ((opcode & 0x01f8) == 0x0010)
+		iswrite = false, absolute = false;
+	else if ((opcode & 0x01f8) == 0x0080)
+		iswrite = true, absolute = false;
+
+	/* abs.w,Dx and abs.l,Dx */
+	else if ((opcode & 0x01ff) == 0x0038 || (opcode & 0x01ff) == 0x0039)
+	{
+		iswrite = false, absolute = true;
+		address = ((opcode & 1) == 0) ? (offs_t)(INT16)ext1 : ext2;
+	}
+
+	/* Dy,abs.w and Dy,abs.l */
+	else if ((opcode & 0x0ff8) == 0x01c0 || (opcode & 0x0ff8) == 0x03c0)
+	{
+		iswrite = true, absolute = true;
+		address = ((opcode & 0x0200) == 0) ? (offs_t)(INT16)ext1 : ext2;
+	}
+	else
+		return false;
+	if (!have_fastram(iswrite))
+		return false;
+
+	/* absolute addresses are resolved now, or left to the handler */
+	UINT8 *ptr = NULL;
+	if (absolute)
+	{
+		ptr = fastram_pointer(address, size, iswrite);
+		if (ptr == NULL)
+			return false;
+	}
+
+	code_label slowlabel = alloc_label();
+	code_label donelabel = alloc_label();
+
+	if (!iswrite)
+	{
+		/* read the value into i1 */
+		if (ptr != NULL)
+		{
+			UML_LOAD(block, I1, ptr, 0, SIZE_WORD, SCALE_x1);                              // load    i1,ptr,0,word_x1
+			if (size == 4)
+			{
+				UML_LOAD(block, I3, ptr + 2, 0, SIZE_WORD, SCALE_x1);                      // load    i3,ptr+2,0,word_x1
+				UML_SHL(block, I1, I1, 16);                                                // shl     i1,i1,16
+				UML_OR(block, I1, I1, I3);                                                 // or      i1,i1,i3
+			}
+		}
+		else
+		{
+			UML_MOV(block, I0, mem(&m_m68k.dar[8 + (opcode & 7)]));                        // mov     i0,[ay]
+			generate_fastram_read(block, size, slowlabel);
+		}
+
+		/* and put it in the register */
+		if (size == 4)
+			UML_MOV(block, mem(dx), I1);                                                   // mov     [dx],i1
+		else
+			UML_ROLINS(block, mem(dx), I1, 0, 0xffff);                                     // rolins  [dx],i1,0,0xffff
+	}
+	else
+	{
+		/* write the register from i1 */
+		if (size == 4)
+			UML_MOV(block, I1, mem(dy));                                                   // mov     i1,[dy]
+		else
+			UML_AND(block, I1, mem(dy), 0xffff);                                           // and     i1,[dy],0xffff
+		if (ptr != NULL)
+		{
+			if (size == 4)
+			{
+				UML_SHR(block, I3, I1, 16);                                                // shr     i3,i1,16
+				UML_STORE(block, ptr, 0, I3, SIZE_WORD, SCALE_x1);                         // store   ptr,0,i3,word_x1
+				UML_STORE(block, ptr + 2, 0, I1, SIZE_WORD, SCALE_x1);                     // store   ptr+2,0,i1,word_x1
+			}
+			else
+				UML_STORE(block, ptr, 0, I1, SIZE_WORD, SCALE_x1);                         // store   ptr,0,i1,word_x1
+		}
+		else
+		{
+			UML_MOV(block, I0, mem(&m_m68k.dar[8 + ((opcode >> 9) & 7)]));                 // mov     i0,[ax]
+			generate_fastram_write(block, size, slowlabel);
+		}
+	}
+
+	generate_flags_logic(block, I1, size);
+	generate_advance(block, desc, nextpc, cycles);
+
+	/* anything else, including address errors, goes to the handler */
+	if (ptr == NULL)
+	{
+		UML_JMP(block, donelabel);                                                         // jmp     done
+		UML_LABEL(block, slowlabel);                                                       // slow:
+		generate_execute_one(block, desc);
+		UML_LABEL(block, donelabel);                                                       // done:
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    generate_branch_if_false - jump to a label
+    if a condition code is false, testing the
+    flags the way the COND_ macros do
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_branch_if_false(drcuml_block *block, int condition, code_label falselabel)
+{
+	code_label truelabel = alloc_label();
+
+	switch (condition)
+	{
+		case 0x2:   /* HI */
+			UML_TEST(block, mem(&m_m68k.c_flag), 0x100);                                   // test    [c_flag],0x100
+			UML_JMPc(block, COND_NZ, falselabel);                                          // jmp     false,nz
+			UML_CMP(block, mem(&m_m68k.not_z_flag), 0);                                    // cmp     [not_z_flag],0
+			UML_JMPc(block, COND_E, falselabel);                                           // jmp     false,e
+			break;
+
+		case 0x3:   /* LS */
+			UML_TEST(block, mem(&m_m68k.c_flag), 0x100);                                   // test    [c_flag],0x100
+			UML_JMPc(block, COND_NZ, truelabel);                                           // jmp     true,nz
+			UML_CMP(block, mem(&m_m68k.not_z_flag), 0);                                    // cmp     [not_z_flag],0
+			UML_JMPc(block, COND_NE, falselabel);                                          // jmp     false,ne
+			break;
+
+		case 0x4:   /* CC */
+		case 0x5:   /* CS */
+			UML_TEST(block, mem(&m_m68k.c_flag), 0x100);                                   // test    [c_flag],0x100
+			UML_JMPc(block, (condition == 0x4) ? COND_NZ : COND_Z, falselabel);            // jmp     false,nz/z
+			break;
+
+		case 0x6:   /* NE */
+		case 0x7:   /* EQ */
+			UML_CMP(block, mem(&m_m68k.not_z_flag), 0);                                    // cmp     [not_z_flag],0
+			UML_JMPc(block, (condition == 0x6) ? COND_E : COND_NE, falselabel);            // jmp     false,e/ne
+			break;
+
+		case 0x8:   /* VC */
+		case 0x9:   /* VS */
+			UML_TEST(block, mem(&m_m68k.v_flag), 0x80);                                    // test    [v_flag],0x80
+			UML_JMPc(block, (condition == 0x8) ? COND_NZ : COND_Z, falselabel);            // jmp     false,nz/z
+			break;
+
+		case 0xa:   /* PL */
+		case 0xb:   /* MI */
+			UML_TEST(block, mem(&m_m68k.n_flag), 0x80);                                    // test    [n_flag],0x80
+			UML_JMPc(block, (condition == 0xa) ? COND_NZ : COND_Z, falselabel);            // jmp     false,nz/z
+			break;
+
+		case 0xc:   /* GE */
+		case 0xd:   /* LT */
+			UML_XOR(block, I0, mem(&m_m68k.n_flag), mem(&m_m68k.v_flag));                  // xor     i0,[n_flag],[v_flag]
+			UML_TEST(block, I0, 0x80);                                                     // test    i0,0x80
+			UML_JMPc(block, (condition == 0xc) ? COND_NZ : COND_Z, falselabel);            // jmp     false,nz/z
+			break;
+
+		case 0xe:   /* GT */
+			UML_XOR(block, I0, mem(&m_m68k.n_flag), mem(&m_m68k.v_flag));                  // xor     i0,[n_flag],[v_flag]
+			UML_TEST(block, I0, 0x80);                                                     // test    i0,0x80
+			UML_JMPc(block, COND_NZ, falselabel);                                          // jmp     false,nz
+			UML_CMP(block, mem(&m_m68k.not_z_flag), 0);                                    // cmp     [not_z_flag],0
+			UML_JMPc(block, COND_E, falselabel);                                           // jmp     false,e
+			break;
+
+		case 0xf:   /* LE */
+			UML_XOR(block, I0, mem(&m_m68k.n_flag), mem(&m_m68k.v_flag));                  // xor     i0,[n_flag],[v_flag]
+			UML_TEST(block, I0, 0x80);                                                     // test    i0,0x80
+			UML_JMPc(block, COND_NZ, truelabel);                                           // jmp     true,nz
+			UML_CMP(block, mem(&m_m68k.not_z_flag), 0);                                    // cmp     [not_z_flag],0
+			UML_JMPc(block, COND_NE, falselabel);                                          // jmp     false,ne
+			break;
+	}
+	UML_LABEL(block, truelabel);                                                           // true:
+}
+
+
+/*-------------------------------------------------
+    generate_flags_logic - set the flags after a
+    move or logical operation of the given size
+    in bytes, as NFLAG_xx and friends do
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_flags_logic(drcuml_block *block, parameter res, int size)
+{
+	if (size == 4)
+		UML_SHR(block, mem(&m_m68k.n_flag), res, 24);                                      // shr     [n_flag],res,24
+	else if (size == 2)
+		UML_SHR(block, mem(&m_m68k.n_flag), res, 8);                                       // shr     [n_flag],res,8
+	else
+		UML_MOV(block, mem(&m_m68k.n_flag), res);                                          // mov     [n_flag],res
+	UML_MOV(block, mem(&m_m68k.not_z_flag), res);                                          // mov     [not_z_flag],res
+	UML_MOV(block, mem(&m_m68k.v_flag), 0);                                                // mov     [v_flag],0
+	UML_MOV(block, mem(&m_m68k.c_flag), 0);                                                // mov     [c_flag],0
+}
+
+
+/*-------------------------------------------------
+    generate_flags_add - set the flags after a
+    32-bit add of i0 to i1 giving i2, as
+    VFLAG_ADD_32 and CFLAG_ADD_32 do; trashes
+    i0 and i3
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_flags_add(drcuml_block *block, bool setx)
+{
+	UML_SHR(block, mem(&m_m68k.n_flag), I2, 24);                                           // shr     [n_flag],i2,24
+	UML_MOV(block, mem(&m_m68k.not_z_flag), I2);                                           // mov     [not_z_flag],i2
+
+	/* v = ((src ^ res) & (dst ^ res)) >> 24 */
+	UML_XOR(block, I3, I0, I2);                                                            // xor     i3,i0,i2
+	UML_XOR(block, mem(&m_m68k.v_flag), I1, I2);                                           // xor     [v_flag],i1,i2
+	UML_AND(block, I3, I3, mem(&m_m68k.v_flag));                                           // and     i3,i3,[v_flag]
+	UML_SHR(block, mem(&m_m68k.v_flag), I3, 24);                                           // shr     [v_flag],i3,24
+
+	/* c = ((src & dst) | (~res & (src | dst))) >> 23 */
+	UML_AND(block, mem(&m_m68k.c_flag), I0, I1);                                           // and     [c_flag],i0,i1
+	UML_OR(block, I3, I0, I1);                                                             // or      i3,i0,i1
+	UML_XOR(block, I0, I2, 0xffffffff);                                                    // xor     i0,i2,~0
+	UML_AND(block, I3, I3, I0);                                                            // and     i3,i3,i0
+	UML_OR(block, I3, I3, mem(&m_m68k.c_flag));                                            // or      i3,i3,[c_flag]
+	UML_SHR(block, mem(&m_m68k.c_flag), I3, 23);                                           // shr     [c_flag],i3,23
+	if (setx)
+		UML_MOV(block, mem(&m_m68k.x_flag), mem(&m_m68k.c_flag));                          // mov     [x_flag],[c_flag]
+}
+
+
+/*-------------------------------------------------
+    generate_flags_sub - set the flags after a
+    32-bit subtract of i0 from i1 giving i2, as
+    VFLAG_SUB_32 and CFLAG_SUB_32 do; trashes
+    i0 and i3
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_flags_sub(drcuml_block *block, bool setx)
+{
+	UML_SHR(block, mem(&m_m68k.n_flag), I2, 24);                                           // shr     [n_flag],i2,24
+	UML_MOV(block, mem(&m_m68k.not_z_flag), I2);                                           // mov     [not_z_flag],i2
+
+	/* v = ((src ^ dst) & (res ^ dst)) >> 24 */
+	UML_XOR(block, I3, I0, I1);                                                            // xor     i3,i0,i1
+	UML_XOR(block, mem(&m_m68k.v_flag), I2, I1);                                           // xor     [v_flag],i2,i1
+	UML_AND(block, I3, I3, mem(&m_m68k.v_flag));                                           // and     i3,i3,[v_flag]
+	UML_SHR(block, mem(&m_m68k.v_flag), I3, 24);                                           // shr     [v_flag],i3,24
+
+	/* c = ((src & res) | (~dst & (src | res))) >> 23 */
+	UML_AND(block, mem(&m_m68k.c_flag), I0, I2);                                           // and     [c_flag],i0,i2
+	UML_OR(block, I3, I0, I2);                                                             // or      i3,i0,i2
+	UML_XOR(block, I0, I1, 0xffffffff);                                                    // xor     i0,i1,~0
+	UML_AND(block, I3, I3, I0);                                                            // and     i3,i3,i0
+	UML_OR(block, I3, I3, mem(&m_m68k.c_flag));                                            // or      i3,i3,[c_flag]
+	UML_SHR(block, mem(&m_m68k.c_flag), I3, 23);                                           // shr     [c_flag],i3,23
+	if (setx)
+		UML_MOV(block, mem(&m_m68k.x_flag), mem(&m_m68k.c_flag));                          // mov     [x_flag],[c_flag]
+}
+
+
+/*-------------------------------------------------
+    generate_fastram_read - read the word or long
+    at the address in i0 into i1 from fast RAM,
+    jumping to a label if it isn't there or is
+    misaligned; trashes i3
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_fastram_read(drcuml_block *block, int size, code_label slowlabel)
+{
+	code_label donelabel = alloc_label();
+
+	UML_AND(block, I0, I0, m_m68k.program->bytemask());                                    // and     i0,i0,bytemask
+	UML_TEST(block, I0, 1);                                                                // test    i0,1
+	UML_JMPc(block, COND_NZ, slowlabel);                                                   // jmp     slow,nz
+
+	for (int ramnum = 0; ramnum < m_m68k.m_drcfastram_select; ramnum++)
+	{
+		UINT8 *fastbase = (UINT8 *)m_m68k.m_drcfastram[ramnum].base - m_m68k.m_drcfastram[ramnum].start;
+		code_label skip = alloc_label();
+		UML_CMP(block, I0, m_m68k.m_drcfastram[ramnum].end - (size - 1));                  // cmp     i0,end-(size-1)
+		UML_JMPc(block, COND_A, skip);                                                     // jmp     skip,a
+		if (m_m68k.m_drcfastram[ramnum].start != 0)
+		{
+			UML_CMP(block, I0, m_m68k.m_drcfastram[ramnum].start);                         // cmp     i0,start
+			UML_JMPc(block, COND_B, skip);                                                 // jmp     skip,b
+		}
+		UML_LOAD(block, I1, fastbase, I0, SIZE_WORD, SCALE_x1);                            // load    i1,fastbase,i0,word_x1
+		if (size == 4)
+		{
+			UML_ADD(block, I3, I0, 2);                                                     // add     i3,i0,2
+			UML_LOAD(block, I3, fastbase, I3, SIZE_WORD, SCALE_x1);                        // load    i3,fastbase,i3,word_x1
+			UML_SHL(block, I1, I1, 16);                                                    // shl     i1,i1,16
+			UML_OR(block, I1, I1, I3);                                                     // or      i1,i1,i3
+		}
+		UML_JMP(block, donelabel);                                                         // jmp     done
+		UML_LABEL(block, skip);                                                            // skip:
+	}
+	UML_JMP(block, slowlabel);                                                             // jmp     slow
+	UML_LABEL(block, donelabel);                                                           // done:
+}
+
+
+/*-------------------------------------------------
+    generate_fastram_write - write the word or
+    long in i1 to the address in i0 in fast RAM,
+    jumping to a label if it isn't there or is
+    misaligned; trashes i3
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_fastram_write(drcuml_block *block, int size, code_label slowlabel)
+{
+	code_label donelabel = alloc_label();
+
+	UML_AND(block, I0, I0, m_m68k.program->bytemask());                                    // and     i0,i0,bytemask
+	UML_TEST(block, I0, 1);                                                                // test    i0,1
+	UML_JMPc(block, COND_NZ, slowlabel);                                                   // jmp     slow,nz
+
+	for (int ramnum = 0; ramnum < m_m68k.m_drcfastram_select; ramnum++)
+		if (!m_m68k.m_drcfastram[ramnum].readonly)
+		{
+			UINT8 *fastbase = (UINT8 *)m_m68k.m_drcfastram[ramnum].base - m_m68k.m_drcfastram[ramnum].start;
+			code_label skip = alloc_label();
+			UML_CMP(block, I0, m_m68k.m_drcfastram[ramnum].end - (size - 1));              // cmp     i0,end-(size-1)
+			UML_JMPc(block, COND_A, skip);                                                 // jmp     skip,a
+			if (m_m68k.m_drcfastram[ramnum].start != 0)
+			{
+				UML_CMP(block, I0, m_m68k.m_drcfastram[ramnum].start);                     // cmp     i0,start
+				UML_JMPc(block, COND_B, skip);                                             // jmp     skip,b
+			}
+			if (size == 4)
+			{
+				UML_SHR(block, I3, I1, 16);                                                // shr     i3,i1,16
+				UML_STORE(block, fastbase, I0, I3, SIZE_WORD, SCALE_x1);                   // store   fastbase,i0,i3,word_x1
+				UML_ADD(block, I3, I0, 2);                                                 // add     i3,i0,2
+				UML_STORE(block, fastbase, I3, I1, SIZE_WORD, SCALE_x1);                   // store   fastbase,i3,i1,word_x1
+			}
+			else
+				UML_STORE(block, fastbase, I0, I1, SIZE_WORD, SCALE_x1);                   // store   fastbase,i0,i1,word_x1
+			UML_JMP(block, donelabel);                                                     // jmp     done
+			UML_LABEL(block, skip);                                                        // skip:
+		}
+	UML_JMP(block, slowlabel);                                                             // jmp     slow
+	UML_LABEL(block, donelabel);                                                           // done:
+}
+
+
+/*-------------------------------------------------
+    generate_advance - finish a compiled
+    instruction the way drc_execute_one does
+-------------------------------------------------*/
+
+void m68k_recompiler::generate_advance(drcuml_block *block, const opcode_desc *desc, offs_t pc, UINT32 cycles)
+{
+	UML_MOV(block, mem(&m_m68k.ppc), desc->pc);                                            // mov     [ppc],desc->pc
+	UML_MOV(block, mem(&m_m68k.pc), pc);                                                   // mov     [pc],pc
+	UML_MOV(block, mem(&m_nextpc), pc);                                                    // mov     [nextpc],pc
+	UML_SUB(block, mem(&m_m68k.remaining_cycles), mem(&m_m68k.remaining_cycles), cycles);  // sub     [remaining_cycles],[remaining_cycles],cycles
+	UML_MOVc(block, COND_LE, mem(&m_nextpc), 0xffffffff);                                  // mov     [nextpc],~0,le
+}
+
+
+/*-------------------------------------------------
+    fastram_pointer - return where an access to
+    a fixed address lives in fast RAM, or NULL
+-------------------------------------------------*/
+
+UINT8 *m68k_recompiler::fastram_pointer(offs_t address, int size, bool iswrite)
+{
+	address &= m_m68k.program->bytemask();
+	if ((address & 1) != 0)
+		return NULL;
+
+	for (int ramnum = 0; ramnum < m_m68k.m_drcfastram_select; ramnum++)
+		if (m_m68k.m_drcfastram[ramnum].base != NULL && (!iswrite || !m_m68k.m_drcfastram[ramnum].readonly) &&
+			address >= m_m68k.m_drcfastram[ramnum].start && address + (size - 1) <= m_m68k.m_drcfastram[ramnum].end)
+			return (UINT8 *)m_m68k.m_drcfastram[ramnum].base + (address - m_m68k.m_drcfastram[ramnum].start);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    have_fastram - return true if any fast RAM
+    can take a read or a write
+-------------------------------------------------*/
+
+bool m68k_recompiler::have_fastram(bool iswrite)
+{
+	for (int ramnum = 0; ramnum < m_m68k.m_drcfastram_select; ramnum++)
+		if (m_m68k.m_drcfastram[ramnum].base != NULL && (!iswrite || !m_m68k.m_drcfastram[ramnum].readonly))
+			return true;
+	return false;
+}
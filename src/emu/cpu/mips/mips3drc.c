@@ -249,6 +249,9 @@ void mips3_device::code_flush_cache()
 			static_generate_memory_accessor(mode, 8, TRUE,  FALSE, "write64",     &m_write64[mode]);
 			static_generate_memory_accessor(mode, 8, TRUE,  TRUE,  "write64mask", &m_write64mask[mode]);
 		}
+
+		/* from here on, evict old blocks rather than flushing when the cache fills */
+		m_drcuml->lock_static_code();
 	}
 	catch (drcuml_block::abort_compilation &)
 	{
@@ -274,7 +277,7 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	desclist = m_drcfe->describe_code(pc, mode);
 	if (drcuml->logging() || drcuml->logging_native())
 		log_opcode_desc(drcuml, desclist, 0);
 
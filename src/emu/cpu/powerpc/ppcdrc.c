@@ -367,7 +367,7 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	desclist = m_drcfe->describe_code(pc, mode);
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(m_drcuml, desclist, 0);
 
@@ -1116,6 +1116,8 @@ void psxcpu_device::update_memory_handlers()
 	{
 		m_bus_attached = 1;
 	}
+
+	update_drc_scratchpad();
 }
 
 void psxcpu_device::funct_mthi()
@@ -1334,6 +1336,14 @@ void psxcpu_device::update_scratchpad()
 	{
 		m_program->install_ram( 0x1f800000, 0x1f8003ff, m_dcache );
 	}
+
+	update_drc_scratchpad();
+}
+
+void psxcpu_device::update_drc_scratchpad()
+{
+	// compiled loads and stores only go straight to the scratchpad while the CPU sees it as RAM
+	m_drcscratchpad = ( m_bus_attached && ( m_biu & ( BIU_RAM | BIU_DS ) ) == ( BIU_RAM | BIU_DS ) ) ? 1 : 0;
 }
 
 void psxcpu_device::update_ram_config()
@@ -1385,6 +1395,9 @@ void psxcpu_device::update_ram_config()
 	m_program->install_readwrite_handler( 0x00000000 + window_size, 0x1effffff, read32_delegate( FUNC( psxcpu_device::berr_r ), this ), write32_delegate( FUNC( psxcpu_device::berr_w ), this ) );
 	m_program->install_readwrite_handler( 0x80000000 + window_size, 0x9effffff, read32_delegate( FUNC( psxcpu_device::berr_r ), this ), write32_delegate( FUNC( psxcpu_device::berr_w ), this ) );
 	m_program->install_readwrite_handler( 0xa0000000 + window_size, 0xbeffffff, read32_delegate( FUNC( psxcpu_device::berr_r ), this ), write32_delegate( FUNC( psxcpu_device::berr_w ), this ) );
+
+	// compiled code may have come from the old mapping
+	drc_set_dirty();
 }
 
 void psxcpu_device::update_rom_config()
@@ -1423,6 +1436,9 @@ void psxcpu_device::update_rom_config()
 		m_program->install_readwrite_handler( 0x9fc00000 + window_size, 0x9fffffff, read32_delegate( FUNC( psxcpu_device::berr_r ), this ), write32_delegate( FUNC( psxcpu_device::berr_w ), this ) );
 		m_program->install_readwrite_handler( 0xbfc00000 + window_size, 0xbfffffff, read32_delegate( FUNC( psxcpu_device::berr_r ), this ), write32_delegate( FUNC( psxcpu_device::berr_w ), this ) );
 	}
+
+	// compiled code may have come from the old mapping
+	drc_set_dirty();
 }
 
 void psxcpu_device::update_cop0( int reg )
@@ -1748,6 +1764,9 @@ ADDRESS_MAP_END
 psxcpu_device::psxcpu_device( const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source ) :
 	cpu_device( mconfig, type, name, tag, owner, clock, shortname, source ),
 	m_program_config( "program", ENDIANNESS_LITTLE, 32, 32, 0, ADDRESS_MAP_NAME( psxcpu_internal_map ) ),
+	m_drcenabled( false ),
+	m_drc( NULL ),
+	m_drcscratchpad( 0 ),
 	m_gpu_read_handler( *this ),
 	m_gpu_write_handler( *this ),
 	m_spu_read_handler( *this ),
@@ -1947,6 +1966,19 @@ void psxcpu_device::device_start()
 	m_cd_write_handler.resolve_safe();
 
 	m_rom = memregion( "rom" );
+
+	// the recompiler is allocated on first use
+	m_drcenabled = machine().options().drc() && machine().options().drc_psx();
+}
+
+
+//-------------------------------------------------
+//  device_stop - clean up the device
+//-------------------------------------------------
+
+void psxcpu_device::device_stop()
+{
+	drc_exit();
 }
 
 
@@ -2284,1012 +2316,1036 @@ void psxcpu_device::execute_set_input( int inputnum, int state )
 
 void psxcpu_device::execute_run()
 {
+	/* the recompiler leaves the debugger to the interpreter */
+	if( m_drcenabled && ( machine().debug_flags & DEBUG_FLAG_ENABLED ) == 0 )
+	{
+		execute_run_drc();
+		return;
+	}
+
 	do
 	{
 		if( LOG_BIOSCALL ) log_bioscall();
 		debugger_instruction_hook( this,  m_pc );
 
 		m_op = m_direct->read_decrypted_dword( m_pc );
+		execute_op();
 
-		if( m_berr )
-		{
-			fetch_bus_error_exception();
-		}
-		else
-		{
-			switch( INS_OP( m_op ) )
-			{
-			case OP_SPECIAL:
-				switch( INS_FUNCT( m_op ) )
-				{
-				case FUNCT_SLL:
-					load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << INS_SHAMT( m_op ) );
-					break;
-
-				case FUNCT_SRL:
-					load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
-					break;
-
-				case FUNCT_SRA:
-					load( INS_RD( m_op ), (INT32)m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
-					break;
-
-				case FUNCT_SLLV:
-					load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << ( m_r[ INS_RS( m_op ) ] & 31 ) );
-					break;
-
-				case FUNCT_SRLV:
-					load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
-					break;
-
-				case FUNCT_SRAV:
-					load( INS_RD( m_op ), (INT32)m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
-					break;
-
-				case FUNCT_JR:
-					branch( m_r[ INS_RS( m_op ) ] );
-					break;
+		m_icount--;
+	} while( m_icount > 0 );
+}
 
-				case FUNCT_JALR:
-					branch( m_r[ INS_RS( m_op ) ] );
-					if( INS_RD( m_op ) != 0 )
-					{
-						m_r[ INS_RD( m_op ) ] = m_pc + 4;
-					}
-					break;
+void psxcpu_device::func_execute_one()
+{
+	if( LOG_BIOSCALL ) log_bioscall();
+	debugger_instruction_hook( this,  m_pc );
 
-				case FUNCT_SYSCALL:
-					if( LOG_BIOSCALL ) log_syscall();
-					exception( EXC_SYS );
-					break;
+	execute_op();
 
-				case FUNCT_BREAK:
-					exception( EXC_BP );
-					break;
+	m_icount--;
 
-				case FUNCT_MFHI:
-					load( INS_RD( m_op ), get_hi() );
-					break;
+	/* the generated code compares this with the address it expects; ~0 never matches */
+	m_drcnextpc = ( m_icount > 0 ) ? m_pc : ~0;
+}
 
-				case FUNCT_MTHI:
-					funct_mthi();
-					advance_pc();
-					break;
+void psxcpu_device::execute_op()
+{
+	if( m_berr )
+	{
+		fetch_bus_error_exception();
+	}
+	else
+	{
+		switch( INS_OP( m_op ) )
+		{
+		case OP_SPECIAL:
+			switch( INS_FUNCT( m_op ) )
+			{
+			case FUNCT_SLL:
+				load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << INS_SHAMT( m_op ) );
+				break;
 
-				case FUNCT_MFLO:
-					load( INS_RD( m_op ), get_lo() );
-					break;
+			case FUNCT_SRL:
+				load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
+				break;
 
-				case FUNCT_MTLO:
-					funct_mtlo();
-					advance_pc();
-					break;
+			case FUNCT_SRA:
+				load( INS_RD( m_op ), (INT32)m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
+				break;
 
-				case FUNCT_MULT:
-					funct_mult();
-					advance_pc();
-					break;
+			case FUNCT_SLLV:
+				load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << ( m_r[ INS_RS( m_op ) ] & 31 ) );
+				break;
 
-				case FUNCT_MULTU:
-					funct_multu();
-					advance_pc();
-					break;
+			case FUNCT_SRLV:
+				load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
+				break;
 
-				case FUNCT_DIV:
-					funct_div();
-					advance_pc();
-					break;
+			case FUNCT_SRAV:
+				load( INS_RD( m_op ), (INT32)m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
+				break;
 
-				case FUNCT_DIVU:
-					funct_divu();
-					advance_pc();
-					break;
+			case FUNCT_JR:
+				branch( m_r[ INS_RS( m_op ) ] );
+				break;
 
-				case FUNCT_ADD:
-					{
-						UINT32 result = m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ];
-						if( (INT32)( ~( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
-						{
-							exception( EXC_OVF );
-						}
-						else
-						{
-							load( INS_RD( m_op ), result );
-						}
-					}
-					break;
+			case FUNCT_JALR:
+				branch( m_r[ INS_RS( m_op ) ] );
+				if( INS_RD( m_op ) != 0 )
+				{
+					m_r[ INS_RD( m_op ) ] = m_pc + 4;
+				}
+				break;
 
-				case FUNCT_ADDU:
-					load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ] );
-					break;
+			case FUNCT_SYSCALL:
+				if( LOG_BIOSCALL ) log_syscall();
+				exception( EXC_SYS );
+				break;
 
-				case FUNCT_SUB:
-					{
-						UINT32 result = m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ];
-						if( (INT32)( ( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
-						{
-							exception( EXC_OVF );
-						}
-						else
-						{
-							load( INS_RD( m_op ), result );
-						}
-					}
-					break;
+			case FUNCT_BREAK:
+				exception( EXC_BP );
+				break;
 
-				case FUNCT_SUBU:
-					load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ] );
-					break;
+			case FUNCT_MFHI:
+				load( INS_RD( m_op ), get_hi() );
+				break;
 
-				case FUNCT_AND:
-					load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] & m_r[ INS_RT( m_op ) ] );
-					break;
+			case FUNCT_MTHI:
+				funct_mthi();
+				advance_pc();
+				break;
 
-				case FUNCT_OR:
-					load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] );
-					break;
+			case FUNCT_MFLO:
+				load( INS_RD( m_op ), get_lo() );
+				break;
 
-				case FUNCT_XOR:
-					load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] );
-					break;
+			case FUNCT_MTLO:
+				funct_mtlo();
+				advance_pc();
+				break;
 
-				case FUNCT_NOR:
-					load( INS_RD( m_op ), ~( m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] ) );
-					break;
+			case FUNCT_MULT:
+				funct_mult();
+				advance_pc();
+				break;
 
-				case FUNCT_SLT:
-					load( INS_RD( m_op ), (INT32)m_r[ INS_RS( m_op ) ] < (INT32)m_r[ INS_RT( m_op ) ] );
-					break;
+			case FUNCT_MULTU:
+				funct_multu();
+				advance_pc();
+				break;
 
-				case FUNCT_SLTU:
-					load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] < m_r[ INS_RT( m_op ) ] );
-					break;
+			case FUNCT_DIV:
+				funct_div();
+				advance_pc();
+				break;
 
-				default:
-					exception( EXC_RI );
-					break;
-				}
+			case FUNCT_DIVU:
+				funct_divu();
+				advance_pc();
 				break;
 
-			case OP_REGIMM:
-				switch( INS_RT_REGIMM( m_op ) )
+			case FUNCT_ADD:
 				{
-				case RT_BLTZ:
-					conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] < 0 );
-
-					if( INS_RT( m_op ) == RT_BLTZAL )
+					UINT32 result = m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ];
+					if( (INT32)( ~( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
 					{
-						m_r[ 31 ] = m_pc + 4;
+						exception( EXC_OVF );
 					}
-					break;
-
-				case RT_BGEZ:
-					conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] >= 0 );
-
-					if( INS_RT( m_op ) == RT_BGEZAL )
+					else
 					{
-						m_r[ 31 ] = m_pc + 4;
+						load( INS_RD( m_op ), result );
 					}
-					break;
 				}
 				break;
 
-			case OP_J:
-				unconditional_branch();
-				break;
-
-			case OP_JAL:
-				unconditional_branch();
-				m_r[ 31 ] = m_pc + 4;
-				break;
-
-			case OP_BEQ:
-				conditional_branch( m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
+			case FUNCT_ADDU:
+				load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ] );
 				break;
 
-			case OP_BNE:
-				conditional_branch( m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
-				break;
-
-			case OP_BLEZ:
-				conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] < 0 || m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
-				break;
-
-			case OP_BGTZ:
-				conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] >= 0 && m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
-				break;
-
-			case OP_ADDI:
+			case FUNCT_SUB:
 				{
-					UINT32 immediate = PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					UINT32 result = m_r[ INS_RS( m_op ) ] + immediate;
-					if( (INT32)( ~( m_r[ INS_RS( m_op ) ] ^ immediate ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
+					UINT32 result = m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ];
+					if( (INT32)( ( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
 					{
 						exception( EXC_OVF );
 					}
 					else
 					{
-						load( INS_RT( m_op ), result );
+						load( INS_RD( m_op ), result );
 					}
 				}
 				break;
 
-			case OP_ADDIU:
-				load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+			case FUNCT_SUBU:
+				load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ] );
 				break;
 
-			case OP_SLTI:
-				load( INS_RT( m_op ), (INT32)m_r[ INS_RS( m_op ) ] < PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+			case FUNCT_AND:
+				load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] & m_r[ INS_RT( m_op ) ] );
 				break;
 
-			case OP_SLTIU:
-				load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] < (UINT32)PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+			case FUNCT_OR:
+				load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] );
 				break;
 
-			case OP_ANDI:
-				load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] & INS_IMMEDIATE( m_op ) );
+			case FUNCT_XOR:
+				load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] );
 				break;
 
-			case OP_ORI:
-				load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] | INS_IMMEDIATE( m_op ) );
+			case FUNCT_NOR:
+				load( INS_RD( m_op ), ~( m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] ) );
 				break;
 
-			case OP_XORI:
-				load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] ^ INS_IMMEDIATE( m_op ) );
+			case FUNCT_SLT:
+				load( INS_RD( m_op ), (INT32)m_r[ INS_RS( m_op ) ] < (INT32)m_r[ INS_RT( m_op ) ] );
 				break;
 
-			case OP_LUI:
-				load( INS_RT( m_op ), INS_IMMEDIATE( m_op ) << 16 );
+			case FUNCT_SLTU:
+				load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] < m_r[ INS_RT( m_op ) ] );
 				break;
 
-			case OP_COP0:
-				switch( INS_RS( m_op ) )
-				{
-				case RS_MFC:
-					{
-						int reg = INS_RD( m_op );
-
-						if( reg == CP0_INDEX ||
-							reg == CP0_RANDOM ||
-							reg == CP0_ENTRYLO ||
-							reg == CP0_CONTEXT ||
-							reg == CP0_ENTRYHI )
-						{
-							exception( EXC_RI );
-						}
-						else if( reg < 16 )
-						{
-							if( cop0_usable() )
-							{
-								delayed_load( INS_RT( m_op ), m_cp0r[ reg ] );
-							}
-						}
-						else
-						{
-							advance_pc();
-						}
-					}
-					break;
+			default:
+				exception( EXC_RI );
+				break;
+			}
+			break;
 
-				case RS_CFC:
-					exception( EXC_RI );
-					break;
+		case OP_REGIMM:
+			switch( INS_RT_REGIMM( m_op ) )
+			{
+			case RT_BLTZ:
+				conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] < 0 );
 
-				case RS_MTC:
-					{
-						int reg = INS_RD( m_op );
+				if( INS_RT( m_op ) == RT_BLTZAL )
+				{
+					m_r[ 31 ] = m_pc + 4;
+				}
+				break;
 
-						if( reg == CP0_INDEX ||
-							reg == CP0_RANDOM ||
-							reg == CP0_ENTRYLO ||
-							reg == CP0_CONTEXT ||
-							reg == CP0_ENTRYHI )
-						{
-							exception( EXC_RI );
-						}
-						else if( reg < 16 )
-						{
-							if( cop0_usable() )
-							{
-								UINT32 data = ( m_cp0r[ reg ] & ~mtc0_writemask[ reg ] ) |
-									( m_r[ INS_RT( m_op ) ] & mtc0_writemask[ reg ] );
-								advance_pc();
+			case RT_BGEZ:
+				conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] >= 0 );
 
-								m_cp0r[ reg ] = data;
-								update_cop0( reg );
-							}
-						}
-						else
-						{
-							advance_pc();
-						}
-					}
-					break;
+				if( INS_RT( m_op ) == RT_BGEZAL )
+				{
+					m_r[ 31 ] = m_pc + 4;
+				}
+				break;
+			}
+			break;
 
-				case RS_CTC:
-					exception( EXC_RI );
-					break;
+		case OP_J:
+			unconditional_branch();
+			break;
 
-				case RS_BC:
-				case RS_BC_ALT:
-					switch( INS_BC( m_op ) )
-					{
-					case BC_BCF:
-						bc( 0, SR_CU0, 0 );
-						break;
+		case OP_JAL:
+			unconditional_branch();
+			m_r[ 31 ] = m_pc + 4;
+			break;
 
-					case BC_BCT:
-						bc( 0, SR_CU0, 1 );
-						break;
-					}
-					break;
+		case OP_BEQ:
+			conditional_branch( m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
+			break;
 
-				default:
-					switch( INS_CO( m_op ) )
-					{
-					case 1:
-						switch( INS_CF( m_op ) )
-						{
-						case CF_TLBR:
-						case CF_TLBWI:
-						case CF_TLBWR:
-						case CF_TLBP:
-							exception( EXC_RI );
-							break;
-
-						case CF_RFE:
-							if( cop0_usable() )
-							{
-								advance_pc();
-								m_cp0r[ CP0_SR ] = ( m_cp0r[ CP0_SR ] & ~0xf ) | ( ( m_cp0r[ CP0_SR ] >> 2 ) & 0xf );
-								update_cop0( CP0_SR );
-							}
-							break;
+		case OP_BNE:
+			conditional_branch( m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
+			break;
 
-						default:
-							advance_pc();
-							break;
-						}
-						break;
+		case OP_BLEZ:
+			conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] < 0 || m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
+			break;
 
-					default:
-						advance_pc();
-						break;
-					}
-					break;
-				}
-				break;
+		case OP_BGTZ:
+			conditional_branch( (INT32)m_r[ INS_RS( m_op ) ] >= 0 && m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
+			break;
 
-			case OP_COP1:
-				if( ( m_cp0r[ CP0_SR ] & SR_CU1 ) == 0 )
+		case OP_ADDI:
+			{
+				UINT32 immediate = PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				UINT32 result = m_r[ INS_RS( m_op ) ] + immediate;
+				if( (INT32)( ~( m_r[ INS_RS( m_op ) ] ^ immediate ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
 				{
-					exception( EXC_CPU );
+					exception( EXC_OVF );
 				}
 				else
 				{
-					switch( INS_RS( m_op ) )
-					{
-					case RS_MFC:
-						delayed_load( INS_RT( m_op ), getcp1dr( INS_RD( m_op ) ) );
-						break;
+					load( INS_RT( m_op ), result );
+				}
+			}
+			break;
 
-					case RS_CFC:
-						delayed_load( INS_RT( m_op ), getcp1cr( INS_RD( m_op ) ) );
-						break;
+		case OP_ADDIU:
+			load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+			break;
 
-					case RS_MTC:
-						setcp1dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-						advance_pc();
-						break;
+		case OP_SLTI:
+			load( INS_RT( m_op ), (INT32)m_r[ INS_RS( m_op ) ] < PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+			break;
 
-					case RS_CTC:
-						setcp1cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-						advance_pc();
-						break;
+		case OP_SLTIU:
+			load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] < (UINT32)PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+			break;
 
-					case RS_BC:
-					case RS_BC_ALT:
-						switch( INS_BC( m_op ) )
-						{
-						case BC_BCF:
-							bc( 1, SR_CU1, 0 );
-							break;
+		case OP_ANDI:
+			load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] & INS_IMMEDIATE( m_op ) );
+			break;
 
-						case BC_BCT:
-							bc( 1, SR_CU1, 1 );
-							break;
-						}
-						break;
+		case OP_ORI:
+			load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] | INS_IMMEDIATE( m_op ) );
+			break;
 
-					default:
+		case OP_XORI:
+			load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] ^ INS_IMMEDIATE( m_op ) );
+			break;
+
+		case OP_LUI:
+			load( INS_RT( m_op ), INS_IMMEDIATE( m_op ) << 16 );
+			break;
+
+		case OP_COP0:
+			switch( INS_RS( m_op ) )
+			{
+			case RS_MFC:
+				{
+					int reg = INS_RD( m_op );
+
+					if( reg == CP0_INDEX ||
+						reg == CP0_RANDOM ||
+						reg == CP0_ENTRYLO ||
+						reg == CP0_CONTEXT ||
+						reg == CP0_ENTRYHI )
+					{
+						exception( EXC_RI );
+					}
+					else if( reg < 16 )
+					{
+						if( cop0_usable() )
+						{
+							delayed_load( INS_RT( m_op ), m_cp0r[ reg ] );
+						}
+					}
+					else
+					{
 						advance_pc();
-						break;
 					}
 				}
 				break;
 
-			case OP_COP2:
-				if( ( m_cp0r[ CP0_SR ] & SR_CU2 ) == 0 )
+			case RS_CFC:
+				exception( EXC_RI );
+				break;
+
+			case RS_MTC:
 				{
-					exception( EXC_CPU );
-				}
-				else
-				{
-					switch( INS_RS( m_op ) )
-					{
-					case RS_MFC:
-						delayed_load( INS_RT( m_op ), m_gte.getcp2dr( m_pc, INS_RD( m_op ) ) );
-						break;
+					int reg = INS_RD( m_op );
 
-					case RS_CFC:
-						delayed_load( INS_RT( m_op ), m_gte.getcp2cr( m_pc, INS_RD( m_op ) ) );
-						break;
+					if( reg == CP0_INDEX ||
+						reg == CP0_RANDOM ||
+						reg == CP0_ENTRYLO ||
+						reg == CP0_CONTEXT ||
+						reg == CP0_ENTRYHI )
+					{
+						exception( EXC_RI );
+					}
+					else if( reg < 16 )
+					{
+						if( cop0_usable() )
+						{
+							UINT32 data = ( m_cp0r[ reg ] & ~mtc0_writemask[ reg ] ) |
+								( m_r[ INS_RT( m_op ) ] & mtc0_writemask[ reg ] );
+							advance_pc();
 
-					case RS_MTC:
-						m_gte.setcp2dr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+							m_cp0r[ reg ] = data;
+							update_cop0( reg );
+						}
+					}
+					else
+					{
 						advance_pc();
-						break;
+					}
+				}
+				break;
 
-					case RS_CTC:
-						m_gte.setcp2cr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-						advance_pc();
-						break;
+			case RS_CTC:
+				exception( EXC_RI );
+				break;
 
-					case RS_BC:
-					case RS_BC_ALT:
-						switch( INS_BC( m_op ) )
-						{
-						case BC_BCF:
-							bc( 2, SR_CU2, 0 );
-							break;
+			case RS_BC:
+			case RS_BC_ALT:
+				switch( INS_BC( m_op ) )
+				{
+				case BC_BCF:
+					bc( 0, SR_CU0, 0 );
+					break;
 
-						case BC_BCT:
-							bc( 2, SR_CU2, 1 );
-							break;
-						}
+				case BC_BCT:
+					bc( 0, SR_CU0, 1 );
+					break;
+				}
+				break;
+
+			default:
+				switch( INS_CO( m_op ) )
+				{
+				case 1:
+					switch( INS_CF( m_op ) )
+					{
+					case CF_TLBR:
+					case CF_TLBWI:
+					case CF_TLBWR:
+					case CF_TLBP:
+						exception( EXC_RI );
 						break;
 
-					default:
-						switch( INS_CO( m_op ) )
+					case CF_RFE:
+						if( cop0_usable() )
 						{
-						case 1:
-							if( !m_gte.docop2( m_pc, INS_COFUN( m_op ) ) )
-							{
-								stop();
-							}
-
 							advance_pc();
-							break;
-
-						default:
-							advance_pc();
-							break;
+							m_cp0r[ CP0_SR ] = ( m_cp0r[ CP0_SR ] & ~0xf ) | ( ( m_cp0r[ CP0_SR ] >> 2 ) & 0xf );
+							update_cop0( CP0_SR );
 						}
 						break;
+
+					default:
+						advance_pc();
+						break;
 					}
+					break;
+
+				default:
+					advance_pc();
+					break;
 				}
 				break;
+			}
+			break;
 
-			case OP_COP3:
-				if( ( m_cp0r[ CP0_SR ] & SR_CU3 ) == 0 )
-				{
-					exception( EXC_CPU );
-				}
-				else
+		case OP_COP1:
+			if( ( m_cp0r[ CP0_SR ] & SR_CU1 ) == 0 )
+			{
+				exception( EXC_CPU );
+			}
+			else
+			{
+				switch( INS_RS( m_op ) )
 				{
-					switch( INS_RS( m_op ) )
+				case RS_MFC:
+					delayed_load( INS_RT( m_op ), getcp1dr( INS_RD( m_op ) ) );
+					break;
+
+				case RS_CFC:
+					delayed_load( INS_RT( m_op ), getcp1cr( INS_RD( m_op ) ) );
+					break;
+
+				case RS_MTC:
+					setcp1dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+					advance_pc();
+					break;
+
+				case RS_CTC:
+					setcp1cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+					advance_pc();
+					break;
+
+				case RS_BC:
+				case RS_BC_ALT:
+					switch( INS_BC( m_op ) )
 					{
-					case RS_MFC:
-						delayed_load( INS_RT( m_op ), getcp3dr( INS_RD( m_op ) ) );
+					case BC_BCF:
+						bc( 1, SR_CU1, 0 );
 						break;
 
-					case RS_CFC:
-						delayed_load( INS_RT( m_op ), getcp3cr( INS_RD( m_op ) ) );
+					case BC_BCT:
+						bc( 1, SR_CU1, 1 );
 						break;
+					}
+					break;
 
-					case RS_MTC:
-						setcp3dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-						advance_pc();
+				default:
+					advance_pc();
+					break;
+				}
+			}
+			break;
+
+		case OP_COP2:
+			if( ( m_cp0r[ CP0_SR ] & SR_CU2 ) == 0 )
+			{
+				exception( EXC_CPU );
+			}
+			else
+			{
+				switch( INS_RS( m_op ) )
+				{
+				case RS_MFC:
+					delayed_load( INS_RT( m_op ), m_gte.getcp2dr( m_pc, INS_RD( m_op ) ) );
+					break;
+
+				case RS_CFC:
+					delayed_load( INS_RT( m_op ), m_gte.getcp2cr( m_pc, INS_RD( m_op ) ) );
+					break;
+
+				case RS_MTC:
+					m_gte.setcp2dr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+					advance_pc();
+					break;
+
+				case RS_CTC:
+					m_gte.setcp2cr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+					advance_pc();
+					break;
+
+				case RS_BC:
+				case RS_BC_ALT:
+					switch( INS_BC( m_op ) )
+					{
+					case BC_BCF:
+						bc( 2, SR_CU2, 0 );
 						break;
 
-					case RS_CTC:
-						setcp3cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-						advance_pc();
+					case BC_BCT:
+						bc( 2, SR_CU2, 1 );
 						break;
+					}
+					break;
 
-					case RS_BC:
-					case RS_BC_ALT:
-						switch( INS_BC( m_op ) )
+				default:
+					switch( INS_CO( m_op ) )
+					{
+					case 1:
+						if( !m_gte.docop2( m_pc, INS_COFUN( m_op ) ) )
 						{
-						case BC_BCF:
-							bc( 3, SR_CU3, 0 );
-							break;
-
-						case BC_BCT:
-							bc( 3, SR_CU3, 1 );
-							break;
+							stop();
 						}
+
+						advance_pc();
 						break;
 
 					default:
 						advance_pc();
 						break;
 					}
+					break;
 				}
-				break;
+			}
+			break;
 
-			case OP_LB:
+		case OP_COP3:
+			if( ( m_cp0r[ CP0_SR ] & SR_CU3 ) == 0 )
+			{
+				exception( EXC_CPU );
+			}
+			else
+			{
+				switch( INS_RS( m_op ) )
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = load_data_address_breakpoint( address );
+				case RS_MFC:
+					delayed_load( INS_RT( m_op ), getcp3dr( INS_RD( m_op ) ) );
+					break;
 
-					if( ( address & m_bad_byte_address_mask ) != 0 )
-					{
-						load_bad_address( address );
-					}
-					else if( breakpoint )
-					{
-						breakpoint_exception();
-					}
-					else
+				case RS_CFC:
+					delayed_load( INS_RT( m_op ), getcp3cr( INS_RD( m_op ) ) );
+					break;
+
+				case RS_MTC:
+					setcp3dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+					advance_pc();
+					break;
+
+				case RS_CTC:
+					setcp3cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+					advance_pc();
+					break;
+
+				case RS_BC:
+				case RS_BC_ALT:
+					switch( INS_BC( m_op ) )
 					{
-						UINT32 data = PSXCPU_BYTE_EXTEND( readbyte( address ) );
+					case BC_BCF:
+						bc( 3, SR_CU3, 0 );
+						break;
 
-						if( m_berr )
-						{
-							load_bus_error_exception();
-						}
-						else
-						{
-							delayed_load( INS_RT( m_op ), data );
-						}
+					case BC_BCT:
+						bc( 3, SR_CU3, 1 );
+						break;
 					}
+					break;
+
+				default:
+					advance_pc();
+					break;
 				}
-				break;
+			}
+			break;
 
-			case OP_LH:
+		case OP_LB:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = load_data_address_breakpoint( address );
+
+				if( ( address & m_bad_byte_address_mask ) != 0 )
+				{
+					load_bad_address( address );
+				}
+				else if( breakpoint )
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = load_data_address_breakpoint( address );
+					breakpoint_exception();
+				}
+				else
+				{
+					UINT32 data = PSXCPU_BYTE_EXTEND( readbyte( address ) );
 
-					if( ( address & m_bad_half_address_mask ) != 0 )
+					if( m_berr )
 					{
-						load_bad_address( address );
-					}
-					else if( breakpoint )
-					{
-						breakpoint_exception();
+						load_bus_error_exception();
 					}
 					else
 					{
-						UINT32 data = PSXCPU_WORD_EXTEND( readhalf( address ) );
-
-						if( m_berr )
-						{
-							load_bus_error_exception();
-						}
-						else
-						{
-							delayed_load( INS_RT( m_op ), data );
-						}
+						delayed_load( INS_RT( m_op ), data );
 					}
 				}
-				break;
+			}
+			break;
 
-			case OP_LWL:
-				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int load_type = address & 3;
-					int breakpoint;
+		case OP_LH:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = load_data_address_breakpoint( address );
 
-					address &= ~3;
-					breakpoint = load_data_address_breakpoint( address );
+				if( ( address & m_bad_half_address_mask ) != 0 )
+				{
+					load_bad_address( address );
+				}
+				else if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else
+				{
+					UINT32 data = PSXCPU_WORD_EXTEND( readhalf( address ) );
 
-					if( ( address & m_bad_byte_address_mask ) != 0 )
-					{
-						load_bad_address( address );
-					}
-					else if( breakpoint )
+					if( m_berr )
 					{
-						breakpoint_exception();
+						load_bus_error_exception();
 					}
 					else
 					{
-						UINT32 data = get_register_from_pipeline( INS_RT( m_op ) );
-
-						switch( load_type )
-						{
-						case 0:
-							data = ( data & 0x00ffffff ) | ( readword_masked( address, 0x000000ff ) << 24 );
-							break;
-
-						case 1:
-							data = ( data & 0x0000ffff ) | ( readword_masked( address, 0x0000ffff ) << 16 );
-							break;
+						delayed_load( INS_RT( m_op ), data );
+					}
+				}
+			}
+			break;
 
-						case 2:
-							data = ( data & 0x000000ff ) | ( readword_masked( address, 0x00ffffff ) << 8 );
-							break;
+		case OP_LWL:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int load_type = address & 3;
+				int breakpoint;
 
-						case 3:
-							data = readword( address );
-							break;
-						}
+				address &= ~3;
+				breakpoint = load_data_address_breakpoint( address );
 
-						if( m_berr )
-						{
-							load_bus_error_exception();
-						}
-						else
-						{
-							delayed_load( INS_RT( m_op ), data );
-						}
-					}
+				if( ( address & m_bad_byte_address_mask ) != 0 )
+				{
+					load_bad_address( address );
 				}
-				break;
-
-			case OP_LW:
+				else if( breakpoint )
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = load_data_address_breakpoint( address );
+					breakpoint_exception();
+				}
+				else
+				{
+					UINT32 data = get_register_from_pipeline( INS_RT( m_op ) );
 
-					if( ( address & m_bad_word_address_mask ) != 0 )
+					switch( load_type )
 					{
-						load_bad_address( address );
+					case 0:
+						data = ( data & 0x00ffffff ) | ( readword_masked( address, 0x000000ff ) << 24 );
+						break;
+
+					case 1:
+						data = ( data & 0x0000ffff ) | ( readword_masked( address, 0x0000ffff ) << 16 );
+						break;
+
+					case 2:
+						data = ( data & 0x000000ff ) | ( readword_masked( address, 0x00ffffff ) << 8 );
+						break;
+
+					case 3:
+						data = readword( address );
+						break;
 					}
-					else if( breakpoint )
+
+					if( m_berr )
 					{
-						breakpoint_exception();
+						load_bus_error_exception();
 					}
 					else
 					{
-						UINT32 data = readword( address );
-
-						if( m_berr )
-						{
-							load_bus_error_exception();
-						}
-						else
-						{
-							delayed_load( INS_RT( m_op ), data );
-						}
+						delayed_load( INS_RT( m_op ), data );
 					}
 				}
-				break;
+			}
+			break;
 
-			case OP_LBU:
+		case OP_LW:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = load_data_address_breakpoint( address );
+
+				if( ( address & m_bad_word_address_mask ) != 0 )
+				{
+					load_bad_address( address );
+				}
+				else if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = load_data_address_breakpoint( address );
+					UINT32 data = readword( address );
 
-					if( ( address & m_bad_byte_address_mask ) != 0 )
-					{
-						load_bad_address( address );
-					}
-					else if( breakpoint )
+					if( m_berr )
 					{
-						breakpoint_exception();
+						load_bus_error_exception();
 					}
 					else
 					{
-						UINT32 data = readbyte( address );
-
-						if( m_berr )
-						{
-							load_bus_error_exception();
-						}
-						else
-						{
-							delayed_load( INS_RT( m_op ), data );
-						}
+						delayed_load( INS_RT( m_op ), data );
 					}
 				}
-				break;
+			}
+			break;
+
+		case OP_LBU:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = load_data_address_breakpoint( address );
 
-			case OP_LHU:
+				if( ( address & m_bad_byte_address_mask ) != 0 )
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = load_data_address_breakpoint( address );
+					load_bad_address( address );
+				}
+				else if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else
+				{
+					UINT32 data = readbyte( address );
 
-					if( ( address & m_bad_half_address_mask ) != 0 )
-					{
-						load_bad_address( address );
-					}
-					else if( breakpoint )
+					if( m_berr )
 					{
-						breakpoint_exception();
+						load_bus_error_exception();
 					}
 					else
 					{
-						UINT32 data = readhalf( address );
-
-						if( m_berr )
-						{
-							load_bus_error_exception();
-						}
-						else
-						{
-							delayed_load( INS_RT( m_op ), data );
-						}
+						delayed_load( INS_RT( m_op ), data );
 					}
 				}
-				break;
+			}
+			break;
+
+		case OP_LHU:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = load_data_address_breakpoint( address );
 
-			case OP_LWR:
+				if( ( address & m_bad_half_address_mask ) != 0 )
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = load_data_address_breakpoint( address );
+					load_bad_address( address );
+				}
+				else if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else
+				{
+					UINT32 data = readhalf( address );
 
-					if( ( address & m_bad_byte_address_mask ) != 0 )
-					{
-						load_bad_address( address );
-					}
-					else if( breakpoint )
+					if( m_berr )
 					{
-						breakpoint_exception();
+						load_bus_error_exception();
 					}
 					else
 					{
-						UINT32 data = get_register_from_pipeline( INS_RT( m_op ) );
+						delayed_load( INS_RT( m_op ), data );
+					}
+				}
+			}
+			break;
 
-						switch( address & 3 )
-						{
-						case 0:
-							data = readword( address );
-							break;
+		case OP_LWR:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = load_data_address_breakpoint( address );
 
-						case 1:
-							data = ( data & 0xff000000 ) | ( readword_masked( address, 0xffffff00 ) >> 8 );
-							break;
+				if( ( address & m_bad_byte_address_mask ) != 0 )
+				{
+					load_bad_address( address );
+				}
+				else if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else
+				{
+					UINT32 data = get_register_from_pipeline( INS_RT( m_op ) );
 
-						case 2:
-							data = ( data & 0xffff0000 ) | ( readword_masked( address, 0xffff0000 ) >> 16 );
-							break;
+					switch( address & 3 )
+					{
+					case 0:
+						data = readword( address );
+						break;
 
-						case 3:
-							data = ( data & 0xffffff00 ) | ( readword_masked( address, 0xff000000 ) >> 24 );
-							break;
-						}
+					case 1:
+						data = ( data & 0xff000000 ) | ( readword_masked( address, 0xffffff00 ) >> 8 );
+						break;
 
-						if( m_berr )
-						{
-							load_bus_error_exception();
-						}
-						else
-						{
-							delayed_load( INS_RT( m_op ), data );
-						}
-					}
-				}
-				break;
+					case 2:
+						data = ( data & 0xffff0000 ) | ( readword_masked( address, 0xffff0000 ) >> 16 );
+						break;
 
-			case OP_SB:
-				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = store_data_address_breakpoint( address );
+					case 3:
+						data = ( data & 0xffffff00 ) | ( readword_masked( address, 0xff000000 ) >> 24 );
+						break;
+					}
 
-					if( ( address & m_bad_byte_address_mask ) != 0 )
+					if( m_berr )
 					{
-						store_bad_address( address );
+						load_bus_error_exception();
 					}
 					else
 					{
-						int shift = 8 * ( address & 3 );
-						writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xff << shift );
-
-						if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else if( m_berr )
-						{
-							store_bus_error_exception();
-						}
-						else
-						{
-							advance_pc();
-						}
+						delayed_load( INS_RT( m_op ), data );
 					}
 				}
-				break;
+			}
+			break;
 
-			case OP_SH:
+		case OP_SB:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = store_data_address_breakpoint( address );
+
+				if( ( address & m_bad_byte_address_mask ) != 0 )
+				{
+					store_bad_address( address );
+				}
+				else
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = store_data_address_breakpoint( address );
+					int shift = 8 * ( address & 3 );
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xff << shift );
 
-					if( ( address & m_bad_half_address_mask ) != 0 )
+					if( breakpoint )
+					{
+						breakpoint_exception();
+					}
+					else if( m_berr )
 					{
-						store_bad_address( address );
+						store_bus_error_exception();
 					}
 					else
 					{
-						int shift = 8 * ( address & 2 );
-						writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xffff << shift );
-
-						if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else if( m_berr )
-						{
-							store_bus_error_exception();
-						}
-						else
-						{
-							advance_pc();
-						}
+						advance_pc();
 					}
 				}
-				break;
+			}
+			break;
 
-			case OP_SWL:
-				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int save_type = address & 3;
-					int breakpoint;
+		case OP_SH:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = store_data_address_breakpoint( address );
 
-					address &= ~3;
-					breakpoint = store_data_address_breakpoint( address );
+				if( ( address & m_bad_half_address_mask ) != 0 )
+				{
+					store_bad_address( address );
+				}
+				else
+				{
+					int shift = 8 * ( address & 2 );
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xffff << shift );
 
-					if( ( address & m_bad_byte_address_mask ) != 0 )
+					if( breakpoint )
+					{
+						breakpoint_exception();
+					}
+					else if( m_berr )
 					{
-						store_bad_address( address );
+						store_bus_error_exception();
 					}
 					else
 					{
-						switch( save_type )
-						{
-						case 0:
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 24, 0x000000ff );
-							break;
-
-						case 1:
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 16, 0x0000ffff );
-							break;
+						advance_pc();
+					}
+				}
+			}
+			break;
 
-						case 2:
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 8, 0x00ffffff );
-							break;
+		case OP_SWL:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int save_type = address & 3;
+				int breakpoint;
 
-						case 3:
-							writeword( address, m_r[ INS_RT( m_op ) ] );
-							break;
-						}
+				address &= ~3;
+				breakpoint = store_data_address_breakpoint( address );
 
-						if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else if( m_berr )
-						{
-							store_bus_error_exception();
-						}
-						else
-						{
-							advance_pc();
-						}
-					}
+				if( ( address & m_bad_byte_address_mask ) != 0 )
+				{
+					store_bad_address( address );
 				}
-				break;
-
-			case OP_SW:
+				else
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = store_data_address_breakpoint( address );
+					switch( save_type )
+					{
+					case 0:
+						writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 24, 0x000000ff );
+						break;
+
+					case 1:
+						writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 16, 0x0000ffff );
+						break;
 
-					if( ( address & m_bad_word_address_mask ) != 0 )
+					case 2:
+						writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 8, 0x00ffffff );
+						break;
+
+					case 3:
+						writeword( address, m_r[ INS_RT( m_op ) ] );
+						break;
+					}
+
+					if( breakpoint )
 					{
-						store_bad_address( address );
+						breakpoint_exception();
+					}
+					else if( m_berr )
+					{
+						store_bus_error_exception();
 					}
 					else
 					{
-						writeword( address, m_r[ INS_RT( m_op ) ] );
-
-						if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else if( m_berr )
-						{
-							store_bus_error_exception();
-						}
-						else
-						{
-							advance_pc();
-						}
+						advance_pc();
 					}
 				}
-				break;
+			}
+			break;
+
+		case OP_SW:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = store_data_address_breakpoint( address );
 
-			case OP_SWR:
+				if( ( address & m_bad_word_address_mask ) != 0 )
+				{
+					store_bad_address( address );
+				}
+				else
 				{
-					UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-					int breakpoint = store_data_address_breakpoint( address );
+					writeword( address, m_r[ INS_RT( m_op ) ] );
 
-					if( ( address & m_bad_byte_address_mask ) != 0 )
+					if( breakpoint )
 					{
-						store_bad_address( address );
+						breakpoint_exception();
+					}
+					else if( m_berr )
+					{
+						store_bus_error_exception();
 					}
 					else
 					{
-						switch( address & 3 )
-						{
-						case 0:
-							writeword( address, m_r[ INS_RT( m_op ) ] );
-							break;
+						advance_pc();
+					}
+				}
+			}
+			break;
 
-						case 1:
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] << 8, 0xffffff00 );
-							break;
+		case OP_SWR:
+			{
+				UINT32 address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+				int breakpoint = store_data_address_breakpoint( address );
 
-						case 2:
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] << 16, 0xffff0000 );
-							break;
+				if( ( address & m_bad_byte_address_mask ) != 0 )
+				{
+					store_bad_address( address );
+				}
+				else
+				{
+					switch( address & 3 )
+					{
+					case 0:
+						writeword( address, m_r[ INS_RT( m_op ) ] );
+						break;
 
-						case 3:
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] << 24, 0xff000000 );
-							break;
-						}
+					case 1:
+						writeword_masked( address, m_r[ INS_RT( m_op ) ] << 8, 0xffffff00 );
+						break;
 
-						if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else if( m_berr )
-						{
-							store_bus_error_exception();
-						}
-						else
-						{
-							advance_pc();
-						}
+					case 2:
+						writeword_masked( address, m_r[ INS_RT( m_op ) ] << 16, 0xffff0000 );
+						break;
+
+					case 3:
+						writeword_masked( address, m_r[ INS_RT( m_op ) ] << 24, 0xff000000 );
+						break;
+					}
+
+					if( breakpoint )
+					{
+						breakpoint_exception();
+					}
+					else if( m_berr )
+					{
+						store_bus_error_exception();
+					}
+					else
+					{
+						advance_pc();
 					}
 				}
-				break;
+			}
+			break;
 
-			case OP_LWC0:
-				lwc( 0, SR_CU0 );
-				break;
+		case OP_LWC0:
+			lwc( 0, SR_CU0 );
+			break;
 
-			case OP_LWC1:
-				lwc( 1, SR_CU1 );
-				break;
+		case OP_LWC1:
+			lwc( 1, SR_CU1 );
+			break;
 
-			case OP_LWC2:
-				lwc( 2, SR_CU2 );
-				break;
+		case OP_LWC2:
+			lwc( 2, SR_CU2 );
+			break;
 
-			case OP_LWC3:
-				lwc( 3, SR_CU3 );
-				break;
+		case OP_LWC3:
+			lwc( 3, SR_CU3 );
+			break;
 
-			case OP_SWC0:
-				swc( 0, SR_CU0 );
-				break;
+		case OP_SWC0:
+			swc( 0, SR_CU0 );
+			break;
 
-			case OP_SWC1:
-				swc( 1, SR_CU1 );
-				break;
+		case OP_SWC1:
+			swc( 1, SR_CU1 );
+			break;
 
-			case OP_SWC2:
-				swc( 2, SR_CU2 );
-				break;
+		case OP_SWC2:
+			swc( 2, SR_CU2 );
+			break;
 
-			case OP_SWC3:
-				swc( 3, SR_CU3 );
-				break;
+		case OP_SWC3:
+			swc( 3, SR_CU3 );
+			break;
 
-			default:
-				logerror( "%08x: unknown opcode %08x\n", m_pc, m_op );
-				stop();
-				exception( EXC_RI );
-				break;
-			}
+		default:
+			logerror( "%08x: unknown opcode %08x\n", m_pc, m_op );
+			stop();
+			exception( EXC_RI );
+			break;
 		}
-
-		m_icount--;
-	} while( m_icount > 0 );
+	}
 }
 
 UINT32 psxcpu_device::getcp1dr( int reg )
@@ -37,6 +37,11 @@
 #define PSXCPU_IRQ4 ( 4 )
 #define PSXCPU_IRQ5 ( 5 )
 
+// recompiler classes, only needed by psxdrc.c
+
+class psxcpu_frontend;
+class psxcpu_recompiler;
+
 // register enumeration
 
 enum
@@ -197,12 +202,18 @@ public:
 
 	static psxcpu_device *getcpu( device_t &device, const char *cputag );
 
+	void func_execute_one();
+
 protected:
+	friend class psxcpu_frontend;
+	friend class psxcpu_recompiler;
+
 	psxcpu_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source);
 
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 	virtual void device_post_load();
 	virtual machine_config_constructor device_mconfig_additions() const;
 
@@ -269,6 +280,12 @@ protected:
 	UINT32 m_ram_config;
 	UINT32 m_rom_config;
 
+	// recompiler state, allocated on first use when -drc_psx is set
+	bool m_drcenabled;
+	psxcpu_recompiler *m_drc;
+	UINT32 m_drcnextpc;
+	UINT32 m_drcscratchpad; // nonzero while loads and stores reach the scratchpad RAM
+
 	void stop();
 	UINT32 cache_readword( UINT32 offset );
 	void cache_writeword( UINT32 offset, UINT32 data );
@@ -297,6 +314,7 @@ protected:
 	int execute_unstoppable_instructions( int executeCop2 );
 	void update_address_masks();
 	void update_scratchpad();
+	void update_drc_scratchpad();
 	void update_ram_config();
 	void update_rom_config();
 	void update_cop0( int reg );
@@ -321,6 +339,14 @@ protected:
 	int load_data_address_breakpoint( UINT32 address );
 	int store_data_address_breakpoint( UINT32 address );
 
+	void execute_op();
+
+	// recompiler (psxdrc.c)
+	void execute_run_drc();
+	void drc_exit();
+	void drc_set_dirty();
+	bool drc_code_is_static( offs_t address );
+
 	UINT32 get_register_from_pipeline( int reg );
 	int cop0_usable();
 	void lwc( int cop, int sr_cu );
@@ -0,0 +1,551 @@
+// license:MAME
+// copyright-holders:smf
+/*
+ * PlayStation CPU recompiler
+ *
+ * Universal machine language-based, call-threaded: the front end walks
+ * the code once and each instruction is compiled into a store of its
+ * opcode and a call into execute_op(), so load delays, the multiplier
+ * and the GTE behave exactly as they do in the interpreter. What goes
+ * away is the fetch and the loop around it; static branches within a
+ * block jump straight to their target and everything else redispatches
+ * through the hash table.
+ *
+ * Loads and stores outside a delay slot first try the scratchpad: while
+ * it is mapped as RAM, aligned accesses to it read and write the data
+ * cache array directly and do the load delay in UML, and only the rest
+ * go through the memory system.
+ *
+ * Code almost always runs from RAM that DMA can rewrite behind the
+ * memory system's back, so sequences in RAM are checksummed each time
+ * they are entered. Anything unusual -- exceptions, interrupts, code in
+ * a bus error region -- leaves the block and is handled by the
+ * dispatcher or by interpreting a few instructions.
+ *
+ */
+
+#include "emu.h"
+#include "debugger.h"
+#include "psx.h"
+#include "cpu/drcthread.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// size of the execution code cache
+#define CACHE_SIZE ( 16 * 1024 * 1024 )
+
+// compilation boundaries -- how far back/forward does the analysis extend?
+#define COMPILE_BACKWARDS_BYTES ( 128 )
+#define COMPILE_FORWARDS_BYTES ( 512 )
+#define COMPILE_MAX_SEQUENCE ( 64 )
+
+// instructions interpreted each time code can't be compiled
+#define INTERPRET_INSTRUCTIONS ( 64 )
+
+
+//**************************************************************************
+//  FRONT END
+//**************************************************************************
+
+class psxcpu_frontend : public drc_frontend
+{
+public:
+	psxcpu_frontend( psxcpu_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence );
+
+protected:
+	virtual bool describe( opcode_desc &desc, const opcode_desc *prev );
+
+private:
+	void describe_branch( opcode_desc &desc, UINT32 flags, offs_t targetpc );
+
+	psxcpu_device *m_psx;
+};
+
+psxcpu_frontend::psxcpu_frontend( psxcpu_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence ) :
+	drc_frontend( *device, window_start, window_end, max_sequence ),
+	m_psx( device )
+{
+}
+
+//-------------------------------------------------
+//  delayed_branch - return the branch flags of
+//  an opcode, or 0 if it doesn't branch; every
+//  branch has a delay slot
+//-------------------------------------------------
+
+static UINT32 delayed_branch( UINT32 op, offs_t pc, offs_t &targetpc )
+{
+	targetpc = BRANCH_TARGET_DYNAMIC;
+
+	switch( INS_OP( op ) )
+	{
+	case OP_SPECIAL:
+		if( INS_FUNCT( op ) == FUNCT_JR || INS_FUNCT( op ) == FUNCT_JALR )
+		{
+			return OPFLAG_IS_UNCONDITIONAL_BRANCH;
+		}
+		break;
+
+	case OP_J:
+	case OP_JAL:
+		targetpc = ( ( pc + 4 ) & 0xf0000000 ) + ( INS_TARGET( op ) << 2 );
+		return OPFLAG_IS_UNCONDITIONAL_BRANCH;
+
+	case OP_REGIMM:
+	case OP_BEQ:
+	case OP_BNE:
+	case OP_BLEZ:
+	case OP_BGTZ:
+		targetpc = pc + 4 + ( PSXCPU_WORD_EXTEND( INS_IMMEDIATE( op ) ) << 2 );
+		return OPFLAG_IS_CONDITIONAL_BRANCH;
+
+	case OP_COP0:
+	case OP_COP1:
+	case OP_COP2:
+	case OP_COP3:
+		if( INS_RS( op ) == RS_BC || INS_RS( op ) == RS_BC_ALT )
+		{
+			targetpc = pc + 4 + ( PSXCPU_WORD_EXTEND( INS_IMMEDIATE( op ) ) << 2 );
+			return OPFLAG_IS_CONDITIONAL_BRANCH;
+		}
+		break;
+	}
+
+	return 0;
+}
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool psxcpu_frontend::describe( opcode_desc &desc, const opcode_desc *prev )
+{
+	desc.length = 4;
+
+	// code in bus error regions or switchable banks is left to the interpreter
+	if( ( desc.pc & 3 ) != 0 || !m_psx->drc_code_is_static( desc.physpc ) )
+	{
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return false;
+	}
+
+	UINT32 op = m_psx->m_direct->read_decrypted_dword( desc.physpc );
+	desc.opptr.l[ 0 ] = op;
+	desc.cycles = 1;
+
+	// control only moves after the delay slot, so the slot carries the branch
+	if( prev != NULL && prev->pc == desc.pc - 4 && ( prev->flags & ( OPFLAG_INVALID_OPCODE | OPFLAG_IN_DELAY_SLOT ) ) == 0 )
+	{
+		offs_t targetpc;
+		UINT32 flags = delayed_branch( prev->opptr.l[ 0 ], prev->pc, targetpc );
+		if( flags != 0 )
+		{
+			desc.flags |= OPFLAG_IN_DELAY_SLOT;
+			describe_branch( desc, flags, targetpc );
+			return true;
+		}
+	}
+
+	switch( INS_OP( op ) )
+	{
+	case OP_SPECIAL:
+		if( INS_FUNCT( op ) == FUNCT_SYSCALL || INS_FUNCT( op ) == FUNCT_BREAK )
+		{
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+		}
+		break;
+
+	case OP_COP0:
+		// MTC0/CTC0 and RFE can unmask interrupts or change the address masks
+		if( INS_RS( op ) == RS_MTC || INS_RS( op ) == RS_CTC || INS_CO( op ) )
+		{
+			desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+		}
+		break;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------
+//  describe_branch - mark an instruction as a
+//  branch, keeping the target only if it can
+//  hold code
+//-------------------------------------------------
+
+void psxcpu_frontend::describe_branch( opcode_desc &desc, UINT32 flags, offs_t targetpc )
+{
+	desc.flags |= flags;
+	if( flags == OPFLAG_IS_UNCONDITIONAL_BRANCH )
+	{
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	}
+	if( targetpc != BRANCH_TARGET_DYNAMIC && ( targetpc & 3 ) == 0 )
+	{
+		desc.targetpc = targetpc;
+	}
+}
+
+
+//**************************************************************************
+//  RECOMPILER
+//**************************************************************************
+
+class psxcpu_recompiler : public drc_threaded_compiler
+{
+public:
+	psxcpu_recompiler( psxcpu_device &psx );
+
+protected:
+	virtual bool compile_current();
+	virtual void interpret();
+	virtual void generate_dispatch( drcuml_block *block );
+	virtual void generate_sequence_check( drcuml_block *block, const opcode_desc *seqhead, const opcode_desc *seqlast );
+	virtual void generate_call( drcuml_block *block, const opcode_desc *desc );
+
+private:
+	void generate_scratchpad_access( drcuml_block *block, const opcode_desc *desc, code_label slow );
+
+	psxcpu_device &m_psx;
+	psxcpu_frontend m_frontend;
+};
+
+psxcpu_recompiler::psxcpu_recompiler( psxcpu_device &psx ) :
+	drc_threaded_compiler( psx, CACHE_SIZE, 1, 2, psx.m_drcnextpc ),
+	m_psx( psx ),
+	m_frontend( &psx, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE )
+{
+	m_drcuml.symbol_add( &psx.m_pc, sizeof( psx.m_pc ), "pc" );
+	m_drcuml.symbol_add( &psx.m_op, sizeof( psx.m_op ), "op" );
+	m_drcuml.symbol_add( &psx.m_icount, sizeof( psx.m_icount ), "icount" );
+	m_drcuml.symbol_add( &psx.m_delayr, sizeof( psx.m_delayr ), "delayr" );
+	m_drcuml.symbol_add( &psx.m_delayv, sizeof( psx.m_delayv ), "delayv" );
+}
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  cfunc_execute_one - C callback to run one
+//  compiled instruction
+//-------------------------------------------------
+
+static void cfunc_execute_one( void *param )
+{
+	( (psxcpu_device *)param )->func_execute_one();
+}
+
+//-------------------------------------------------
+//  scratchpad_access_size - return the size of
+//  a load or store the scratchpad fast path can
+//  do, or 0 if it can't
+//-------------------------------------------------
+
+static int scratchpad_access_size( UINT32 op )
+{
+	switch( INS_OP( op ) )
+	{
+	case OP_LB:
+	case OP_LBU:
+	case OP_SB:
+		return 1;
+
+	case OP_LH:
+	case OP_LHU:
+	case OP_SH:
+		return 2;
+
+	case OP_LW:
+	case OP_SW:
+		return 4;
+	}
+
+	return 0;
+}
+
+
+//**************************************************************************
+//  CORE EXECUTION
+//**************************************************************************
+
+//-------------------------------------------------
+//  execute_run_drc - run compiled code until the
+//  timeslice is used up
+//-------------------------------------------------
+
+void psxcpu_device::execute_run_drc()
+{
+	if( m_drc == NULL )
+	{
+		m_drc = auto_alloc( machine(), psxcpu_recompiler( *this ) );
+	}
+
+	m_drc->execute();
+}
+
+//-------------------------------------------------
+//  drc_exit - free the recompiler
+//-------------------------------------------------
+
+void psxcpu_device::drc_exit()
+{
+	if( m_drc != NULL )
+	{
+		auto_free( machine(), m_drc );
+	}
+	m_drc = NULL;
+}
+
+//-------------------------------------------------
+//  drc_set_dirty - throw away compiled code
+//  before the next run, because the memory map
+//  under it moved
+//-------------------------------------------------
+
+void psxcpu_device::drc_set_dirty()
+{
+	if( m_drc != NULL )
+	{
+		m_drc->set_dirty();
+	}
+}
+
+//-------------------------------------------------
+//  drc_code_is_static - return true if the given
+//  address holds code that no bank can switch
+//  out; RAM counts, and is checksummed
+//-------------------------------------------------
+
+bool psxcpu_device::drc_code_is_static( offs_t address )
+{
+	if( m_program->get_read_ptr( address ) == NULL )
+	{
+		return false;
+	}
+
+	// named banks can be switched at any time; anonymous ones are plain memory
+	for( memory_bank *bank = machine().memory().first_bank(); bank != NULL; bank = bank->next() )
+	{
+		if( !bank->anonymous() && bank->fully_covers( address, address ) && bank->references_space( *m_program, ROW_READ ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//-------------------------------------------------
+//  compile_current - compile the code at the
+//  current PC, if the front end can see it
+//-------------------------------------------------
+
+bool psxcpu_recompiler::compile_current()
+{
+	if( ( m_psx.m_pc & 3 ) != 0 || !m_psx.drc_code_is_static( m_psx.m_pc ) )
+	{
+		return false;
+	}
+
+	compile_block( m_frontend.describe_code( m_psx.m_pc ), 0 );
+	return true;
+}
+
+//-------------------------------------------------
+//  interpret - interpret a few instructions from
+//  the current PC
+//-------------------------------------------------
+
+void psxcpu_recompiler::interpret()
+{
+	for( int count = 0; count < INTERPRET_INSTRUCTIONS && m_psx.m_icount > 0; count++ )
+	{
+		m_psx.m_op = m_psx.m_direct->read_decrypted_dword( m_psx.m_pc );
+		m_psx.func_execute_one();
+	}
+}
+
+
+//**************************************************************************
+//  CODE GENERATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  generate_dispatch - generate the checks made
+//  before every hash lookup
+//-------------------------------------------------
+
+void psxcpu_recompiler::generate_dispatch( drcuml_block *block )
+{
+	// leave when out of cycles
+	UML_CMP( block, mem( &m_psx.m_icount ), 0 );                                            // cmp     [icount],0
+	UML_EXITc( block, COND_LE, EXECUTE_OUT_OF_CYCLES );                                     // exit    EXECUTE_OUT_OF_CYCLES,le
+
+	// recompile everything if the memory map moved
+	UML_LOAD( block, I0, &m_dirty, 0, SIZE_BYTE, SCALE_x1 );                                // load    i0,&dirty,0,byte
+	UML_TEST( block, I0, 0xff );                                                            // test    i0,0xff
+	UML_EXITc( block, COND_NZ, EXECUTE_MISSING_CODE );                                      // exit    EXECUTE_MISSING_CODE,nz
+
+	// misaligned PCs take their address error in the interpreter
+	UML_TEST( block, mem( &m_psx.m_pc ), 3 );                                               // test    [pc],3
+	UML_EXITc( block, COND_NZ, EXECUTE_INTERPRET );                                         // exit    EXECUTE_INTERPRET,nz
+
+	// generate a hash jump via the current PC
+	UML_HASHJMP( block, 0, mem( &m_psx.m_pc ), *m_nocode );                                 // hashjmp 0,[pc],nocode
+}
+
+//-------------------------------------------------
+//  generate_sequence_check - generate code to
+//  validate a sequence of opcodes in RAM
+//-------------------------------------------------
+
+void psxcpu_recompiler::generate_sequence_check( drcuml_block *block, const opcode_desc *seqhead, const opcode_desc *seqlast )
+{
+	UINT32 sum = 0;
+
+	if( m_psx.m_program->get_write_ptr( seqhead->physpc ) == NULL )
+	{
+		return;
+	}
+
+	if( m_drcuml.logging() )
+	{
+		block->append_comment( "[Validation for %08X]", seqhead->pc );                     // comment
+	}
+
+	UML_MOV( block, I0, 0 );                                                                // mov     i0,0
+	for( const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next() )
+	{
+		if( !( curdesc->flags & OPFLAG_INVALID_OPCODE ) )
+		{
+			void *base = m_psx.m_direct->read_decrypted_ptr( curdesc->physpc );
+			UML_LOAD( block, I1, base, 0, SIZE_DWORD, SCALE_x4 );                               // load    i1,base,0,dword
+			UML_ADD( block, I0, I0, I1 );                                                       // add     i0,i0,i1
+			sum += curdesc->opptr.l[ 0 ];
+		}
+	}
+	UML_CMP( block, I0, sum );                                                              // cmp     i0,sum
+	UML_EXHc( block, COND_NE, *m_nocode, seqhead->pc );                                     // exh     nocode,seqhead->pc,ne
+}
+
+//-------------------------------------------------
+//  generate_call - generate the code to run one
+//  instruction
+//-------------------------------------------------
+
+void psxcpu_recompiler::generate_call( drcuml_block *block, const opcode_desc *desc )
+{
+	UINT32 op = desc->opptr.l[ 0 ];
+	bool scratchpad = ( scratchpad_access_size( op ) != 0 && !( desc->flags & OPFLAG_IN_DELAY_SLOT ) );
+	code_label done;
+
+	// add an entry for the log
+	if( m_drcuml.logging() )
+	{
+		block->append_comment( "%08X: %08X", desc->pc, op );                               // comment
+	}
+
+	// loads and stores outside a delay slot try the scratchpad first
+	if( scratchpad )
+	{
+		code_label slow = alloc_label();
+		done = alloc_label();
+
+		generate_scratchpad_access( block, desc, slow );
+		UML_JMP( block, done );                                                             // jmp     done
+		UML_LABEL( block, slow );                                                           // slow:
+	}
+
+	// run the handler
+	UML_MOV( block, mem( &m_psx.m_op ), op );                                               // mov     [op],opcode
+	UML_CALLC( block, cfunc_execute_one, &m_psx );                                          // callc   execute_one,psx
+
+	if( scratchpad )
+	{
+		UML_LABEL( block, done );                                                           // done:
+	}
+}
+
+//-------------------------------------------------
+//  generate_scratchpad_access - generate a load
+//  or store that reads or writes the scratchpad
+//  directly, jumping to slow for any other
+//  address; finishes the instruction the way
+//  func_execute_one does
+//-------------------------------------------------
+
+void psxcpu_recompiler::generate_scratchpad_access( drcuml_block *block, const opcode_desc *desc, code_label slow )
+{
+	UINT32 op = desc->opptr.l[ 0 ];
+	int bytes = scratchpad_access_size( op );
+	operand_size size = ( bytes == 1 ) ? SIZE_BYTE : ( bytes == 2 ) ? SIZE_WORD : SIZE_DWORD;
+	UINT32 endianxor = ( bytes == 1 ) ? BYTE4_XOR_LE( 0 ) : ( bytes == 2 ) ? WORD_XOR_LE( 0 ) : 0;
+	bool store = ( INS_OP( op ) == OP_SB || INS_OP( op ) == OP_SH || INS_OP( op ) == OP_SW );
+	int rt = INS_RT( op );
+
+	// only while the scratchpad is RAM the CPU can see, with no branch pending
+	UML_CMP( block, mem( &m_psx.m_drcscratchpad ), 0 );                                     // cmp     [scratchpad],0
+	UML_JMPc( block, COND_E, slow );                                                        // jmp     slow,e
+	UML_CMP( block, mem( &m_psx.m_delayr ), PSXCPU_DELAYR_PC );                             // cmp     [delayr],PSXCPU_DELAYR_PC
+	UML_JMPc( block, COND_AE, slow );                                                       // jmp     slow,ae
+
+	// aligned accesses to it can't fault or hit a data breakpoint
+	UML_ADD( block, I0, mem( &m_psx.m_r[ INS_RS( op ) ] ), PSXCPU_WORD_EXTEND( INS_IMMEDIATE( op ) ) );
+																							// add     i0,[rs],simm
+	UML_AND( block, I1, I0, 0xfffffc00 | ( bytes - 1 ) );                                   // and     i1,i0,0xfffffc00 | (bytes - 1)
+	UML_CMP( block, I1, 0x1f800000 );                                                       // cmp     i1,0x1f800000
+	UML_JMPc( block, COND_NE, slow );                                                       // jmp     slow,ne
+	UML_AND( block, I0, I0, 0x3ff );                                                        // and     i0,i0,0x3ff
+	if( endianxor != 0 )
+	{
+		UML_XOR( block, I0, I0, endianxor );                                                // xor     i0,i0,endianxor
+	}
+
+	if( store )
+	{
+		UML_STORE( block, m_psx.m_dcache, I0, mem( &m_psx.m_r[ rt ] ), size, SCALE_x1 );    // store   dcache,i0,[rt],size
+	}
+	else
+	{
+		UML_LOAD( block, I2, m_psx.m_dcache, I0, size, SCALE_x1 );                          // load    i2,dcache,i0,size
+		if( INS_OP( op ) == OP_LB || INS_OP( op ) == OP_LH )
+		{
+			UML_SEXT( block, I2, I2, size );                                                // sext    i2,i2,size
+		}
+
+		// a load to the register with a load pending cancels the pending one
+		UML_CMP( block, mem( &m_psx.m_delayr ), rt );                                       // cmp     [delayr],rt
+		UML_MOVc( block, COND_E, mem( &m_psx.m_delayr ), 0 );                               // mov     [delayr],0,e
+	}
+
+	// commit the pending load; r0 takes it when none is pending, so zero it again
+	UML_MOV( block, I1, mem( &m_psx.m_delayr ) );                                           // mov     i1,[delayr]
+	UML_STORE( block, m_psx.m_r, I1, mem( &m_psx.m_delayv ), SIZE_DWORD, SCALE_x4 );        // store   r,i1,[delayv],dword
+	UML_MOV( block, mem( &m_psx.m_r[ 0 ] ), 0 );                                            // mov     [r0],0
+	UML_MOV( block, mem( &m_psx.m_pc ), desc->pc + 4 );                                     // mov     [pc],desc->pc + 4
+
+	// and start this one
+	if( store )
+	{
+		UML_MOV( block, mem( &m_psx.m_delayr ), 0 );                                        // mov     [delayr],0
+		UML_MOV( block, mem( &m_psx.m_delayv ), 0 );                                        // mov     [delayv],0
+	}
+	else
+	{
+		UML_MOV( block, mem( &m_psx.m_delayr ), rt );                                       // mov     [delayr],rt
+		UML_MOV( block, mem( &m_psx.m_delayv ), I2 );                                       // mov     [delayv],i2
+	}
+
+	// count the cycle and say where to go next
+	UML_SUB( block, mem( &m_psx.m_icount ), mem( &m_psx.m_icount ), 1 );                    // sub     [icount],[icount],1
+	UML_MOV( block, mem( &m_nextpc ), desc->pc + 4 );                                       // mov     [nextpc],desc->pc + 4
+	UML_CMP( block, mem( &m_psx.m_icount ), 0 );                                            // cmp     [icount],0
+	UML_MOVc( block, COND_LE, mem( &m_nextpc ), ~0 );                                       // mov     [nextpc],~0,le
+}
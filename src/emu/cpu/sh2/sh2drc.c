@@ -604,6 +604,9 @@ void sh2_device::code_flush_cache()
 		static_generate_memory_accessor(2, TRUE,  "write16", &m_write16);
 		static_generate_memory_accessor(4, FALSE, "read32", &m_read32);
 		static_generate_memory_accessor(4, TRUE,  "write32", &m_write32);
+
+		/* from here on, evict old blocks rather than flushing when the cache fills */
+		drcuml->lock_static_code();
 	}
 	catch (drcuml_block::abort_compilation &)
 	{
@@ -674,7 +677,7 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	desclist = m_drcfe->describe_code(pc, mode);
 	if (drcuml->logging() || drcuml->logging_native())
 		log_opcode_desc(drcuml, desclist, 0);
 
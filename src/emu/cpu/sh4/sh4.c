@@ -79,6 +79,8 @@ sh34_base_device::sh34_base_device(const machine_config &mconfig, device_type ty
 	, c_md7(0)
 	, c_md8(0)
 	, c_clock(0)
+	, m_drcenabled(false)
+	, m_drc(NULL)
 {
 }
 
@@ -3825,6 +3827,13 @@ void sh34_base_device::execute_run()
 		return;
 	}
 
+	/* the recompiler leaves the debugger to the interpreter */
+	if (m_drcenabled && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	do
 	{
 		if (m_delay)
@@ -3864,6 +3873,69 @@ void sh34_base_device::execute_run()
 	} while( m_sh4_icount > 0 );
 }
 
+/*-------------------------------------------------
+    func_execute_one - run the opcode in m_drcinsn
+    the way the loop in execute_run would, then
+    tell the compiled code where to fetch next
+-------------------------------------------------*/
+
+void sh34_base_device::func_execute_one()
+{
+	const UINT16 opcode = m_drcinsn;
+
+	if (m_delay)
+	{
+		debugger_instruction_hook(this, m_delay & AM);
+
+		m_delay = 0;
+		m_ppc = m_pc;
+	}
+	else
+	{
+		debugger_instruction_hook(this, m_pc & AM);
+
+		m_pc += 2;
+		m_ppc = m_pc;
+	}
+
+	execute_one(opcode);
+
+	if (m_test_irq && !m_delay)
+	{
+		sh4_check_pending_irq("mame_sh4_execute");
+	}
+
+	m_sh4_icount--;
+
+	/* the generated code compares this with the address it expects; ~0 never matches */
+	if (m_sh4_icount > 0)
+		m_drcnextpc = m_delay ? m_delay : m_pc;
+	else
+		m_drcnextpc = ~0;
+}
+
+
+/*-------------------------------------------------
+    func_check_irq - finish an instruction the
+    recompiler ran itself when an interrupt may
+    be pending; never called with a branch pending
+-------------------------------------------------*/
+
+void sh34_base_device::func_check_irq()
+{
+	if (m_test_irq && !m_delay)
+	{
+		sh4_check_pending_irq("mame_sh4_execute");
+	}
+
+	m_sh4_icount--;
+
+	if (m_sh4_icount > 0)
+		m_drcnextpc = m_pc;
+	else
+		m_drcnextpc = ~0;
+}
+
 void sh3be_device::execute_run()
 {
 	if (m_cpu_off)
@@ -3872,6 +3944,12 @@ void sh3be_device::execute_run()
 		return;
 	}
 
+	if (m_drcenabled && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	do
 	{
 		if (m_delay)
@@ -3922,6 +4000,12 @@ void sh4be_device::execute_run()
 		return;
 	}
 
+	if (m_drcenabled && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	do
 	{
 		if (m_delay)
@@ -3995,6 +4079,14 @@ void sh34_base_device::device_start()
 	m_irln = 15;
 	m_test_irq = 0;
 
+	/* the recompiler is allocated on first use; code is mostly in RAM, so verify all of it */
+	m_drcenabled = machine().options().drc() && machine().options().drc_sh4();
+	m_drcoptions = SH4DRC_STRICT_VERIFY;
+	m_drcopxor = (m_program->endianness() == ENDIANNESS_LITTLE) ? WORD2_XOR_LE(0) : WORD_XOR_LE(6);
+	m_fastram_select = 0;
+	m_pcfsel = 0;
+	memset(m_pcflushes, 0, sizeof(m_pcflushes));
+
 	save_item(NAME(m_pc));
 	save_item(NAME(m_r[15]));
 	save_item(NAME(m_sr));
@@ -4167,6 +4259,11 @@ void sh34_base_device::device_start()
 	m_icountptr = &m_sh4_icount;
 }
 
+void sh34_base_device::device_stop()
+{
+	drc_exit();
+}
+
 void sh34_base_device::state_import(const device_state_entry &entry)
 {
 #ifdef MSB_FIRST
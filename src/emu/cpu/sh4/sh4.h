@@ -133,6 +133,12 @@ struct sh4_ddt_dma
 
 typedef void (*sh4_ftcsr_callback)(UINT32);
 
+#define SH4_MAX_FASTRAM       4
+
+/* recompiler classes, only needed by sh4drc.c */
+class sh4_frontend;
+class sh4_recompiler;
+
 
 #define MCFG_SH4_MD0(_md0) \
 	sh34_base_device::set_md0(*device, _md0);
@@ -193,10 +199,21 @@ public:
 	int sh4_dma_data(struct sh4_device_dma *s);
 	void sh4_dma_ddt(struct sh4_ddt_dma *s);
 
+	void sh4drc_set_options(UINT32 options);
+	void sh4drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
+	void sh4drc_add_pcflush(offs_t address);
+
+	void func_execute_one();
+	void func_check_irq();
+
 protected:
+	friend class sh4_frontend;
+	friend class sh4_recompiler;
+
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 
 	// device_execute_interface overrides
 	virtual UINT32 execute_min_cycles() const { return 1; }
@@ -361,6 +378,35 @@ protected:
 
 	UINT64 m_debugger_temp;
 
+	/* recompiler state, allocated on first use when -drc_sh4 is set */
+	bool                m_drcenabled;       /* true if the recompiler may be used */
+	sh4_recompiler *    m_drc;              /* code cache, generator and front end */
+	UINT32              m_drcoptions;       /* configurable DRC options */
+	offs_t              m_drcopxor;         /* XOR applied to opcode fetches */
+	UINT32              m_drcinsn;          /* opcode for func_execute_one */
+	UINT32              m_drcnextpc;        /* next fetch address after the last compiled instruction, ~0 to leave the block */
+
+	/* fast RAM */
+	UINT32              m_fastram_select;
+	struct
+	{
+		offs_t              start;                      /* start of the RAM block */
+		offs_t              end;                        /* end of the RAM block */
+		UINT8               readonly;                   /* TRUE if read-only */
+		void *              base;                       /* base in memory where the RAM lives */
+	} m_fastram[SH4_MAX_FASTRAM];
+
+	/* PCs that must be current before a memory handler is called */
+	UINT32              m_pcfsel;
+	UINT32              m_pcflushes[16];
+
+	/* recompiler (sh4drc.c) */
+	void execute_run_drc();
+	void drc_exit();
+	void drc_set_dirty();
+	bool drc_code_is_static(offs_t address);
+	bool drc_code_is_writable(offs_t address);
+	void *drc_code_ptr(offs_t address);
 
 	void execute_one_0000(const UINT16 opcode);
 	void execute_one_4000(const UINT16 opcode);
@@ -773,7 +819,4 @@ extern const device_type SH4BE;
 #define SH4DRC_COMPATIBLE_OPTIONS   (SH4DRC_STRICT_VERIFY | SH4DRC_FLUSH_PC | SH4DRC_STRICT_PCREL)
 #define SH4DRC_FASTEST_OPTIONS  (0)
 
-void sh4drc_set_options(device_t *device, UINT32 options);
-void sh4drc_add_pcflush(device_t *device, offs_t address);
-
 #endif /* __SH4_H__ */
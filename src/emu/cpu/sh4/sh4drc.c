@@ -0,0 +1,1245 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4drc.c
+    Universal machine language-based SH-3/SH-4 recompiler.
+
+    The front end walks the code once, and the common integer, memory and
+    single-precision FPU/vector instructions are compiled to UML directly;
+    everything else is compiled into a store of its opcode and a call into
+    the interpreter's decoder for it. FPU instructions check PR (and SZ,
+    for FMOV) at run time and take the call when it is set, as do delay
+    slots, so double precision and pair moves behave exactly as they do
+    in sh4.c. Static branches within a block jump straight to their
+    target, and everything else redispatches through the hash table,
+    keyed by the address of the next fetch. That is the delay slot while
+    a delayed branch is pending, so blocks may be entered in the middle of
+    a branch; those are interpreted until the branch is done.
+
+    Loads and stores of RAM registered with sh4drc_add_fastram go straight
+    to memory; anything else goes through the address space. Naomi and
+    friends run from main RAM, so sequences in writable memory are
+    checksummed each time they are entered; with SH4DRC_STRICT_VERIFY (the
+    default) the whole sequence is summed, otherwise only its first opcode
+    is compared. Without SH4DRC_STRICT_PCREL, PC-relative loads from
+    read-only fast RAM are folded into constants.
+
+    Compiled instructions don't store PC and PPC; they are written before
+    each call into the interpreter and when leaving the block. Memory
+    handlers that need them (idle loop detection, mostly) must be named
+    with sh4drc_add_pcflush, or SH4DRC_FLUSH_PC set for all of them.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "cpu/drcthread.h"
+#include "cpu/drcumlsh.h"
+#include "sh4.h"
+#include "sh4comn.h"
+
+extern unsigned DasmSH4(char *buffer, unsigned pc, UINT16 opcode);
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                  (32 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES     128
+#define COMPILE_FORWARDS_BYTES      512
+#define COMPILE_MAX_SEQUENCE        64
+
+/* instructions interpreted each time code can't be compiled */
+#define INTERPRET_INSTRUCTIONS      64
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)                mem(&m_sh4.m_r[reg])
+#define FR32(reg)               mem(&m_sh4.m_fr[reg])
+#define XF32(reg)               mem(&m_sh4.m_xf[reg])
+
+
+/***************************************************************************
+    FRONT END
+***************************************************************************/
+
+class sh4_frontend : public drc_frontend
+{
+public:
+	sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	void describe_branch(opcode_desc &desc, UINT32 flags, offs_t targetpc);
+
+	sh34_base_device *m_sh4;
+};
+
+
+sh4_frontend::sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_sh4(device)
+{
+}
+
+
+/*-------------------------------------------------
+    delayed_branch - return the branch flags of
+    an opcode with a delay slot, or 0 for any
+    other opcode
+-------------------------------------------------*/
+
+static UINT32 delayed_branch(UINT16 opcode, offs_t pc, offs_t &targetpc)
+{
+	targetpc = BRANCH_TARGET_DYNAMIC;
+	switch (opcode >> 12)
+	{
+		/* BSRF, BRAF, RTS and RTE */
+		case 0x0:
+			if ((opcode & 0xff) == 0x03 || (opcode & 0xff) == 0x23 || (opcode & 0x3f) == 0x0b || (opcode & 0x3f) == 0x2b)
+				return OPFLAG_IS_UNCONDITIONAL_BRANCH;
+			break;
+
+		/* JSR and JMP */
+		case 0x4:
+			if ((opcode & 0x3f) == 0x0b || (opcode & 0x3f) == 0x2b)
+				return OPFLAG_IS_UNCONDITIONAL_BRANCH;
+			break;
+
+		/* BT/S and BF/S */
+		case 0x8:
+			if ((opcode & 0x0f00) == 0x0d00 || (opcode & 0x0f00) == 0x0f00)
+			{
+				targetpc = pc + 4 + (INT8)opcode * 2;
+				return OPFLAG_IS_CONDITIONAL_BRANCH;
+			}
+			break;
+
+		/* BRA and BSR */
+		case 0xa:
+		case 0xb:
+			targetpc = pc + 4 + (((INT32)(opcode & 0xfff) << 20) >> 20) * 2;
+			return OPFLAG_IS_UNCONDITIONAL_BRANCH;
+	}
+	return 0;
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool sh4_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	desc.physpc = desc.pc & AM;
+	desc.length = 2;
+
+	/* code the recompiler can't see directly is left to the interpreter */
+	if ((desc.pc & 1) != 0 || !m_sh4->drc_code_is_static(desc.physpc))
+	{
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return false;
+	}
+
+	UINT16 opcode = *(UINT16 *)m_sh4->drc_code_ptr(desc.physpc);
+	desc.opptr.w[0] = opcode;
+	desc.cycles = 1;
+
+	/* control only moves after the delay slot, so the slot carries the branch */
+	if (prev != NULL && prev->pc == desc.pc - 2 && !(prev->flags & (OPFLAG_INVALID_OPCODE | OPFLAG_IN_DELAY_SLOT)))
+	{
+		offs_t targetpc;
+		UINT32 flags = delayed_branch(prev->opptr.w[0], prev->pc, targetpc);
+		if (flags != 0)
+		{
+			desc.flags |= OPFLAG_IN_DELAY_SLOT;
+			describe_branch(desc, flags, targetpc);
+			return true;
+		}
+	}
+
+	/* BT and BF */
+	if ((opcode & 0xfd00) == 0x8900)
+		describe_branch(desc, OPFLAG_IS_CONDITIONAL_BRANCH, desc.pc + 4 + (INT8)opcode * 2);
+
+	/* TRAPA */
+	else if ((opcode & 0xff00) == 0xc300)
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+
+	/* SLEEP */
+	else if ((opcode & 0xf03f) == 0x001b)
+		desc.flags |= OPFLAG_END_SEQUENCE;
+
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_branch - mark an instruction as a
+    branch, keeping the target only if it can
+    hold code
+-------------------------------------------------*/
+
+void sh4_frontend::describe_branch(opcode_desc &desc, UINT32 flags, offs_t targetpc)
+{
+	desc.flags |= flags;
+	if (flags == OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	if (targetpc != BRANCH_TARGET_DYNAMIC && (targetpc & 1) == 0)
+		desc.targetpc = targetpc;
+}
+
+
+/***************************************************************************
+    RECOMPILER
+***************************************************************************/
+
+class sh4_recompiler : public drc_threaded_compiler
+{
+public:
+	sh4_recompiler(sh34_base_device &sh4);
+
+protected:
+	virtual bool compile_current();
+	virtual void interpret();
+	virtual void generate_dispatch(drcuml_block *block);
+	virtual void generate_sequence_check(drcuml_block *block, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	virtual void generate_invalid(drcuml_block *block, const opcode_desc *desc);
+	virtual void generate_call(drcuml_block *block, const opcode_desc *desc);
+
+private:
+	void generate_execute_one(drcuml_block *block, const opcode_desc *desc);
+	bool generate_native(drcuml_block *block, const opcode_desc *desc);
+	void generate_branch(drcuml_block *block, const opcode_desc *desc);
+	void generate_advance(drcuml_block *block, const opcode_desc *desc);
+	void generate_set_t(drcuml_block *block, condition_t cond);
+	code_label generate_fpu_check(drcuml_block *block, bool size);
+	void generate_fmac(drcuml_block *block, int n, int m);
+	void generate_fipr(drcuml_block *block, int n, int m);
+	void generate_ftrv(drcuml_block *block, int n);
+	void generate_read(drcuml_block *block, const opcode_desc *desc, operand_size size);
+	void generate_write(drcuml_block *block, const opcode_desc *desc, operand_size size);
+	void generate_flush_pc(drcuml_block *block, const opcode_desc *desc);
+	bool fold_pcrel(offs_t address, operand_size size, UINT32 &value);
+
+	sh34_base_device &  m_sh4;
+	sh4_frontend        m_frontend;
+	bool                m_fastdata;         /* true if fast RAM can be accessed with host loads and stores */
+};
+
+
+sh4_recompiler::sh4_recompiler(sh34_base_device &sh4)
+	: drc_threaded_compiler(sh4, CACHE_SIZE, 1, 1, sh4.m_drcnextpc)
+	, m_sh4(sh4)
+	, m_frontend(&sh4, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE)
+	, m_fastdata(sh4.m_program->endianness() == ENDIANNESS_NATIVE)
+{
+	m_drcuml.symbol_add(&sh4.m_pc, sizeof(sh4.m_pc), "pc");
+	m_drcuml.symbol_add(&sh4.m_ppc, sizeof(sh4.m_ppc), "ppc");
+	m_drcuml.symbol_add(&sh4.m_delay, sizeof(sh4.m_delay), "delay");
+	m_drcuml.symbol_add(&sh4.m_sr, sizeof(sh4.m_sr), "sr");
+	m_drcuml.symbol_add(&sh4.m_fpul, sizeof(sh4.m_fpul), "fpul");
+	m_drcuml.symbol_add(&sh4.m_sh4_icount, sizeof(sh4.m_sh4_icount), "icount");
+	m_drcuml.symbol_add(&sh4.m_drcinsn, sizeof(sh4.m_drcinsn), "insn");
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		m_drcuml.symbol_add(&sh4.m_r[regnum], sizeof(sh4.m_r[regnum]), buf);
+		sprintf(buf, "fr%d", regnum);
+		m_drcuml.symbol_add(&sh4.m_fr[regnum], sizeof(sh4.m_fr[regnum]), buf);
+	}
+}
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    cfunc_execute_one - C callback to run one
+    compiled instruction
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((sh34_base_device *)param)->func_execute_one();
+}
+
+
+/*-------------------------------------------------
+    cfunc_check_irq - C callback to take an
+    interrupt raised by a memory handler
+-------------------------------------------------*/
+
+static void cfunc_check_irq(void *param)
+{
+	((sh34_base_device *)param)->func_check_irq();
+}
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    execute_run_drc - run compiled code until the
+    timeslice is used up
+-------------------------------------------------*/
+
+void sh34_base_device::execute_run_drc()
+{
+	if (m_drc == NULL)
+		m_drc = auto_alloc(machine(), sh4_recompiler(*this));
+
+	m_drc->execute();
+}
+
+
+/*-------------------------------------------------
+    drc_exit - free the recompiler
+-------------------------------------------------*/
+
+void sh34_base_device::drc_exit()
+{
+	if (m_drc != NULL)
+		auto_free(machine(), m_drc);
+	m_drc = NULL;
+}
+
+
+/*-------------------------------------------------
+    drc_set_dirty - throw away compiled code
+    before the next run
+-------------------------------------------------*/
+
+void sh34_base_device::drc_set_dirty()
+{
+	if (m_drc != NULL)
+		m_drc->set_dirty();
+}
+
+
+/*-------------------------------------------------
+    drc_code_is_static - return true if the given
+    physical address holds code that no bank can
+    switch out
+-------------------------------------------------*/
+
+bool sh34_base_device::drc_code_is_static(offs_t address)
+{
+	for (UINT32 ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		if (address >= m_fastram[ramnum].start && address <= m_fastram[ramnum].end)
+			return true;
+
+	if (drc_code_ptr(address) == NULL)
+		return false;
+
+	/* named banks can be switched at any time; anonymous ones are plain memory */
+	for (memory_bank *bank = machine().memory().first_bank(); bank != NULL; bank = bank->next())
+		if (!bank->anonymous() && bank->fully_covers(address, address) && bank->references_space(*m_program, ROW_READ))
+			return false;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    drc_code_is_writable - return true if code at
+    the given physical address must be checked
+    before it is run
+-------------------------------------------------*/
+
+bool sh34_base_device::drc_code_is_writable(offs_t address)
+{
+	for (UINT32 ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		if (address >= m_fastram[ramnum].start && address <= m_fastram[ramnum].end)
+			return !m_fastram[ramnum].readonly;
+
+	return m_program->get_write_ptr(address) != NULL;
+}
+
+
+/*-------------------------------------------------
+    drc_code_ptr - return a pointer to the opcode
+    at the given physical address, or NULL
+-------------------------------------------------*/
+
+void *sh34_base_device::drc_code_ptr(offs_t address)
+{
+	for (UINT32 ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		if (address >= m_fastram[ramnum].start && address <= m_fastram[ramnum].end)
+			return (UINT8 *)m_fastram[ramnum].base + ((address - m_fastram[ramnum].start) ^ m_drcopxor);
+
+	return m_direct->read_decrypted_ptr(address, m_drcopxor);
+}
+
+
+/*-------------------------------------------------
+    compile_current - compile the code at the
+    next fetch address, if the front end can see
+    it
+-------------------------------------------------*/
+
+bool sh4_recompiler::compile_current()
+{
+	offs_t pc = m_sh4.m_delay ? m_sh4.m_delay : m_sh4.m_pc;
+	if (!m_sh4.drc_code_is_static(pc & AM))
+		return false;
+
+	compile_block(m_frontend.describe_code(pc), 0);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    interpret - interpret a few instructions from
+    the current PC
+-------------------------------------------------*/
+
+void sh4_recompiler::interpret()
+{
+	for (int count = 0; count < INTERPRET_INSTRUCTIONS && m_sh4.m_sh4_icount > 0; count++)
+	{
+		offs_t pc = m_sh4.m_delay ? m_sh4.m_delay : m_sh4.m_pc;
+		m_sh4.m_drcinsn = m_sh4.m_direct->read_decrypted_word(pc & AM, m_sh4.m_drcopxor);
+		m_sh4.func_execute_one();
+	}
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_dispatch - generate the checks made
+    before every hash lookup
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_dispatch(drcuml_block *block)
+{
+	/* leave when out of cycles */
+	UML_CMP(block, mem(&m_sh4.m_sh4_icount), 0);                                            // cmp     [icount],0
+	UML_EXITc(block, COND_LE, EXECUTE_OUT_OF_CYCLES);                                       // exit    EXECUTE_OUT_OF_CYCLES,le
+
+	/* the next fetch is from the delay slot if a branch is pending */
+	UML_MOV(block, I0, mem(&m_sh4.m_pc));                                                   // mov     i0,[pc]
+	UML_CMP(block, mem(&m_sh4.m_delay), 0);                                                 // cmp     [delay],0
+	UML_MOVc(block, COND_NE, I0, mem(&m_sh4.m_delay));                                      // mov     i0,[delay],ne
+
+	/* odd PCs are left to the interpreter */
+	UML_TEST(block, I0, 1);                                                                 // test    i0,1
+	UML_EXITc(block, COND_NZ, EXECUTE_INTERPRET);                                           // exit    EXECUTE_INTERPRET,nz
+
+	/* generate a hash jump via the fetch address */
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_check - generate code to
+    validate a sequence of opcodes in writable
+    memory
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_sequence_check(drcuml_block *block, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	/* compiled code assumes no branch is pending unless it saw the branch */
+	if (!(seqhead->flags & OPFLAG_IN_DELAY_SLOT))
+	{
+		UML_CMP(block, mem(&m_sh4.m_delay), 0);                                             // cmp     [delay],0
+		UML_EXITc(block, COND_NE, EXECUTE_INTERPRET);                                       // exit    EXECUTE_INTERPRET,ne
+	}
+
+	if (!m_sh4.drc_code_is_writable(seqhead->physpc))
+		return;
+
+	if (m_drcuml.logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                       // comment
+
+	/* loose verify: just compare the first opcode */
+	if (!(m_sh4.m_drcoptions & SH4DRC_STRICT_VERIFY))
+		seqlast = seqhead;
+
+	/* otherwise sum up every opcode in the sequence */
+	UINT32 sum = 0;
+	UML_MOV(block, I0, 0);                                                                  // mov     i0,0
+	for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+		if (!(curdesc->flags & OPFLAG_INVALID_OPCODE))
+		{
+			void *base = m_sh4.drc_code_ptr(curdesc->physpc);
+			UML_LOAD(block, I1, base, 0, SIZE_WORD, SCALE_x2);                                  // load    i1,base,0,word
+			UML_ADD(block, I0, I0, I1);                                                         // add     i0,i0,i1
+			sum += curdesc->opptr.w[0];
+		}
+	UML_CMP(block, I0, sum);                                                                // cmp     i0,sum
+
+	/* we may have fallen in from compiled code, which leaves PC behind */
+	if (!(seqhead->flags & OPFLAG_IN_DELAY_SLOT))
+		UML_MOVc(block, COND_NE, mem(&m_sh4.m_pc), seqhead->pc);                            // mov     [pc],seqhead->pc,ne
+	UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                                       // exh     nocode,seqhead->pc,ne
+}
+
+
+/*-------------------------------------------------
+    generate_invalid - generate code for an
+    instruction the front end couldn't see
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_invalid(drcuml_block *block, const opcode_desc *desc)
+{
+	/* the interpreter fetches from PC unless a branch moved it already */
+	UML_CMP(block, mem(&m_sh4.m_delay), 0);                                                 // cmp     [delay],0
+	UML_MOVc(block, COND_E, mem(&m_sh4.m_pc), desc->pc);                                    // mov     [pc],desc->pc,e
+	UML_EXIT(block, EXECUTE_INTERPRET);                                                     // exit    EXECUTE_INTERPRET
+}
+
+
+/*-------------------------------------------------
+    generate_call - generate the code for one
+    instruction
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_call(drcuml_block *block, const opcode_desc *desc)
+{
+	/* add a disassembly comment */
+	if (m_drcuml.logging())
+	{
+		char buffer[256];
+		DasmSH4(buffer, desc->pc, desc->opptr.w[0]);
+		block->append_comment("%08X: %s", desc->pc, buffer);                               // comment
+	}
+
+	/* delay slots are finished by the handler, which also takes the branch */
+	if ((desc->flags & OPFLAG_IN_DELAY_SLOT) || !generate_native(block, desc))
+		generate_execute_one(block, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_execute_one - generate a call to the
+    interpreter's handler for one instruction
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_execute_one(drcuml_block *block, const opcode_desc *desc)
+{
+	/* compiled code leaves PC behind; in a delay slot the branch has set it */
+	if (!(desc->flags & OPFLAG_IN_DELAY_SLOT))
+		UML_MOV(block, mem(&m_sh4.m_pc), desc->pc);                                         // mov     [pc],desc->pc
+
+	UML_MOV(block, mem(&m_sh4.m_drcinsn), desc->opptr.w[0]);                                // mov     [insn],opcode
+	UML_CALLC(block, cfunc_execute_one, &m_sh4);                                            // callc   execute_one,sh4
+}
+
+
+/*-------------------------------------------------
+    generate_native - generate UML for one of the
+    common instructions; returns false, having
+    generated nothing, for any other
+-------------------------------------------------*/
+
+bool sh4_recompiler::generate_native(drcuml_block *block, const opcode_desc *desc)
+{
+	const UINT16 opcode = desc->opptr.w[0];
+	code_label fpulabel = 0;
+	bool memory = false;
+	UINT32 value;
+
+	switch (opcode >> 12)
+	{
+		case 0x0:
+			if (opcode != 0x0009)                                   /* NOP */
+				return false;
+			break;
+
+		case 0x1:                                                   /* MOV.L Rm,@(disp,Rn) */
+			UML_ADD(block, I0, R32(Rn), (opcode & 15) * 4);                                 // add     i0,rn,disp*4
+			UML_MOV(block, I1, R32(Rm));                                                    // mov     i1,rm
+			generate_write(block, desc, SIZE_DWORD);
+			memory = true;
+			break;
+
+		case 0x2:
+			switch (opcode & 15)
+			{
+				case 0x0:                                           /* MOV.B Rm,@Rn */
+				case 0x1:                                           /* MOV.W Rm,@Rn */
+				case 0x2:                                           /* MOV.L Rm,@Rn */
+					UML_MOV(block, I0, R32(Rn));                                            // mov     i0,rn
+					UML_MOV(block, I1, R32(Rm));                                            // mov     i1,rm
+					generate_write(block, desc, (opcode & 15) == 0 ? SIZE_BYTE : (opcode & 15) == 1 ? SIZE_WORD : SIZE_DWORD);
+					memory = true;
+					break;
+
+				case 0x6:                                           /* MOV.L Rm,@-Rn */
+					UML_MOV(block, I1, R32(Rm));                                            // mov     i1,rm
+					UML_SUB(block, R32(Rn), R32(Rn), 4);                                    // sub     rn,rn,4
+					UML_MOV(block, I0, R32(Rn));                                            // mov     i0,rn
+					generate_write(block, desc, SIZE_DWORD);
+					memory = true;
+					break;
+
+				case 0x8:                                           /* TST Rm,Rn */
+					UML_TEST(block, R32(Rn), R32(Rm));                                      // test    rn,rm
+					generate_set_t(block, COND_Z);
+					break;
+
+				case 0x9:   UML_AND(block, R32(Rn), R32(Rn), R32(Rm));  break;              /* AND Rm,Rn */
+				case 0xa:   UML_XOR(block, R32(Rn), R32(Rn), R32(Rm));  break;              /* XOR Rm,Rn */
+				case 0xb:   UML_OR(block, R32(Rn), R32(Rn), R32(Rm));   break;              /* OR Rm,Rn */
+
+				default:
+					return false;
+			}
+			break;
+
+		case 0x3:
+			switch (opcode & 15)
+			{
+				case 0x0:                                           /* CMP/EQ Rm,Rn */
+				case 0x2:                                           /* CMP/HS Rm,Rn */
+				case 0x3:                                           /* CMP/GE Rm,Rn */
+				case 0x6:                                           /* CMP/HI Rm,Rn */
+				case 0x7:                                           /* CMP/GT Rm,Rn */
+				{
+					static const condition_t conds[8] = { COND_E, COND_E, COND_AE, COND_GE, COND_E, COND_E, COND_A, COND_G };
+					UML_CMP(block, R32(Rn), R32(Rm));                                       // cmp     rn,rm
+					generate_set_t(block, conds[opcode & 7]);
+					break;
+				}
+
+				case 0x8:   UML_SUB(block, R32(Rn), R32(Rn), R32(Rm));  break;              /* SUB Rm,Rn */
+				case 0xc:   UML_ADD(block, R32(Rn), R32(Rn), R32(Rm));  break;              /* ADD Rm,Rn */
+
+				default:
+					return false;
+			}
+			break;
+
+		case 0x4:
+			switch (opcode & 0xff)
+			{
+				case 0x08:  UML_SHL(block, R32(Rn), R32(Rn), 2);    break;                  /* SHLL2 Rn */
+				case 0x18:  UML_SHL(block, R32(Rn), R32(Rn), 8);    break;                  /* SHLL8 Rn */
+				case 0x28:  UML_SHL(block, R32(Rn), R32(Rn), 16);   break;                  /* SHLL16 Rn */
+				case 0x09:  UML_SHR(block, R32(Rn), R32(Rn), 2);    break;                  /* SHLR2 Rn */
+				case 0x19:  UML_SHR(block, R32(Rn), R32(Rn), 8);    break;                  /* SHLR8 Rn */
+				case 0x29:  UML_SHR(block, R32(Rn), R32(Rn), 16);   break;                  /* SHLR16 Rn */
+
+				case 0x10:                                          /* DT Rn */
+					UML_SUB(block, R32(Rn), R32(Rn), 1);                                    // sub     rn,rn,1
+					generate_set_t(block, COND_Z);
+					break;
+
+				default:
+					return false;
+			}
+			break;
+
+		case 0x5:                                                   /* MOV.L @(disp,Rm),Rn */
+			UML_ADD(block, I0, R32(Rm), (opcode & 15) * 4);                                 // add     i0,rm,disp*4
+			generate_read(block, desc, SIZE_DWORD);
+			UML_MOV(block, R32(Rn), I1);                                                    // mov     rn,i1
+			memory = true;
+			break;
+
+		case 0x6:
+			switch (opcode & 15)
+			{
+				case 0x0:                                           /* MOV.B @Rm,Rn */
+				case 0x1:                                           /* MOV.W @Rm,Rn */
+				case 0x2:                                           /* MOV.L @Rm,Rn */
+				case 0x6:                                           /* MOV.L @Rm+,Rn */
+				{
+					operand_size size = (opcode & 15) == 0 ? SIZE_BYTE : (opcode & 15) == 1 ? SIZE_WORD : SIZE_DWORD;
+					UML_MOV(block, I0, R32(Rm));                                            // mov     i0,rm
+					generate_read(block, desc, size);
+					if (size != SIZE_DWORD)
+						UML_SEXT(block, I1, I1, size);                                      // sext    i1,i1,size
+					UML_MOV(block, R32(Rn), I1);                                            // mov     rn,i1
+					if ((opcode & 15) == 0x6 && Rn != Rm)
+						UML_ADD(block, R32(Rm), R32(Rm), 4);                                // add     rm,rm,4
+					memory = true;
+					break;
+				}
+
+				case 0x3:   UML_MOV(block, R32(Rn), R32(Rm));                   break;      /* MOV Rm,Rn */
+				case 0xc:   UML_AND(block, R32(Rn), R32(Rm), 0xff);             break;      /* EXTU.B Rm,Rn */
+				case 0xd:   UML_AND(block, R32(Rn), R32(Rm), 0xffff);           break;      /* EXTU.W Rm,Rn */
+				case 0xe:   UML_SEXT(block, R32(Rn), R32(Rm), SIZE_BYTE);       break;      /* EXTS.B Rm,Rn */
+				case 0xf:   UML_SEXT(block, R32(Rn), R32(Rm), SIZE_WORD);       break;      /* EXTS.W Rm,Rn */
+
+				default:
+					return false;
+			}
+			break;
+
+		case 0x7:                                                   /* ADD #imm,Rn */
+			UML_ADD(block, R32(Rn), R32(Rn), (INT8)opcode);                                 // add     rn,rn,imm
+			break;
+
+		case 0x8:
+			switch (opcode & 0x0f00)
+			{
+				case 0x0800:                                        /* CMP/EQ #imm,R0 */
+					UML_CMP(block, R32(0), (INT8)opcode);                                   // cmp     r0,imm
+					generate_set_t(block, COND_E);
+					break;
+
+				case 0x0900:                                        /* BT disp */
+				case 0x0b00:                                        /* BF disp */
+					generate_branch(block, desc);
+					return true;
+
+				default:
+					return false;
+			}
+			break;
+
+		case 0x9:                                                   /* MOV.W @(disp,PC),Rn */
+		case 0xd:                                                   /* MOV.L @(disp,PC),Rn */
+		{
+			operand_size size = ((opcode >> 12) == 0x9) ? SIZE_WORD : SIZE_DWORD;
+			offs_t address = (size == SIZE_WORD) ? desc->pc + 4 + (opcode & 0xff) * 2 : ((desc->pc + 4) & ~3) + (opcode & 0xff) * 4;
+			if (fold_pcrel(address, size, value))
+			{
+				UML_MOV(block, R32(Rn), value);                                             // mov     rn,value
+				break;
+			}
+			UML_MOV(block, I0, address);                                                    // mov     i0,address
+			generate_read(block, desc, size);
+			if (size == SIZE_WORD)
+				UML_SEXT(block, I1, I1, SIZE_WORD);                                         // sext    i1,i1,word
+			UML_MOV(block, R32(Rn), I1);                                                    // mov     rn,i1
+			memory = true;
+			break;
+		}
+
+		case 0xe:                                                   /* MOV #imm,Rn */
+			UML_MOV(block, R32(Rn), (INT8)opcode);                                          // mov     rn,imm
+			break;
+
+		case 0xf:
+			switch (opcode & 15)
+			{
+				case 0x0:                                           /* FADD FRm,FRn */
+					fpulabel = generate_fpu_check(block, false);
+					UML_FSADD(block, FR32(Rn), FR32(Rn), FR32(Rm));                         // fsadd   frn,frn,frm
+					break;
+
+				case 0x1:                                           /* FSUB FRm,FRn */
+					fpulabel = generate_fpu_check(block, false);
+					UML_FSSUB(block, FR32(Rn), FR32(Rn), FR32(Rm));                         // fssub   frn,frn,frm
+					break;
+
+				case 0x2:                                           /* FMUL FRm,FRn */
+					fpulabel = generate_fpu_check(block, false);
+					UML_FSMUL(block, FR32(Rn), FR32(Rn), FR32(Rm));                         // fsmul   frn,frn,frm
+					break;
+
+				case 0x3:                                           /* FDIV FRm,FRn */
+				{
+					/* division by either zero leaves FRn alone */
+					code_label skip = alloc_label();
+					fpulabel = generate_fpu_check(block, false);
+					UML_TEST(block, FR32(Rm), 0x7fffffff);                                  // test    frm,0x7fffffff
+					UML_JMPc(block, COND_Z, skip);                                          // jmp     skip,z
+					UML_FSDIV(block, FR32(Rn), FR32(Rn), FR32(Rm));                         // fsdiv   frn,frn,frm
+					UML_LABEL(block, skip);                                                 // skip:
+					break;
+				}
+
+				case 0x4:                                           /* FCMP/EQ FRm,FRn */
+				case 0x5:                                           /* FCMP/GT FRm,FRn */
+					fpulabel = generate_fpu_check(block, false);
+					UML_FSCMP(block, FR32(Rn), FR32(Rm));                                   // fscmp   frn,frm
+					UML_SETc(block, ((opcode & 15) == 0x4) ? COND_E : COND_A, I0);          // set     i0,e/a
+					UML_SETc(block, COND_NU, I1);                                           // set     i1,nu
+					UML_AND(block, I0, I0, I1);                                             // and     i0,i0,i1
+					UML_ROLINS(block, mem(&m_sh4.m_sr), I0, 0, T);                          // rolins  [sr],i0,0,T
+					break;
+
+				case 0x8:                                           /* FMOV.S @Rm,FRn */
+				case 0x9:                                           /* FMOV.S @Rm+,FRn */
+					fpulabel = generate_fpu_check(block, true);
+					UML_MOV(block, I0, R32(Rm));                                            // mov     i0,rm
+					generate_read(block, desc, SIZE_DWORD);
+					UML_MOV(block, FR32(Rn), I1);                                           // mov     frn,i1
+					if ((opcode & 15) == 0x9)
+						UML_ADD(block, R32(Rm), R32(Rm), 4);                                // add     rm,rm,4
+					memory = true;
+					break;
+
+				case 0xa:                                           /* FMOV.S FRm,@Rn */
+				case 0xb:                                           /* FMOV.S FRm,@-Rn */
+					fpulabel = generate_fpu_check(block, true);
+					if ((opcode & 15) == 0xb)
+						UML_SUB(block, R32(Rn), R32(Rn), 4);                                // sub     rn,rn,4
+					UML_MOV(block, I0, R32(Rn));                                            // mov     i0,rn
+					UML_MOV(block, I1, FR32(Rm));                                           // mov     i1,frm
+					generate_write(block, desc, SIZE_DWORD);
+					memory = true;
+					break;
+
+				case 0xc:                                           /* FMOV FRm,FRn */
+					fpulabel = generate_fpu_check(block, true);
+					UML_MOV(block, FR32(Rn), FR32(Rm));                                     // mov     frn,frm
+					break;
+
+				case 0xd:
+					switch ((opcode >> 4) & 15)
+					{
+						case 0x0:   UML_MOV(block, FR32(Rn), mem(&m_sh4.m_fpul));   break;  /* FSTS FPUL,FRn */
+						case 0x1:   UML_MOV(block, mem(&m_sh4.m_fpul), FR32(Rn));   break;  /* FLDS FRm,FPUL */
+						case 0x8:   UML_MOV(block, FR32(Rn), 0);                    break;  /* FLDI0 FRn */
+						case 0x9:   UML_MOV(block, FR32(Rn), 0x3f800000);           break;  /* FLDI1 FRn */
+
+						case 0x2:                                   /* FLOAT FPUL,FRn */
+							fpulabel = generate_fpu_check(block, false);
+							UML_FSFRINT(block, FR32(Rn), mem(&m_sh4.m_fpul), SIZE_DWORD);   // fsfrint frn,[fpul],dword
+							break;
+
+						case 0x3:                                   /* FTRC FRm,FPUL */
+							fpulabel = generate_fpu_check(block, false);
+							UML_FSTOINT(block, mem(&m_sh4.m_fpul), FR32(Rn), SIZE_DWORD, ROUND_TRUNC); // fstoint [fpul],frm,dword,trunc
+							break;
+
+						case 0x4:                                   /* FNEG FRn */
+							fpulabel = generate_fpu_check(block, false);
+							UML_XOR(block, FR32(Rn), FR32(Rn), 0x80000000);                 // xor     frn,frn,0x80000000
+							break;
+
+						case 0x5:                                   /* FABS FRn */
+							fpulabel = generate_fpu_check(block, false);
+							UML_AND(block, FR32(Rn), FR32(Rn), 0x7fffffff);                 // and     frn,frn,0x7fffffff
+							break;
+
+						case 0x6:                                   /* FSQRT FRn */
+						{
+							/* negative numbers other than -0 are left alone; NaNs aren't less than 0 */
+							code_label skip = alloc_label();
+							fpulabel = generate_fpu_check(block, false);
+							UML_SUB(block, I0, FR32(Rn), 0x80000001);                       // sub     i0,frn,0x80000001
+							UML_CMP(block, I0, 0x7f7fffff);                                 // cmp     i0,0x7f7fffff
+							UML_JMPc(block, COND_BE, skip);                                 // jmp     skip,be
+							UML_FSSQRT(block, FR32(Rn), FR32(Rn));                          // fssqrt  frn,frn
+							UML_LABEL(block, skip);                                         // skip:
+							break;
+						}
+
+						case 0xe:                                   /* FIPR FVm,FVn */
+							generate_fipr(block, Rn & 12, (Rn & 3) << 2);
+							break;
+
+						case 0xf:                                   /* FTRV XMTRX,FVn */
+							if ((opcode & 0x0300) != 0x0100)
+								return false;
+							generate_ftrv(block, Rn & 12);
+							break;
+
+						default:
+							return false;
+					}
+					break;
+
+				case 0xe:                                           /* FMAC FR0,FRm,FRn */
+					fpulabel = generate_fpu_check(block, false);
+					generate_fmac(block, Rn, Rm);
+					break;
+
+				default:
+					return false;
+			}
+			break;
+
+		default:
+			return false;
+	}
+
+	/* memory handlers may raise an interrupt; nothing else we compile can */
+	code_label donelabel = 0;
+	if (memory)
+	{
+		code_label noirq = alloc_label();
+		donelabel = alloc_label();
+		UML_CMP(block, mem(&m_sh4.m_test_irq), 0);                                          // cmp     [test_irq],0
+		UML_JMPc(block, COND_E, noirq);                                                     // jmp     noirq,e
+		UML_MOV(block, mem(&m_sh4.m_pc), desc->pc + 2);                                     // mov     [pc],desc->pc + 2
+		UML_MOV(block, mem(&m_sh4.m_ppc), desc->pc + 2);                                    // mov     [ppc],desc->pc + 2
+		UML_CALLC(block, cfunc_check_irq, &m_sh4);                                          // callc   check_irq,sh4
+		UML_JMP(block, donelabel);                                                          // jmp     done
+		UML_LABEL(block, noirq);                                                            // noirq:
+	}
+	generate_advance(block, desc);
+
+	/* with PR or SZ set, the FPU ops are left to the interpreter */
+	if (fpulabel.label() != 0)
+	{
+		if (donelabel.label() == 0)
+			donelabel = alloc_label();
+		UML_JMP(block, donelabel);                                                          // jmp     done
+		UML_LABEL(block, fpulabel);                                                         // fpu:
+		generate_execute_one(block, desc);
+	}
+	if (donelabel.label() != 0)
+		UML_LABEL(block, donelabel);                                                        // done:
+	return true;
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate code for BT and BF
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_branch(drcuml_block *block, const opcode_desc *desc)
+{
+	const UINT16 opcode = desc->opptr.w[0];
+	code_label skip = alloc_label();
+
+	/* PC is always written here, so the dispatcher can take either path */
+	UML_MOV(block, mem(&m_sh4.m_pc), desc->pc + 2);                                         // mov     [pc],desc->pc + 2
+	UML_MOV(block, mem(&m_sh4.m_ppc), desc->pc + 2);                                        // mov     [ppc],desc->pc + 2
+	UML_SUB(block, mem(&m_sh4.m_sh4_icount), mem(&m_sh4.m_sh4_icount), 1);                  // sub     [icount],[icount],1
+	UML_TEST(block, mem(&m_sh4.m_sr), T);                                                   // test    [sr],T
+	UML_JMPc(block, ((opcode & 0x0f00) == 0x0900) ? COND_Z : COND_NZ, skip);                // jmp     skip,z/nz
+	UML_MOV(block, mem(&m_sh4.m_pc), desc->pc + 4 + (INT8)opcode * 2);                      // mov     [pc],target
+	UML_SUB(block, mem(&m_sh4.m_sh4_icount), mem(&m_sh4.m_sh4_icount), 2);                  // sub     [icount],[icount],2
+	UML_LABEL(block, skip);                                                                 // skip:
+	UML_MOV(block, mem(&m_sh4.m_drcnextpc), mem(&m_sh4.m_pc));                              // mov     [nextpc],[pc]
+	UML_CMP(block, mem(&m_sh4.m_sh4_icount), 0);                                            // cmp     [icount],0
+	UML_MOVc(block, COND_LE, mem(&m_sh4.m_drcnextpc), ~0);                                  // mov     [nextpc],~0,le
+}
+
+
+/*-------------------------------------------------
+    generate_advance - count a compiled
+    instruction and tell the block where to go
+    next; PC is only written when leaving
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_advance(drcuml_block *block, const opcode_desc *desc)
+{
+	offs_t nextpc = desc->pc + 2;
+
+	if (desc->flags & OPFLAG_END_SEQUENCE)
+	{
+		UML_MOV(block, mem(&m_sh4.m_pc), nextpc);                                           // mov     [pc],nextpc
+		UML_MOV(block, mem(&m_sh4.m_ppc), nextpc);                                          // mov     [ppc],nextpc
+		UML_MOV(block, mem(&m_sh4.m_drcnextpc), nextpc);                                    // mov     [nextpc],nextpc
+		UML_SUB(block, mem(&m_sh4.m_sh4_icount), mem(&m_sh4.m_sh4_icount), 1);              // sub     [icount],[icount],1
+		UML_MOVc(block, COND_LE, mem(&m_sh4.m_drcnextpc), ~0);                              // mov     [nextpc],~0,le
+	}
+	else
+	{
+		code_label skip = alloc_label();
+		UML_MOV(block, mem(&m_sh4.m_drcnextpc), nextpc);                                    // mov     [nextpc],nextpc
+		UML_SUB(block, mem(&m_sh4.m_sh4_icount), mem(&m_sh4.m_sh4_icount), 1);              // sub     [icount],[icount],1
+		UML_JMPc(block, COND_G, skip);                                                      // jmp     skip,g
+		UML_MOV(block, mem(&m_sh4.m_pc), nextpc);                                           // mov     [pc],nextpc
+		UML_MOV(block, mem(&m_sh4.m_ppc), nextpc);                                          // mov     [ppc],nextpc
+		UML_MOV(block, mem(&m_sh4.m_drcnextpc), ~0);                                        // mov     [nextpc],~0
+		UML_LABEL(block, skip);                                                             // skip:
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_set_t - set the T bit from a
+    condition
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_set_t(drcuml_block *block, condition_t cond)
+{
+	UML_SETc(block, cond, I0);                                                              // set     i0,cond
+	UML_ROLINS(block, mem(&m_sh4.m_sr), I0, 0, T);                                          // rolins  [sr],i0,0,T
+}
+
+
+/*-------------------------------------------------
+    generate_fpu_check - jump to a new label,
+    which is returned, if the FPU isn't in single
+    precision mode (or, for moves, 32-bit mode)
+-------------------------------------------------*/
+
+code_label sh4_recompiler::generate_fpu_check(drcuml_block *block, bool size)
+{
+	code_label label = alloc_label();
+
+	UML_CMP(block, mem(&m_sh4.m_fpu_pr), 0);                                                // cmp     [fpu_pr],0
+	UML_JMPc(block, COND_NE, label);                                                        // jmp     fpu,ne
+	if (size)
+	{
+		UML_CMP(block, mem(&m_sh4.m_fpu_sz), 0);                                            // cmp     [fpu_sz],0
+		UML_JMPc(block, COND_NE, label);                                                    // jmp     fpu,ne
+	}
+	return label;
+}
+
+
+/*-------------------------------------------------
+    generate_fmac - FRn = FR0 * FRm + FRn
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_fmac(drcuml_block *block, int n, int m)
+{
+	UML_FSMUL(block, F0, FR32(0), FR32(m));                                                 // fsmul   f0,fr0,frm
+	UML_FSADD(block, FR32(n), F0, FR32(n));                                                 // fsadd   frn,f0,frn
+}
+
+
+/*-------------------------------------------------
+    generate_fipr - inner product of FVn and FVm
+    into FR(n+3), summed in the interpreter's
+    order
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_fipr(drcuml_block *block, int n, int m)
+{
+	UML_FSMUL(block, F0, FR32(n + 0), FR32(m + 0));                                         // fsmul   f0,frn0,frm0
+	for (int a = 1; a < 4; a++)
+	{
+		UML_FSMUL(block, F1, FR32(n + a), FR32(m + a));                                     // fsmul   f1,frna,frma
+		UML_FSADD(block, F0, F0, F1);                                                       // fsadd   f0,f0,f1
+	}
+	UML_FSMOV(block, FR32(n + 3), F0);                                                      // fsmov   frn3,f0
+}
+
+
+/*-------------------------------------------------
+    generate_ftrv - transform FVn by XMTRX, all
+    four results computed before any is stored
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_ftrv(drcuml_block *block, int n)
+{
+	static const float zero = 0.0f;
+	static const parameter sum[4] = { F0, F1, F2, F3 };
+
+	for (int i = 0; i < 4; i++)
+	{
+		UML_FSMOV(block, sum[i], mem(&zero));                                               // fsmov   fi,0
+		for (int j = 0; j < 4; j++)
+		{
+			UML_FSMUL(block, F4, XF32((j << 2) + i), FR32(n + j));                          // fsmul   f4,xfji,frnj
+			UML_FSADD(block, sum[i], sum[i], F4);                                           // fsadd   fi,fi,f4
+		}
+	}
+	for (int i = 0; i < 4; i++)
+		UML_FSMOV(block, FR32(n + i), sum[i]);                                              // fsmov   frni,fi
+}
+
+
+/*-------------------------------------------------
+    generate_read - read from the address in I0
+    into I1, straight from fast RAM if it is
+    there; I0 is trashed
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_read(drcuml_block *block, const opcode_desc *desc, operand_size size)
+{
+	code_label slowlabel = alloc_label();
+	code_label donelabel = alloc_label();
+	UINT32 bytes = 1 << size;
+
+	/* P4 is never fast RAM, and isn't mirrored */
+	UML_CMP(block, I0, 0xe0000000);                                                         // cmp     i0,0xe0000000
+	UML_JMPc(block, COND_AE, slowlabel);                                                    // jmp     slow,ae
+	UML_AND(block, I0, I0, AM);                                                             // and     i0,i0,AM
+
+	if (m_fastdata && m_sh4.m_fastram_select > 0)
+	{
+		if (bytes > 1)
+		{
+			UML_TEST(block, I0, bytes - 1);                                                 // test    i0,bytes-1
+			UML_JMPc(block, COND_NZ, slowlabel);                                            // jmp     slow,nz
+		}
+		for (UINT32 ramnum = 0; ramnum < m_sh4.m_fastram_select; ramnum++)
+		{
+			UINT8 *fastbase = (UINT8 *)m_sh4.m_fastram[ramnum].base - m_sh4.m_fastram[ramnum].start;
+			code_label skip = alloc_label();
+			if (m_sh4.m_fastram[ramnum].end != 0xffffffff)
+			{
+				UML_CMP(block, I0, m_sh4.m_fastram[ramnum].end);                            // cmp     i0,end
+				UML_JMPc(block, COND_A, skip);                                              // jmp     skip,a
+			}
+			if (m_sh4.m_fastram[ramnum].start != 0)
+			{
+				UML_CMP(block, I0, m_sh4.m_fastram[ramnum].start);                          // cmp     i0,start
+				UML_JMPc(block, COND_B, skip);                                              // jmp     skip,b
+			}
+			UML_LOAD(block, I1, fastbase, I0, size, SCALE_x1);                              // load    i1,fastbase,i0,size
+			UML_JMP(block, donelabel);                                                      // jmp     done
+			UML_LABEL(block, skip);                                                         // skip:
+		}
+	}
+
+	UML_LABEL(block, slowlabel);                                                            // slow:
+	generate_flush_pc(block, desc);
+	UML_READ(block, I1, I0, size, SPACE_PROGRAM);                                           // read    i1,i0,size
+	UML_LABEL(block, donelabel);                                                            // done:
+}
+
+
+/*-------------------------------------------------
+    generate_write - write I1 to the address in
+    I0, straight to fast RAM if it is there and
+    writable; I0 is trashed
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_write(drcuml_block *block, const opcode_desc *desc, operand_size size)
+{
+	code_label slowlabel = alloc_label();
+	code_label donelabel = alloc_label();
+	UINT32 bytes = 1 << size;
+
+	/* P4 is never fast RAM, and isn't mirrored */
+	UML_CMP(block, I0, 0xe0000000);                                                         // cmp     i0,0xe0000000
+	UML_JMPc(block, COND_AE, slowlabel);                                                    // jmp     slow,ae
+	UML_AND(block, I0, I0, AM);                                                             // and     i0,i0,AM
+
+	if (m_fastdata && m_sh4.m_fastram_select > 0)
+	{
+		if (bytes > 1)
+		{
+			UML_TEST(block, I0, bytes - 1);                                                 // test    i0,bytes-1
+			UML_JMPc(block, COND_NZ, slowlabel);                                            // jmp     slow,nz
+		}
+		for (UINT32 ramnum = 0; ramnum < m_sh4.m_fastram_select; ramnum++)
+			if (!m_sh4.m_fastram[ramnum].readonly)
+			{
+				UINT8 *fastbase = (UINT8 *)m_sh4.m_fastram[ramnum].base - m_sh4.m_fastram[ramnum].start;
+				code_label skip = alloc_label();
+				if (m_sh4.m_fastram[ramnum].end != 0xffffffff)
+				{
+					UML_CMP(block, I0, m_sh4.m_fastram[ramnum].end);                        // cmp     i0,end
+					UML_JMPc(block, COND_A, skip);                                          // jmp     skip,a
+				}
+				if (m_sh4.m_fastram[ramnum].start != 0)
+				{
+					UML_CMP(block, I0, m_sh4.m_fastram[ramnum].start);                      // cmp     i0,start
+					UML_JMPc(block, COND_B, skip);                                          // jmp     skip,b
+				}
+				UML_STORE(block, fastbase, I0, I1, size, SCALE_x1);                         // store   fastbase,i0,i1,size
+				UML_JMP(block, donelabel);                                                  // jmp     done
+				UML_LABEL(block, skip);                                                     // skip:
+			}
+	}
+
+	UML_LABEL(block, slowlabel);                                                            // slow:
+	generate_flush_pc(block, desc);
+	UML_WRITE(block, I0, I1, size, SPACE_PROGRAM);                                          // write   i0,i1,size
+	UML_LABEL(block, donelabel);                                                            // done:
+}
+
+
+/*-------------------------------------------------
+    generate_flush_pc - bring PC up to date before
+    a memory handler is called, if it was asked
+    for
+-------------------------------------------------*/
+
+void sh4_recompiler::generate_flush_pc(drcuml_block *block, const opcode_desc *desc)
+{
+	bool flush = (m_sh4.m_drcoptions & SH4DRC_FLUSH_PC) != 0;
+
+	for (UINT32 pcfnum = 0; pcfnum < m_sh4.m_pcfsel && !flush; pcfnum++)
+		if ((m_sh4.m_pcflushes[pcfnum] & AM) == (desc->pc & AM))
+			flush = true;
+
+	/* the handlers see PC past the instruction, as in the interpreter */
+	if (flush)
+	{
+		UML_MOV(block, mem(&m_sh4.m_pc), desc->pc + 2);                                     // mov     [pc],desc->pc + 2
+		UML_MOV(block, mem(&m_sh4.m_ppc), desc->pc + 2);                                    // mov     [ppc],desc->pc + 2
+	}
+}
+
+
+/*-------------------------------------------------
+    fold_pcrel - fetch the value of a PC-relative
+    load at compile time if it can't change
+-------------------------------------------------*/
+
+bool sh4_recompiler::fold_pcrel(offs_t address, operand_size size, UINT32 &value)
+{
+	if ((m_sh4.m_drcoptions & SH4DRC_STRICT_PCREL) || !m_fastdata || address >= 0xe0000000)
+		return false;
+
+	address &= AM;
+	for (UINT32 ramnum = 0; ramnum < m_sh4.m_fastram_select; ramnum++)
+		if (m_sh4.m_fastram[ramnum].readonly && address >= m_sh4.m_fastram[ramnum].start && address <= m_sh4.m_fastram[ramnum].end)
+		{
+			UINT8 *ptr = (UINT8 *)m_sh4.m_fastram[ramnum].base + (address - m_sh4.m_fastram[ramnum].start);
+			value = (size == SIZE_WORD) ? (INT16)*(UINT16 *)ptr : *(UINT32 *)ptr;
+			return true;
+		}
+	return false;
+}
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh4drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_set_options(UINT32 options)
+{
+	if (!machine().options().drc()) return;
+	m_drcoptions = options;
+}
+
+
+/*-------------------------------------------------
+    sh4drc_add_fastram - add a new fastram region;
+    code in it is fetched from base, and only
+    checked before running if it is writable;
+    loads and stores go straight to base
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
+{
+	if (m_fastram_select < ARRAY_LENGTH(m_fastram))
+	{
+		m_fastram[m_fastram_select].start = start;
+		m_fastram[m_fastram_select].end = end;
+		m_fastram[m_fastram_select].readonly = readonly;
+		m_fastram[m_fastram_select].base = base;
+		m_fastram_select++;
+	}
+
+	/* code already compiled may have been checked the other way */
+	drc_set_dirty();
+}
+
+
+/*-------------------------------------------------
+    sh4drc_add_pcflush - add a new address where
+    the PC must be flushed for speedups to work
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_add_pcflush(offs_t address)
+{
+	if (!machine().options().drc()) return;
+
+	if (m_pcfsel < ARRAY_LENGTH(m_pcflushes))
+		m_pcflushes[m_pcfsel++] = address;
+
+	/* code already compiled doesn't flush there */
+	drc_set_dirty();
+}
@@ -10,9 +10,6 @@
 
     Future improvements/changes:
 
-    * UML optimizer:
-        - constant folding
-
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
         - checks behavior of all opcodes
@@ -850,6 +847,63 @@ UINT8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input - return true if the given
+//  parameter is read by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[paramnum].output & PIO_IN) != 0);
+}
+
+
+//-------------------------------------------------
+//  param_is_output - return true if the given
+//  parameter is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[paramnum].output & PIO_OUT) != 0);
+}
+
+
+//-------------------------------------------------
+//  param_allows - return true if the given
+//  parameter may be encoded with the given type
+//-------------------------------------------------
+
+bool uml::instruction::param_allows(int paramnum, parameter::parameter_type type) const
+{
+	assert(paramnum < m_numparams);
+	return (((s_opcode_info_table[m_opcode].param[paramnum].typemask >> type) & 1) != 0);
+}
+
+
+//-------------------------------------------------
+//  param_size - return the size in bytes of the
+//  value accessed through the given parameter
+//-------------------------------------------------
+
+UINT8 uml::instruction::param_size(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	UINT8 size = s_opcode_info_table[m_opcode].param[paramnum].size;
+
+	// operation-sized parameters match the instruction
+	if (size == PSIZE_OP)
+		return m_size;
+
+	// otherwise, the size may come from another parameter
+	if (size & 0x80)
+		return 1 << m_param[size - PSIZE_P1].size();
+	return 1 << size;
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
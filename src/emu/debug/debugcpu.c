@@ -2793,8 +2793,8 @@ void device_debug::compute_debug_flags()
 	running_machine &machine = m_device.machine();
 	debugcpu_private *global = machine.debugcpu_data;
 
-	// clear out global flags by default, keep DEBUG_FLAG_OSD_ENABLED
-	machine.debug_flags &= DEBUG_FLAG_OSD_ENABLED;
+	// clear out global flags by default, keep DEBUG_FLAG_OSD_ENABLED and DEBUG_FLAG_IDLE_HOOK
+	machine.debug_flags &= DEBUG_FLAG_OSD_ENABLED | DEBUG_FLAG_IDLE_HOOK;
 	machine.debug_flags |= DEBUG_FLAG_ENABLED;
 
 	// if we are ignoring this CPU, or if events are pending, we're done
@@ -43,6 +43,7 @@ const int TRIGGER_SUSPENDTIME   = -4000;
 
 device_execute_interface::device_execute_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "execute"),
+		m_scheduler(NULL),
 		m_disabled(false),
 		m_vblank_interrupt_screen(NULL),
 		m_timed_interrupt_period(attotime::zero),
@@ -60,10 +61,25 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 		m_trigger(0),
 		m_inttrigger(0),
 		m_totalcycles(0),
+		m_localtick(0),
 		m_divisor(0),
 		m_divshift(0),
 		m_cycles_per_second(0),
-		m_attoseconds_per_cycle(0)
+		m_attoseconds_per_cycle(0),
+		m_idle_state(NULL),
+		m_idle_lastpc(0),
+		m_idle_start(~0),
+		m_idle_end(0),
+		m_idle_matches(0),
+		m_idle_skip(0),
+		m_idle_backoff(1),
+		m_idle_busy(~0),
+		m_idle_detections(0),
+		m_idle_cycles(0),
+		m_idle_watching(false),
+		m_idle_rejected(false),
+		m_idle_spinning(false),
+		m_idle_numpolls(0)
 {
 	memset(&m_localtime, 0, sizeof(m_localtime));
 
@@ -318,14 +334,17 @@ void device_execute_interface::trigger(int trigid)
 
 attotime device_execute_interface::local_time() const
 {
+	// the scheduler keeps our time in ticks whenever it can
+	attotime localtime = (m_scheduler != NULL && m_scheduler->tick_valid(m_localtick)) ? m_scheduler->tick_to_time(m_localtick) : m_localtime;
+
 	// if we're active, add in the time from the current slice
 	if (executing())
 	{
 		assert(m_cycles_running >= *m_icountptr);
 		int cycles = m_cycles_running - *m_icountptr;
-		return m_localtime + cycles_to_attotime(cycles);
+		return localtime + cycles_to_attotime(cycles);
 	}
-	return m_localtime;
+	return localtime;
 }
 
 
@@ -346,6 +365,246 @@ UINT64 device_execute_interface::total_cycles() const
 }
 
 
+//-------------------------------------------------
+//  idle_check_branch - examine a change of flow
+//  seen by idle_instruction_hook, spinning if
+//  the same short loop keeps running without
+//  writing memory or seeing anything change
+//-------------------------------------------------
+
+void device_execute_interface::idle_check_branch(offs_t curpc, offs_t lastpc)
+{
+	// a branch back to the head of the candidate loop completes an iteration
+	if (curpc == m_idle_start && lastpc >= m_idle_start && lastpc <= m_idle_end)
+	{
+		// don't look too often at loops that are doing real work
+		if (m_idle_skip > 0)
+		{
+			m_idle_skip--;
+			return;
+		}
+
+		// a register change, a write or a changing read means the loop is busy; back off
+		if (!idle_capture_state() || m_idle_rejected)
+		{
+			idle_set_watching(false);
+			m_idle_matches = 0;
+			m_idle_busy = curpc;
+			m_idle_skip = m_idle_backoff;
+			m_idle_backoff = MIN(m_idle_backoff * 2, IDLE_LOOP_MAX_BACKOFF);
+			return;
+		}
+		if (++m_idle_matches < IDLE_LOOP_CONFIRM)
+			return;
+		m_idle_matches = 0;
+
+		// once the registers settle, watch the memory the next iterations access;
+		// the debugger owns the watchpoints while it is active, so give up there
+		if (!m_idle_watching)
+		{
+			if ((device().machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+				m_idle_rejected = true;
+			else
+				idle_set_watching(true);
+			return;
+		}
+
+		// nothing changed: spin until an interrupt or a write to the polled memory
+		m_idle_watching = false;
+		m_idle_detections++;
+		if (m_icountptr != NULL && *m_icountptr > 0)
+			m_idle_cycles += *m_icountptr;
+		m_idle_spinning = true;
+		suspend(SUSPEND_REASON_SPIN, true);
+		static_idle_update_watchpoints(device().machine(), NULL, 0);
+		return;
+	}
+
+	// a short backward branch starts a new candidate loop
+	idle_set_watching(false);
+	if (curpc <= lastpc && lastpc - curpc < IDLE_LOOP_MAX_BYTES)
+	{
+		// keep backing off if this is the busy loop we just left
+		if (curpc != m_idle_busy)
+		{
+			m_idle_skip = 0;
+			m_idle_backoff = 1;
+		}
+		m_idle_start = curpc;
+		m_idle_end = lastpc;
+		m_idle_matches = 0;
+		idle_capture_state();
+		return;
+	}
+
+	// anything else leaves the loop
+	m_idle_start = ~0;
+	m_idle_end = 0;
+}
+
+
+//-------------------------------------------------
+//  idle_capture_state - snapshot the device
+//  state, returning true if it matches the
+//  previous snapshot
+//-------------------------------------------------
+
+bool device_execute_interface::idle_capture_state()
+{
+	if (m_idle_state == NULL)
+		return false;
+
+	bool same = true;
+	int regnum = 0;
+	for (const device_state_entry *entry = m_idle_state->state_first(); entry != NULL; entry = entry->next(), regnum++)
+	{
+		UINT64 value = m_idle_state->state_int(entry->index());
+		if (m_idle_regs[regnum] != value)
+		{
+			m_idle_regs[regnum] = value;
+			same = false;
+		}
+	}
+	return same;
+}
+
+
+//-------------------------------------------------
+//  idle_set_watching - start or stop watching
+//  the memory accesses of the candidate loop
+//-------------------------------------------------
+
+void device_execute_interface::idle_set_watching(bool watching)
+{
+	m_idle_rejected = false;
+	if (watching)
+		m_idle_numpolls = 0;
+	if (m_idle_watching != watching)
+	{
+		m_idle_watching = watching;
+		static_idle_update_watchpoints(device().machine(), NULL, 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  idle_stop_spin - resume a device spinning on
+//  an idle loop
+//-------------------------------------------------
+
+void device_execute_interface::idle_stop_spin()
+{
+	m_idle_spinning = false;
+	resume(SUSPEND_REASON_SPIN);
+
+	// we may be inside a watched access, so drop the watchpoints once it is done
+	m_scheduler->synchronize(FUNC(static_idle_update_watchpoints));
+}
+
+
+//-------------------------------------------------
+//  idle_memory_read - record a read by a loop
+//  under watch; only a few locations of plain
+//  memory that keep their value are allowed
+//-------------------------------------------------
+
+void device_execute_interface::idle_memory_read(address_space &space, offs_t byteaddress, int bytes, UINT64 data)
+{
+	device_execute_interface *exec;
+	if (!space.device().interface(exec) || !exec->m_idle_watching || exec->m_idle_rejected)
+		return;
+
+	// reads through a handler can change without a write, so they aren't idle
+	UINT8 *ptr = reinterpret_cast<UINT8 *>(space.get_read_ptr(byteaddress));
+	if (ptr == NULL)
+	{
+		exec->m_idle_rejected = true;
+		return;
+	}
+
+	// a location we have seen before must still hold the same value
+	for (int pollnum = 0; pollnum < exec->m_idle_numpolls; pollnum++)
+	{
+		idle_poll &poll = exec->m_idle_polls[pollnum];
+		if (poll.m_ptr == ptr && poll.m_bytes == bytes)
+		{
+			if (poll.m_data != data)
+				exec->m_idle_rejected = true;
+			return;
+		}
+	}
+
+	// otherwise remember it, if there is room
+	if (exec->m_idle_numpolls == IDLE_LOOP_MAX_POLLS)
+	{
+		exec->m_idle_rejected = true;
+		return;
+	}
+	idle_poll &poll = exec->m_idle_polls[exec->m_idle_numpolls++];
+	poll.m_ptr = ptr;
+	poll.m_bytes = bytes;
+	poll.m_data = data;
+}
+
+
+//-------------------------------------------------
+//  idle_memory_write - reject a loop under watch
+//  that writes, and wake any device spinning on
+//  the memory being written
+//-------------------------------------------------
+
+void device_execute_interface::idle_memory_write(address_space &space, offs_t byteaddress, int bytes)
+{
+	device_execute_interface *exec;
+	if (space.device().interface(exec) && exec->m_idle_watching)
+		exec->m_idle_rejected = true;
+
+	// compare the memory behind the write, so writes through other spaces that share it count
+	UINT8 *ptr = reinterpret_cast<UINT8 *>(space.get_write_ptr(byteaddress));
+	if (ptr == NULL)
+		return;
+	for (exec = space.machine().scheduler().m_execute_list; exec != NULL; exec = exec->m_nextexec)
+		if (exec->m_idle_spinning)
+			for (int pollnum = 0; pollnum < exec->m_idle_numpolls; pollnum++)
+			{
+				const idle_poll &poll = exec->m_idle_polls[pollnum];
+				if (ptr < poll.m_ptr + poll.m_bytes && poll.m_ptr < ptr + bytes)
+				{
+					exec->idle_stop_spin();
+					break;
+				}
+			}
+}
+
+
+//-------------------------------------------------
+//  idle_postload - forget any idle loop after a
+//  state load
+//-------------------------------------------------
+
+void device_execute_interface::idle_postload()
+{
+	m_idle_watching = m_idle_spinning = false;
+	m_idle_start = ~0;
+	m_idle_end = 0;
+	resume(SUSPEND_REASON_SPIN);
+	static_idle_update_watchpoints(device().machine(), NULL, 0);
+}
+
+
+//-------------------------------------------------
+//  idle_report - print idle loop statistics at
+//  exit
+//-------------------------------------------------
+
+void device_execute_interface::idle_report()
+{
+	UINT64 total = total_cycles();
+	osd_printf_info("%s: %d idle loops spun out, %" I64FMT "u of %" I64FMT "u cycles skipped (%.1f%%)\n", device().tag(), m_idle_detections,
+			m_idle_cycles, total, (total != 0) ? (double)m_idle_cycles * 100.0 / (double)total : 0.0);
+}
+
+
 //-------------------------------------------------
 //  execute_clocks_to_cycles - convert the number
 //  of clocks to cycles, rounding down if necessary
@@ -511,6 +770,17 @@ void device_execute_interface::interface_post_start()
 	// fill in the input states and IRQ callback information
 	for (int line = 0; line < ARRAY_LENGTH(m_input); line++)
 		m_input[line].start(this, line);
+
+	// set up idle loop detection if it is enabled
+	if ((device().machine().debug_flags & DEBUG_FLAG_IDLE_HOOK) != 0 && device().interface(m_idle_state))
+	{
+		int count = 0;
+		for (const device_state_entry *entry = m_idle_state->state_first(); entry != NULL; entry = entry->next())
+			count++;
+		m_idle_regs.resize_and_clear(count);
+		device().machine().save().register_postload(save_prepost_delegate(FUNC(device_execute_interface::idle_postload), this));
+		device().machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(device_execute_interface::idle_report), this));
+	}
 }
 
 
@@ -524,6 +794,15 @@ void device_execute_interface::interface_pre_reset()
 	// reset the total number of cycles
 	m_totalcycles = 0;
 
+	// forget any idle loop in progress
+	if (m_idle_watching || m_idle_spinning)
+	{
+		m_idle_watching = m_idle_spinning = false;
+		static_idle_update_watchpoints(device().machine(), NULL, 0);
+	}
+	m_idle_start = ~0;
+	m_idle_end = 0;
+
 	// enable all devices (except for disabled devices)
 	if (!disabled())
 		resume(SUSPEND_ANY_REASON);
@@ -661,6 +940,36 @@ TIMER_CALLBACK( device_execute_interface::static_timed_trigger_callback )
 }
 
 
+//-------------------------------------------------
+//  static_idle_update_watchpoints - enable the
+//  watchpoints idle loop detection needs: reads
+//  and writes in the spaces of a device whose
+//  loop is under watch, and writes everywhere
+//  while any device spins
+//-------------------------------------------------
+
+TIMER_CALLBACK( device_execute_interface::static_idle_update_watchpoints )
+{
+	bool spinning = false;
+	execute_interface_iterator execiter(machine.root_device());
+	for (device_execute_interface *exec = execiter.first(); exec != NULL; exec = execiter.next())
+		spinning |= exec->m_idle_spinning;
+
+	memory_interface_iterator memiter(machine.root_device());
+	for (device_memory_interface *memory = memiter.first(); memory != NULL; memory = memiter.next())
+	{
+		device_execute_interface *exec;
+		bool watching = memory->device().interface(exec) && exec->m_idle_watching;
+		for (address_spacenum spacenum = AS_0; spacenum < ADDRESS_SPACES; spacenum++)
+			if (memory->has_space(spacenum))
+			{
+				memory->space(spacenum).enable_read_watchpoints(watching);
+				memory->space(spacenum).enable_write_watchpoints(watching || spinning);
+			}
+	}
+}
+
+
 //-------------------------------------------------
 //  on_vblank - calls any external callbacks
 //  for this screen
@@ -874,7 +1183,10 @@ if (TEMPLOG) printf(" (%d,%d)\n", m_curstate, m_curvector);
 
 			// generate a trigger to unsuspend any devices waiting on the interrupt
 			if (m_curstate != CLEAR_LINE)
+			{
 				m_execute->signal_interrupt_trigger();
+				m_execute->idle_wake();
+			}
 		}
 	}
 
@@ -33,6 +33,13 @@ const UINT32 SUSPEND_REASON_CLOCK       = 0x0040;   // currently not clocked
 const UINT32 SUSPEND_ANY_REASON         = ~0;       // all of the above
 
 
+// idle loop detection parameters
+const offs_t IDLE_LOOP_MAX_BYTES        = 32;       // longest loop body considered, in PC units
+const int IDLE_LOOP_CONFIRM             = 4;        // unchanged iterations needed before spinning
+const int IDLE_LOOP_MAX_BACKOFF         = 4096;     // most iterations to skip checking a busy loop
+const int IDLE_LOOP_MAX_POLLS           = 4;        // most distinct memory locations an idle loop may read
+
+
 // I/O line states
 enum line_state
 {
@@ -187,6 +194,22 @@ public:
 	attotime local_time() const;
 	UINT64 total_cycles() const;
 
+	// idle loop detection, called via debugger_instruction_hook when enabled
+	void idle_instruction_hook(offs_t curpc)
+	{
+		offs_t lastpc = m_idle_lastpc;
+		m_idle_lastpc = curpc;
+		if (curpc <= m_idle_start || curpc > m_idle_end)
+			idle_check_branch(curpc, lastpc);
+	}
+	void idle_wake() { if (m_idle_spinning) idle_stop_spin(); }
+	UINT32 idle_detections() const { return m_idle_detections; }
+	UINT64 idle_cycles() const { return m_idle_cycles; }
+
+	// idle loop detection, called by the memory system while its watchpoints are live
+	static void idle_memory_read(address_space &space, offs_t byteaddress, int bytes, UINT64 data);
+	static void idle_memory_write(address_space &space, offs_t byteaddress, int bytes);
+
 	// required operation overrides
 	void run() { execute_run(); }
 
@@ -197,6 +220,12 @@ public:
 protected:
 	// internal helpers
 	void run_thread_wrapper();
+	void idle_check_branch(offs_t curpc, offs_t lastpc);
+	bool idle_capture_state();
+	void idle_set_watching(bool watching);
+	void idle_stop_spin();
+	void idle_postload();
+	void idle_report();
 
 	// clock and cycle information getters
 	virtual UINT64 execute_clocks_to_cycles(UINT64 clocks) const;
@@ -290,14 +319,39 @@ protected:
 	// clock and timing information
 	UINT64                  m_totalcycles;              // total device cycles executed
 	attotime                m_localtime;                // local time, relative to the timer system's global time
+	attoseconds_t           m_localtick;                // local time in scheduler ticks; overrides m_localtime when valid
 	INT32                   m_divisor;                  // 32-bit attoseconds_per_cycle divisor
 	UINT8                   m_divshift;                 // right shift amount to fit the divisor into 32 bits
 	UINT32                  m_cycles_per_second;        // cycles per second, adjusted for multipliers
 	attoseconds_t           m_attoseconds_per_cycle;    // attoseconds per adjusted clock cycle
 
+	// idle loop detection
+	device_state_interface *m_idle_state;               // state interface used to compare iterations
+	offs_t                  m_idle_lastpc;              // PC of the previous instruction
+	offs_t                  m_idle_start;               // first PC of the candidate loop
+	offs_t                  m_idle_end;                 // PC of the candidate loop's backward branch
+	int                     m_idle_matches;             // consecutive unchanged iterations
+	int                     m_idle_skip;                // iterations left before checking again
+	int                     m_idle_backoff;             // current skip interval for a busy loop
+	offs_t                  m_idle_busy;                // start PC of the last loop found busy
+	dynamic_array<UINT64>   m_idle_regs;                // state at the previous loop iteration
+	UINT32                  m_idle_detections;          // number of times we spun on an idle loop
+	UINT64                  m_idle_cycles;              // cycles skipped while spinning
+	bool                    m_idle_watching;            // true while the loop's memory accesses are watched
+	bool                    m_idle_rejected;            // true if the watched loop wrote or read changing memory
+	bool                    m_idle_spinning;            // true while suspended on a detected idle loop
+	int                     m_idle_numpolls;            // number of locations the loop reads
+	struct idle_poll
+	{
+		UINT8 *             m_ptr;                      // memory behind the location
+		int                 m_bytes;                    // width of the access
+		UINT64              m_data;                     // value read
+	}                       m_idle_polls[IDLE_LOOP_MAX_POLLS];
+
 private:
 	// callbacks
 	static void static_timed_trigger_callback(running_machine &machine, void *ptr, int param);
+	static void static_idle_update_watchpoints(running_machine &machine, void *ptr, int param);
 
 	void on_vblank(screen_device &screen, bool vblank_state);
 
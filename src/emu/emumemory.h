@@ -76,6 +76,7 @@ class address_table;
 class address_table_read;
 class address_table_write;
 class address_table_setoffset;
+class memory_access_stats;
 
 
 // offsets and addresses are 32-bit (for now...)
@@ -177,7 +178,7 @@ public:
 
 	// force a recomputation on the next read
 	void force_update() { m_byteend = 0; m_bytestart = 1; }
-	void force_update(UINT16 if_match) { if (m_entry == if_match) force_update(); }
+	void force_update(UINT16 if_match) { flush_cache(if_match); if (m_entry == if_match) force_update(); }
 
 	// custom update callbacks and configuration
 	direct_update_delegate set_direct_update(direct_update_delegate function);
@@ -198,10 +199,25 @@ public:
 	UINT64 read_decrypted_qword(offs_t byteaddress, offs_t directxor = 0);
 
 private:
+	// recently used bank ranges, set-associative on the address bits above CACHE_SHIFT
+	static const int CACHE_SETS = 8;
+	static const int CACHE_WAYS = 4;
+	static const int CACHE_SHIFT = 12;
+	struct cache_entry
+	{
+		offs_t                  m_bytestart;            // first byte address covered, including masked bits
+		offs_t                  m_byteend;              // last byte address covered
+		offs_t                  m_bytemask;             // byte mask of the bank handler
+		offs_t                  m_baseoffs;             // masked start of the bank handler
+		UINT16                  m_entry;                // bank entry
+	};
+
 	// internal helpers
 	bool set_direct_region(offs_t &byteaddress);
 	direct_range *find_range(offs_t byteaddress, UINT16 &entry);
 	void remove_intersecting_ranges(offs_t bytestart, offs_t byteend);
+	void configure_bank(const cache_entry &entry);
+	void flush_cache(int if_match = -1);
 
 	// internal state
 	address_space &             m_space;
@@ -214,6 +230,7 @@ private:
 	simple_list<direct_range>   m_rangelist[TOTAL_MEMORY_BANKS];  // list of ranges for each entry
 	simple_list<direct_range>   m_freerangelist;        // list of recycled range entries
 	direct_update_delegate      m_directupdate;         // fast direct-access update callback
+	cache_entry                 m_cache[CACHE_SETS][CACHE_WAYS]; // recently used ranges, most recent first
 };
 
 
@@ -310,6 +327,10 @@ public:
 	void set_log_unmap(bool log) { m_log_unmap = log; }
 	void dump_map(FILE *file, read_or_write readorwrite);
 
+	// access statistics
+	void enable_access_stats(bool enable = true);
+	void dump_access_stats();
+
 	// watchpoint enablers
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
@@ -482,6 +503,7 @@ protected:
 	bool                    m_debugger_access;  // treat accesses as coming from the debugger
 	bool                    m_log_unmap;        // log unmapped accesses in this space?
 	auto_pointer<direct_read_data> m_direct;    // fast direct-access read info
+	auto_pointer<memory_access_stats> m_stats;  // access counters, or NULL if not gathering statistics
 	const char *            m_name;             // friendly name of the address space
 	UINT8                   m_addrchars;        // number of characters to use for physical addresses
 	UINT8                   m_logaddrchars;     // number of characters to use for logical addresses
@@ -742,11 +764,16 @@ public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	address_space *first_space() const { return m_spacelist.first(); }
+	memory_bank *first_bank() const { return m_banklist.first(); }
 	memory_region *first_region() const { return m_regionlist.first(); }
 
 	// dump the internal memory tables to the given file
 	void dump(FILE *file);
 
+	// access statistics
+	void enable_access_stats(bool enable = true);
+	void dump_access_stats();
+
 	// pointers to a bank pointer (internal usage only)
 	UINT8 **bank_pointer_addr(UINT8 index, bool decrypted = false) { return decrypted ? &m_bankd_ptr[index] : &m_bank_ptr[index]; }
 
@@ -756,11 +783,11 @@ public:
 
 private:
 	// internal helpers
-	memory_bank *first_bank() const { return m_banklist.first(); }
 	memory_bank *bank(const char *tag) const { return m_banklist.find(tag); }
 	memory_region *region(const char *tag) { return m_regionlist.find(tag); }
 	memory_share *shared(const char *tag) { return m_sharelist.find(tag); }
 	void bank_reattach();
+	void exit();
 
 	// internal state
 	running_machine &           m_machine;              // reference to the machine
@@ -909,7 +909,18 @@ file_error emu_file::load__7zped_file()
 }
 
 retro_buffer_writer::retro_buffer_writer()
-        : m_vector()
+        : m_vector(),
+          m_target(NULL),
+          m_capacity(0),
+          m_position(0)
+{
+}
+
+retro_buffer_writer::retro_buffer_writer(void *data, UINT32 size)
+        : m_vector(),
+          m_target((char *)data),
+          m_capacity(size),
+          m_position(0)
 {
 }
 
@@ -920,17 +931,32 @@ retro_buffer_writer::~retro_buffer_writer()
 UINT32 retro_buffer_writer::write(const void *buffer, UINT32 length)
 {
 	char* buf = (char*)buffer;
+
+	// fixed buffer: copy what fits, the short count reports the overflow
+	if (m_target != NULL)
+	{
+		if (length > m_capacity - m_position)
+			length = m_capacity - m_position;
+		memcpy(m_target + m_position, buf, length);
+		m_position += length;
+		return length;
+	}
+
         m_vector.insert(m_vector.end(), buf, buf + length);
         return length;
 }
 
 char* retro_buffer_writer::data()
 {
+	if (m_target != NULL)
+		return m_target;
 	return m_vector.data();
 }
 
 size_t retro_buffer_writer::size()
 {
+	if (m_target != NULL)
+		return m_position;
 	return m_vector.size();
 }
 
@@ -175,12 +175,15 @@ private:
 /*
 Generic class to write data into a buffer.
 Made along the lines of emu_file with a compatible write method.
-Use a std::vector to store data.
+By default a std::vector is used to store data; when constructed
+with a caller-provided buffer, data is written straight into it and
+writes past its end are truncated.
 */
 class retro_buffer_writer
 {
 public:
         retro_buffer_writer();
+        retro_buffer_writer(void *data, UINT32 size);
         virtual ~retro_buffer_writer();
 
         // writing
@@ -188,7 +191,10 @@ public:
 	size_t size();
 	char* data();
 private:
-        std::vector<char>     m_vector;  // the actual buffer
+        std::vector<char>     m_vector;  // the growable buffer
+        char *                m_target;  // caller-provided buffer, or NULL
+        UINT32                m_capacity; // size of the caller-provided buffer
+        UINT32                m_position; // bytes written to the caller-provided buffer
 };
 
 
@@ -370,6 +370,7 @@ enum ioport_type
 		IPT_UI_LOAD_STATE,
 		IPT_UI_QUICK_SAVE,
 		IPT_UI_QUICK_LOAD,
+		IPT_UI_REWIND_SINGLE,
 		IPT_UI_TAPE_START,
 		IPT_UI_TAPE_STOP,
 
@@ -166,6 +166,8 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 	// fetch core options
 	if (options().debug())
 		debug_flags = (DEBUG_FLAG_ENABLED | DEBUG_FLAG_CALL_HOOK) | (DEBUG_FLAG_OSD_ENABLED);
+	if (options().idle_detect())
+		debug_flags |= DEBUG_FLAG_IDLE_HOOK;
 }
 
 
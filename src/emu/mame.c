@@ -340,10 +340,19 @@ void retro_finish(){
 	printf("retro_finish end\n");
 }
 
+/* Called by libretro to get the exact size of a saved state */
+size_t retro_save_state_size()
+{
+	return retro_global_machine->save().state_size();
+}
+
 /* Called by libretro to save the state on a buffer */
-void retro_save_state(retro_buffer_writer &buf)
+bool retro_save_state(retro_buffer_writer &buf)
 {
-	retro_global_machine->save().retro_write_file(buf);
+	save_error r = retro_global_machine->save().retro_write_file(buf);
+	if (r == STATERR_NONE ) return true;
+	printf("retro_save_state error: %d \n", r);
+	return false;
 }
 
 /* Called by libretro to load a state from a buffer */
@@ -239,6 +239,7 @@ public:
 
 	// return a pointer to the backing RAM at the given offset
 	UINT8 *ramptr(offs_t offset = 0) const { return *m_rambaseptr + offset; }
+	UINT8 **rambaseptr() const { return m_rambaseptr; }
 
 	// see if we are an exact match to the given parameters
 	bool matches_exactly(offs_t bytestart, offs_t byteend, offs_t bytemask) const
@@ -502,6 +503,7 @@ class address_table
 	static const int SUBTABLE_BASE  = TOTAL_MEMORY_BANKS - SUBTABLE_COUNT;     // first index of a subtable
 	static const int ENTRY_COUNT    = SUBTABLE_BASE;            // number of legitimate (non-subtable) entries
 	static const int SUBTABLE_ALLOC = 8;                        // number of subtables to allocate at a time
+	static const int PAGE_COUNT_BITS = 14;                      // maximum number of address bits in the page table
 
 	inline int level2_bits() const { return m_large ? LEVEL2_BITS : 0; }
 
@@ -546,7 +548,21 @@ public:
 	}
 
 	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; invalidate_pages(); }
+
+	// a direct page maps a whole page of RAM/ROM; handler pages point at a NULL base
+	struct direct_page
+	{
+		UINT8 **            m_base;                     // pointer to the bank base pointer
+		offs_t              m_offset;                   // add to a byte address to get the offset from the base
+	};
+
+	// direct page lookups
+	const direct_page &page(offs_t byteaddress) const { return m_pages[byteaddress >> m_page_shift]; }
+	bool page_unfilled(const direct_page &page) const { return (page.m_base == &s_page_unfilled); }
+	void fill_page(offs_t byteaddress);
+	void invalidate_pages();
+	void invalidate_pages(offs_t bytestart, offs_t byteend);
 
 	// table mapping helpers
 	void map_range(offs_t bytestart, offs_t byteend, offs_t bytemask, offs_t bytemirror, UINT16 staticentry);
@@ -602,6 +618,14 @@ protected:
 	// static global read-only watchpoint table
 	static UINT16           s_watchpoint_table[1 << LEVEL1_BITS];
 
+	// direct pages, filled on first use after each change to the table
+	void allocate_pages();
+	void invalidate_bank_pages(UINT8 **base);
+	dynamic_array<direct_page> m_pages;                 // one entry per page of the space; empty for setoffset tables
+	int                     m_page_shift;               // byte address bits within a page
+	static UINT8 *          s_page_unfilled;            // base of pages not yet examined
+	static UINT8 *          s_page_handler;             // base of pages that need a handler lookup
+
 private:
 	int handler_refcount[SUBTABLE_BASE-STATIC_COUNT];
 	UINT16 handler_next_free[SUBTABLE_BASE-STATIC_COUNT];
@@ -687,7 +711,8 @@ private:
 	template<typename _UintType>
 	_UintType watchpoint_r(address_space &space, offs_t offset, _UintType mask)
 	{
-		m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
+		if (m_space.device().debug() != NULL)
+			m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
 
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = m_table;
@@ -696,6 +721,8 @@ private:
 		if (sizeof(_UintType) == 2) result = m_space.read_word(offset << 1, mask);
 		if (sizeof(_UintType) == 4) result = m_space.read_dword(offset << 2, mask);
 		if (sizeof(_UintType) == 8) result = m_space.read_qword(offset << 3, mask);
+		if ((m_space.machine().debug_flags & DEBUG_FLAG_IDLE_HOOK) != 0)
+			device_execute_interface::idle_memory_read(m_space, offset * sizeof(_UintType), sizeof(_UintType), result);
 		m_live_lookup = oldtable;
 		return result;
 	}
@@ -757,7 +784,8 @@ private:
 	template<typename _UintType>
 	void watchpoint_w(address_space &space, offs_t offset, _UintType data, _UintType mask)
 	{
-		m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
+		if (m_space.device().debug() != NULL)
+			m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
 
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = m_table;
@@ -765,6 +793,8 @@ private:
 		if (sizeof(_UintType) == 2) m_space.write_word(offset << 1, data, mask);
 		if (sizeof(_UintType) == 4) m_space.write_dword(offset << 2, data, mask);
 		if (sizeof(_UintType) == 8) m_space.write_qword(offset << 3, data, mask);
+		if ((m_space.machine().debug_flags & DEBUG_FLAG_IDLE_HOOK) != 0)
+			device_execute_interface::idle_memory_write(m_space, offset * sizeof(_UintType), sizeof(_UintType));
 		m_live_lookup = oldtable;
 	}
 
@@ -823,6 +853,76 @@ private:
 };
 
 
+// ======================> memory_access_stats
+
+// access counters for one address space, gathered when memory statistics are enabled
+class memory_access_stats
+{
+	static const int PAGE_BITS      = 12;                       // number of address bits in a counted page
+	static const int BLOCK_BITS     = 10;                       // number of page bits in a lazily allocated block
+
+public:
+	// a count of accesses and the profile ticks spent in handlers for them
+	struct counter
+	{
+		UINT64              m_count;
+		UINT64              m_ticks;
+	};
+
+	// read and write counters for a page
+	struct page_counter
+	{
+		counter             m_read;
+		counter             m_write;
+	};
+
+	// construction/destruction
+	memory_access_stats(offs_t bytemask)
+		: m_blocks(((bytemask >> PAGE_BITS) >> BLOCK_BITS) + 1)
+	{
+		memset(m_read, 0, sizeof(m_read));
+		memset(m_write, 0, sizeof(m_write));
+		for (int blocknum = 0; blocknum < m_blocks.count(); blocknum++)
+			m_blocks[blocknum] = NULL;
+	}
+	~memory_access_stats()
+	{
+		for (int blocknum = 0; blocknum < m_blocks.count(); blocknum++)
+			global_free_array(m_blocks[blocknum]);
+	}
+
+	// record accesses
+	void read(UINT32 entry, offs_t byteaddress, UINT64 ticks) { add(m_read[entry], ticks); add(page(byteaddress).m_read, ticks); }
+	void write(UINT32 entry, offs_t byteaddress, UINT64 ticks) { add(m_write[entry], ticks); add(page(byteaddress).m_write, ticks); }
+
+	// page lookup; NULL for pages in blocks that were never touched
+	offs_t page_count() const { return m_blocks.count() << BLOCK_BITS; }
+	offs_t page_address(offs_t pagenum) const { return pagenum << PAGE_BITS; }
+	const page_counter *page_if_touched(offs_t pagenum) const
+	{
+		const page_counter *block = m_blocks[pagenum >> BLOCK_BITS];
+		return (block != NULL) ? &block[pagenum & ((1 << BLOCK_BITS) - 1)] : NULL;
+	}
+
+	// per-entry counters
+	counter                 m_read[TOTAL_MEMORY_BANKS];  // per read handler entry
+	counter                 m_write[TOTAL_MEMORY_BANKS]; // per write handler entry
+
+private:
+	void add(counter &counter, UINT64 ticks) { counter.m_count++; counter.m_ticks += ticks; }
+
+	page_counter &page(offs_t byteaddress)
+	{
+		page_counter *&block = m_blocks[byteaddress >> (PAGE_BITS + BLOCK_BITS)];
+		if (block == NULL)
+			block = global_alloc_array_clear(page_counter, 1 << BLOCK_BITS);
+		return block[(byteaddress >> PAGE_BITS) & ((1 << BLOCK_BITS) - 1)];
+	}
+
+	dynamic_array<page_counter *> m_blocks;             // blocks of page counters
+};
+
+
 // ======================> address_space_specific
 
 // this is a derived class of address_space with specific width, endianness, and table size
@@ -910,8 +1010,18 @@ public:
 	// native read
 	_NativeType read_native(offs_t offset, _NativeType mask)
 	{
-		// look up the handler
+		// RAM and ROM pages are read straight from the backing memory
 		offs_t byteaddress = offset & m_bytemask;
+		const address_table::direct_page &page = m_read.page(byteaddress);
+		UINT8 *base = *page.m_base;
+		if (EXPECTED(base != NULL))
+			return *reinterpret_cast<_NativeType *>(base + (offs_t)(page.m_offset + byteaddress));
+		if (UNEXPECTED(m_read.page_unfilled(page)))
+			m_read.fill_page(byteaddress);
+		if (UNEXPECTED(m_stats != NULL))
+			return read_native_counted(byteaddress, mask);
+
+		// look up the handler
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
 
@@ -930,8 +1040,18 @@ public:
 	// mask-less native read
 	_NativeType read_native(offs_t offset)
 	{
-		// look up the handler
+		// RAM and ROM pages are read straight from the backing memory
 		offs_t byteaddress = offset & m_bytemask;
+		const address_table::direct_page &page = m_read.page(byteaddress);
+		UINT8 *base = *page.m_base;
+		if (EXPECTED(base != NULL))
+			return *reinterpret_cast<_NativeType *>(base + (offs_t)(page.m_offset + byteaddress));
+		if (UNEXPECTED(m_read.page_unfilled(page)))
+			m_read.fill_page(byteaddress);
+		if (UNEXPECTED(m_stats != NULL))
+			return read_native_counted(byteaddress, ~(_NativeType)0);
+
+		// look up the handler
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
 
@@ -950,9 +1070,22 @@ public:
 	// native write
 	void write_native(offs_t offset, _NativeType data, _NativeType mask)
 	{
+		// RAM pages are written straight to the backing memory
+		offs_t byteaddress = offset & m_bytemask;
+		const address_table::direct_page &page = m_write.page(byteaddress);
+		UINT8 *base = *page.m_base;
+		if (EXPECTED(base != NULL))
+		{
+			_NativeType *dest = reinterpret_cast<_NativeType *>(base + (offs_t)(page.m_offset + byteaddress));
+			*dest = (*dest & ~mask) | (data & mask);
+			return;
+		}
+		if (UNEXPECTED(m_write.page_unfilled(page)))
+			m_write.fill_page(byteaddress);
+		if (UNEXPECTED(m_stats != NULL))
+			return write_native_counted(byteaddress, data, mask);
 
 		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
 
@@ -973,9 +1106,21 @@ public:
 	// mask-less native write
 	void write_native(offs_t offset, _NativeType data)
 	{
+		// RAM pages are written straight to the backing memory
+		offs_t byteaddress = offset & m_bytemask;
+		const address_table::direct_page &page = m_write.page(byteaddress);
+		UINT8 *base = *page.m_base;
+		if (EXPECTED(base != NULL))
+		{
+			*reinterpret_cast<_NativeType *>(base + (offs_t)(page.m_offset + byteaddress)) = data;
+			return;
+		}
+		if (UNEXPECTED(m_write.page_unfilled(page)))
+			m_write.fill_page(byteaddress);
+		if (UNEXPECTED(m_stats != NULL))
+			return write_native_counted(byteaddress, data, ~(_NativeType)0);
 
 		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
 
@@ -989,6 +1134,57 @@ public:
 
 	}
 
+	// native read with access statistics; only handlers are timed
+	_NativeType read_native_counted(offs_t byteaddress, _NativeType mask)
+	{
+		// look up the handler
+		UINT32 entry = read_lookup(byteaddress);
+		const handler_entry_read &handler = m_read.handler_read(entry);
+
+		// either read directly from RAM, or call the delegate
+		offs_t offset = handler.byteoffset(byteaddress);
+		if (entry <= STATIC_BANKMAX)
+		{
+			m_stats->read(entry, byteaddress, 0);
+			return *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+		}
+
+		osd_ticks_t start = get_profile_ticks();
+		_NativeType result;
+		if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, mask);
+		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, mask);
+		else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, mask);
+		else if (sizeof(_NativeType) == 8) result = handler.read64(*this, offset >> 3, mask);
+		m_stats->read(entry, byteaddress, get_profile_ticks() - start);
+
+		return result;
+	}
+
+	// native write with access statistics; only handlers are timed
+	void write_native_counted(offs_t byteaddress, _NativeType data, _NativeType mask)
+	{
+		// look up the handler
+		UINT32 entry = write_lookup(byteaddress);
+		const handler_entry_write &handler = m_write.handler_write(entry);
+
+		// either write directly to RAM, or call the delegate
+		offs_t offset = handler.byteoffset(byteaddress);
+		if (entry <= STATIC_BANKMAX)
+		{
+			m_stats->write(entry, byteaddress, 0);
+			_NativeType *dest = reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+			*dest = (*dest & ~mask) | (data & mask);
+			return;
+		}
+
+		osd_ticks_t start = get_profile_ticks();
+		if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, mask);
+		else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, mask);
+		else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, data, mask);
+		else if (sizeof(_NativeType) == 8) handler.write64(*this, offset >> 3, data, mask);
+		m_stats->write(entry, byteaddress, get_profile_ticks() - start);
+	}
+
 	// generic direct read
 	template<typename _TargetType, bool _Aligned>
 	_TargetType read_direct(offs_t address, _TargetType mask)
@@ -1327,6 +1523,8 @@ typedef address_space_specific<UINT64, ENDIANNESS_BIG,    true> address_space_64
 
 // global watchpoint table
 UINT16 address_table::s_watchpoint_table[1 << LEVEL1_BITS];
+UINT8 *address_table::s_page_unfilled = NULL;
+UINT8 *address_table::s_page_handler = NULL;
 
 
 
@@ -1400,6 +1598,13 @@ void memory_manager::initialize()
 	// register a callback to reset banks when reloading state
 	machine().save().register_postload(save_prepost_delegate(FUNC(memory_manager::bank_reattach), this));
 
+	// gather access statistics if requested, and report them at exit
+	if (machine().options().memstats())
+	{
+		enable_access_stats();
+		machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(memory_manager::exit), this));
+	}
+
 	// dump the final memory configuration
 	generate_memdump(machine());
 
@@ -1473,6 +1678,40 @@ static void generate_memdump(running_machine &machine)
 }
 
 
+//-------------------------------------------------
+//  enable_access_stats - start or stop counting
+//  accesses in all address spaces
+//-------------------------------------------------
+
+void memory_manager::enable_access_stats(bool enable)
+{
+	for (address_space *space = m_spacelist.first(); space != NULL; space = space->next())
+		space->enable_access_stats(enable);
+}
+
+
+//-------------------------------------------------
+//  dump_access_stats - report the accesses
+//  counted so far in all address spaces
+//-------------------------------------------------
+
+void memory_manager::dump_access_stats()
+{
+	for (address_space *space = m_spacelist.first(); space != NULL; space = space->next())
+		space->dump_access_stats();
+}
+
+
+//-------------------------------------------------
+//  exit - report access statistics at exit
+//-------------------------------------------------
+
+void memory_manager::exit()
+{
+	dump_access_stats();
+}
+
+
 //-------------------------------------------------
 //  bank_reattach - reconnect banks after a load
 //-------------------------------------------------
@@ -1528,6 +1767,110 @@ address_space::~address_space()
 }
 
 
+//-------------------------------------------------
+//  enable_access_stats - start or stop counting
+//  accesses; enabling again clears the counters
+//-------------------------------------------------
+
+void address_space::enable_access_stats(bool enable)
+{
+	m_stats.reset(enable ? global_alloc(memory_access_stats(m_bytemask)) : NULL);
+
+	// counting happens on the handler path, so direct pages are off while enabled
+	read().invalidate_pages();
+	write().invalidate_pages();
+}
+
+
+//-------------------------------------------------
+//  dump_access_stats - report the handlers and
+//  pages this space spends its accesses on
+//-------------------------------------------------
+
+struct access_stats_item
+{
+	UINT32 index;
+	UINT64 count;
+	UINT64 ticks;
+};
+
+static int CLIB_DECL access_stats_compare(const void *item1, const void *item2)
+{
+	const access_stats_item &stats1 = *reinterpret_cast<const access_stats_item *>(item1);
+	const access_stats_item &stats2 = *reinterpret_cast<const access_stats_item *>(item2);
+
+	// most time first, then most accesses
+	if (stats1.ticks != stats2.ticks)
+		return (stats1.ticks > stats2.ticks) ? -1 : 1;
+	if (stats1.count != stats2.count)
+		return (stats1.count > stats2.count) ? -1 : 1;
+	return (stats1.index < stats2.index) ? -1 : (stats1.index > stats2.index);
+}
+
+void address_space::dump_access_stats()
+{
+	const int MAX_PAGES = 32;
+
+	if (m_stats == NULL)
+		return;
+	osd_printf_info("Memory accesses in '%s' %s space:\n", m_device.tag(), m_name);
+
+	// handlers, by time spent and then by count
+	for (int pass = 0; pass < 2; pass++)
+	{
+		address_table &table = (pass == 0) ? static_cast<address_table &>(read()) : static_cast<address_table &>(write());
+		const memory_access_stats::counter *counters = (pass == 0) ? m_stats->m_read : m_stats->m_write;
+		dynamic_array<access_stats_item> items;
+		for (UINT32 entry = 0; entry < TOTAL_MEMORY_BANKS; entry++)
+			if (counters[entry].m_count != 0)
+			{
+				access_stats_item &item = items.append();
+				item.index = entry;
+				item.count = counters[entry].m_count;
+				item.ticks = counters[entry].m_ticks;
+			}
+		if (items.count() == 0)
+			continue;
+		qsort(&items[0], items.count(), sizeof(items[0]), access_stats_compare);
+
+		osd_printf_info("  %s handlers:%16s%16s\n", (pass == 0) ? "read" : "write", "accesses", "ticks");
+		for (int itemnum = 0; itemnum < items.count(); itemnum++)
+		{
+			handler_entry &handler = table.handler(items[itemnum].index);
+			osd_printf_info("    %s-%s%16" I64FMT "u%16" I64FMT "u  %s\n",
+					core_i64_hex_format(handler.bytestart(), m_addrchars), core_i64_hex_format(handler.byteend(), m_addrchars),
+					items[itemnum].count, items[itemnum].ticks, table.handler_name(items[itemnum].index));
+		}
+	}
+
+	// the busiest pages, reads and writes combined
+	dynamic_array<access_stats_item> items;
+	for (offs_t pagenum = 0; pagenum < m_stats->page_count(); pagenum++)
+	{
+		const memory_access_stats::page_counter *page = m_stats->page_if_touched(pagenum);
+		if (page != NULL && page->m_read.m_count + page->m_write.m_count != 0)
+		{
+			access_stats_item &item = items.append();
+			item.index = pagenum;
+			item.count = page->m_read.m_count + page->m_write.m_count;
+			item.ticks = page->m_read.m_ticks + page->m_write.m_ticks;
+		}
+	}
+	if (items.count() == 0)
+		return;
+	qsort(&items[0], items.count(), sizeof(items[0]), access_stats_compare);
+
+	osd_printf_info("  busiest pages:%16s%16s%16s\n", "reads", "writes", "ticks");
+	for (int itemnum = 0; itemnum < MIN(items.count(), MAX_PAGES); itemnum++)
+	{
+		const memory_access_stats::page_counter *page = m_stats->page_if_touched(items[itemnum].index);
+		osd_printf_info("    %s%16" I64FMT "u%16" I64FMT "u%16" I64FMT "u\n",
+				core_i64_hex_format(m_stats->page_address(items[itemnum].index), m_addrchars),
+				page->m_read.m_count, page->m_write.m_count, items[itemnum].ticks);
+	}
+}
+
+
 //-------------------------------------------------
 //  allocate - static smart allocator of subtypes
 //-------------------------------------------------
@@ -2479,7 +2822,8 @@ address_table::address_table(address_space &space, bool large)
 		m_space(space),
 		m_large(large),
 		m_subtable(SUBTABLE_COUNT),
-		m_subtable_alloc(0)
+		m_subtable_alloc(0),
+		m_page_shift(0)
 {
 	// make our static table all watchpoints
 	if (s_watchpoint_table[0] != STATIC_WATCHPOINT)
@@ -2532,7 +2876,12 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 	// configure the entry to our parameters (but not for static non-banked cases)
 	handler_entry &curentry = handler(entry);
 	if (entry <= STATIC_BANKMAX || entry >= STATIC_COUNT)
+	{
+		// a bank that moves takes its existing direct pages with it
+		if (entry >= STATIC_BANK1 && entry <= STATIC_BANKMAX && !curentry.matches_exactly(bytestart, byteend, bytemask))
+			invalidate_bank_pages(curentry.rambaseptr());
 		curentry.configure(bytestart, byteend, bytemask);
+	}
 
 	// populate it
 	populate_range_mirrored(bytestart, byteend, bytemirror, entry);
@@ -2778,6 +3127,9 @@ void address_table::populate_range(offs_t bytestart, offs_t byteend, UINT16 hand
 	if (bytestart > byteend)
 		return;
 
+	// the direct pages over the range must be looked at again
+	invalidate_pages(bytestart, byteend);
+
 	// handle the starting edge if it's not on a block boundary
 	if (l2start != 0)
 	{
@@ -2910,6 +3262,7 @@ void address_table::populate_range_mirrored(offs_t bytestart, offs_t byteend, of
 
 				// set the new value and short-circuit the mapping step
 				m_table[cur_index] = m_table[prev_index];
+				invalidate_pages(cur_index << level2_bits(), (cur_index << level2_bits()) | ((1 << level2_bits()) - 1));
 				continue;
 			}
 			prev_index = cur_index;
@@ -3040,6 +3393,106 @@ void address_table::mask_all_handlers(offs_t mask)
 	// we don't loop over map entries because the mask applies to static handlers as well
 	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
 		handler(entrynum).apply_mask(mask);
+	invalidate_pages();
+}
+
+
+//-------------------------------------------------
+//  allocate_pages - size the direct page table
+//  so each page covers an equal slice of the
+//  space; only read and write tables have one
+//-------------------------------------------------
+
+void address_table::allocate_pages()
+{
+	int addrbits = 0;
+	while (addrbits < 32 && (m_space.bytemask() >> addrbits) != 0)
+		addrbits++;
+	m_page_shift = MAX(addrbits - PAGE_COUNT_BITS, 0);
+	m_pages.resize((m_space.bytemask() >> m_page_shift) + 1);
+	invalidate_pages();
+}
+
+
+//-------------------------------------------------
+//  invalidate_pages - forget all direct pages;
+//  they are refilled as they are accessed
+//-------------------------------------------------
+
+void address_table::invalidate_pages()
+{
+	invalidate_pages(0, m_space.bytemask());
+}
+
+
+//-------------------------------------------------
+//  invalidate_pages - forget the direct pages
+//  that overlap a byte range
+//-------------------------------------------------
+
+void address_table::invalidate_pages(offs_t bytestart, offs_t byteend)
+{
+	if (m_pages.count() == 0)
+		return;
+
+	// while watchpoints or statistics are live every access must go through the handlers
+	UINT8 **base = (watchpoints_enabled() || m_space.m_stats != NULL) ? &s_page_handler : &s_page_unfilled;
+	offs_t pagestart = (bytestart & m_space.bytemask()) >> m_page_shift;
+	offs_t pageend = (byteend & m_space.bytemask()) >> m_page_shift;
+	for (offs_t pagenum = pagestart; pagenum <= pageend; pagenum++)
+		m_pages[pagenum].m_base = base;
+}
+
+
+//-------------------------------------------------
+//  invalidate_bank_pages - forget the direct
+//  pages that map through a given bank
+//-------------------------------------------------
+
+void address_table::invalidate_bank_pages(UINT8 **base)
+{
+	for (int pagenum = 0; pagenum < m_pages.count(); pagenum++)
+		if (m_pages[pagenum].m_base == base)
+			m_pages[pagenum].m_base = &s_page_unfilled;
+}
+
+
+//-------------------------------------------------
+//  fill_page - decide whether the page holding
+//  the given address can be accessed directly
+//-------------------------------------------------
+
+void address_table::fill_page(offs_t byteaddress)
+{
+	direct_page &page = m_pages[byteaddress >> m_page_shift];
+	offs_t pagemask = (1 << m_page_shift) - 1;
+	offs_t pagestart = byteaddress & ~pagemask;
+	offs_t pageend = pagestart | pagemask;
+	page.m_base = &s_page_handler;
+
+	// the whole page must map to a single entry
+	UINT16 entry = lookup_live_nowp(pagestart);
+	for (offs_t curaddr = pagestart; curaddr < pageend; )
+	{
+		// large tables let us skip over level 1 entries without a subtable
+		offs_t nextaddr = curaddr + 1;
+		if (m_large && m_table[level1_index_large(curaddr)] < SUBTABLE_BASE)
+			nextaddr = (curaddr | ((1 << LEVEL2_BITS) - 1)) + 1;
+		if (nextaddr == 0 || nextaddr > pageend)
+			break;
+		if (lookup_live_nowp(nextaddr) != entry)
+			return;
+		curaddr = nextaddr;
+	}
+
+	// which must be a bank that maps the page linearly
+	if (entry < STATIC_BANK1 || entry > STATIC_BANKMAX)
+		return;
+	handler_entry &curentry = handler(entry);
+	if (curentry.rambaseptr() == NULL || (curentry.bytemask() & pagemask) != pagemask || ((pagestart - curentry.bytestart()) & pagemask) != 0)
+		return;
+	page.m_base = curentry.rambaseptr();
+	page.m_offset = curentry.byteoffset(pagestart) - pagestart;
 }
 
 
@@ -3325,6 +3778,9 @@ address_table_read::address_table_read(address_space &space, bool large)
 	m_handlers[STATIC_UNMAP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_NOP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_WATCHPOINT]->configure(0, space.bytemask(), ~0);
+
+	// start with every direct page unfilled
+	allocate_pages();
 }
 
 
@@ -3399,6 +3855,9 @@ address_table_write::address_table_write(address_space &space, bool large)
 	m_handlers[STATIC_UNMAP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_NOP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_WATCHPOINT]->configure(0, space.bytemask(), ~0);
+
+	// start with every direct page unfilled
+	allocate_pages();
 }
 
 
@@ -3441,6 +3900,7 @@ direct_read_data::direct_read_data(address_space &space)
 		m_byteend(0),
 		m_entry(STATIC_UNMAP)
 {
+	flush_cache();
 }
 
 
@@ -3471,6 +3931,24 @@ bool direct_read_data::set_direct_region(offs_t &byteaddress)
 		byteaddress = overrideaddress;
 	}
 
+	// without overrides, look for a recently used range first
+	cache_entry *set = NULL;
+	if (m_directupdate.isnull())
+	{
+		set = m_cache[(overrideaddress >> CACHE_SHIFT) & (CACHE_SETS - 1)];
+		for (int way = 0; way < CACHE_WAYS; way++)
+			if (overrideaddress >= set[way].m_bytestart && overrideaddress <= set[way].m_byteend)
+			{
+				// move it to the front of the set
+				cache_entry hit = set[way];
+				for ( ; way > 0; way--)
+					set[way] = set[way - 1];
+				set[0] = hit;
+				configure_bank(hit);
+				return true;
+			}
+	}
+
 	// remove the masked bits (we'll put them back later)
 	offs_t maskedbits = overrideaddress & ~m_bytemask;
 
@@ -3486,20 +3964,66 @@ bool direct_read_data::set_direct_region(offs_t &byteaddress)
 		return false;
 	}
 
+	// describe the range
+	const handler_entry_read &handler = m_space.read().handler_read(m_entry);
+	cache_entry newentry;
+	newentry.m_bytestart = maskedbits | range->m_bytestart;
+	newentry.m_byteend = maskedbits | range->m_byteend;
+	newentry.m_bytemask = handler.bytemask();
+	newentry.m_baseoffs = handler.bytestart() & newentry.m_bytemask;
+	newentry.m_entry = m_entry;
+
+	// remember it in place of the least recently used one
+	if (set != NULL)
+	{
+		for (int way = CACHE_WAYS - 1; way > 0; way--)
+			set[way] = set[way - 1];
+		set[0] = newentry;
+	}
+
+	configure_bank(newentry);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  configure_bank - make a bank range the live
+//  direct range
+//-------------------------------------------------
+
+void direct_read_data::configure_bank(const cache_entry &entry)
+{
 	// if no decrypted opcodes, point to the same base
-	UINT8 *base = *m_space.manager().bank_pointer_addr(m_entry, false);
-	UINT8 *based = *m_space.manager().bank_pointer_addr(m_entry, true);
+	UINT8 *base = *m_space.manager().bank_pointer_addr(entry.m_entry, false);
+	UINT8 *based = *m_space.manager().bank_pointer_addr(entry.m_entry, true);
 	if (based == NULL)
 		based = base;
 
-	// compute the adjusted base
-	const handler_entry_read &handler = m_space.read().handler_read(m_entry);
-	m_bytemask = handler.bytemask();
-	m_raw = base - (handler.bytestart() & m_bytemask);
-	m_decrypted = based - (handler.bytestart() & m_bytemask);
-	m_bytestart = maskedbits | range->m_bytestart;
-	m_byteend = maskedbits | range->m_byteend;
-	return true;
+	// compute the adjusted base; the pointers are read fresh so bank switches need no flush
+	m_entry = entry.m_entry;
+	m_bytemask = entry.m_bytemask;
+	m_raw = base - entry.m_baseoffs;
+	m_decrypted = based - entry.m_baseoffs;
+	m_bytestart = entry.m_bytestart;
+	m_byteend = entry.m_byteend;
+}
+
+
+//-------------------------------------------------
+//  flush_cache - forget the recently used ranges,
+//  either all of them or those of one entry
+//-------------------------------------------------
+
+void direct_read_data::flush_cache(int if_match)
+{
+	for (int setnum = 0; setnum < CACHE_SETS; setnum++)
+		for (int way = 0; way < CACHE_WAYS; way++)
+			if (if_match == -1 || m_cache[setnum][way].m_entry == if_match)
+			{
+				m_cache[setnum][way].m_bytestart = 1;
+				m_cache[setnum][way].m_byteend = 0;
+				m_cache[setnum][way].m_entry = STATIC_INVALID;
+			}
 }
 
 
@@ -3540,6 +4064,9 @@ direct_read_data::direct_range *direct_read_data::find_range(offs_t byteaddress,
 
 void direct_read_data::remove_intersecting_ranges(offs_t bytestart, offs_t byteend)
 {
+	// cached copies may refer to ranges we're about to recycle
+	flush_cache();
+
 	// loop over all entries
 	for (int entry = 0; entry < ARRAY_LENGTH(m_rangelist); entry++)
 	{
@@ -3569,6 +4096,7 @@ direct_update_delegate direct_read_data::set_direct_update(direct_update_delegat
 {
 	direct_update_delegate old = m_directupdate;
 	m_directupdate = function;
+	flush_cache();
 	return old;
 }
 
@@ -100,6 +100,7 @@ public:
 #endif
 	}
 	const char *text(running_machine &machine);
+	osd_ticks_t data(profile_type type) const { return m_data[type]; }
 
 	// enable/disable
 	void enable(bool state = true)
@@ -113,6 +114,7 @@ public:
 	// start/stop
 	void start(profile_type type) { if (enabled()) real_start(type); }
 	void stop() { if (enabled()) real_stop(); }
+	void clear() { memset(m_data, 0, sizeof(m_data)); }
 
 private:
 	void reset(bool enabled);
@@ -191,6 +193,7 @@ public:
 	// getters
 	bool enabled() const { return false; }
 	const char *text(running_machine &machine) { return ""; }
+	osd_ticks_t data(profile_type type) const { return 0; }
 
 	// enable/disable
 	void enable(bool state = true) { }
@@ -198,6 +201,7 @@ public:
 	// start/stop
 	void start(profile_type type) { }
 	void stop() { }
+	void clear() { }
 };
 
 
@@ -218,4 +222,12 @@ typedef dummy_profiler_state profiler_state;
 extern profiler_state g_profiler;
 
 
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+const char *profiler_type_name(profile_type type);
+
+
 #endif  /* __PROFILER_H__ */
@@ -1369,6 +1369,70 @@ render_primitive_list &render_target::get_primitives()
 }
 
 
+//-------------------------------------------------
+//  get_passthrough - if the target shows nothing
+//  but a single unrotated, unscaled raster screen,
+//  point texinfo at the screen bitmap and return
+//  its texture format; otherwise return
+//  TEXFORMAT_UNDEFINED
+//-------------------------------------------------
+
+int render_target::get_passthrough(render_texinfo &texinfo)
+{
+	// only a running machine on a plain, unrotated, single-screen view qualifies
+	if (m_manager.machine().phase() < MACHINE_PHASE_RESET || m_orientation != ROT0)
+		return TEXFORMAT_UNDEFINED;
+	if (m_curview->has_art() || m_curview->screens().count() != 1 || !m_curview->layer_enabled(ITEM_LAYER_SCREEN))
+		return TEXFORMAT_UNDEFINED;
+
+	// anything the UI draws has to be composed on top
+	if (is_ui_target() && !m_manager.ui_container().is_empty())
+		return TEXFORMAT_UNDEFINED;
+
+	// the view must contain just the screen, untinted and unrotated
+	layout_view::item *curitem = m_curview->first_item(ITEM_LAYER_SCREEN);
+	if (curitem == NULL || curitem->next() != NULL || curitem->screen() == NULL || curitem->orientation() != ROT0)
+		return TEXFORMAT_UNDEFINED;
+	const render_color &itemcolor = curitem->color();
+	if (itemcolor.r != 1.0f || itemcolor.g != 1.0f || itemcolor.b != 1.0f || itemcolor.a != 1.0f)
+		return TEXFORMAT_UNDEFINED;
+
+	// the container must be free of user adjustments and overlays
+	render_container &container = curitem->screen()->container();
+	if (container.orientation() != ROT0 || container.overlay() != NULL)
+		return TEXFORMAT_UNDEFINED;
+	if (container.xscale() != 1.0f || container.yscale() != 1.0f || container.xoffset() != 0.0f || container.yoffset() != 0.0f)
+		return TEXFORMAT_UNDEFINED;
+
+	// and hold a single opaque quad covering it
+	render_container::item *item = container.first_item();
+	if (item == NULL || item->m_next != NULL || item->type() != CONTAINER_ITEM_QUAD || item->texture() == NULL)
+		return TEXFORMAT_UNDEFINED;
+	const render_bounds &bounds = item->bounds();
+	const render_color &color = item->color();
+	if (bounds.x0 != 0.0f || bounds.y0 != 0.0f || bounds.x1 != 1.0f || bounds.y1 != 1.0f)
+		return TEXFORMAT_UNDEFINED;
+	if (color.r != 1.0f || color.g != 1.0f || color.b != 1.0f || color.a != 1.0f)
+		return TEXFORMAT_UNDEFINED;
+	if (PRIMFLAG_GET_BLENDMODE(item->flags()) != BLENDMODE_NONE)
+		return TEXFORMAT_UNDEFINED;
+
+	// only plain palettized and RGB bitmaps are passed through
+	render_texture *texture = item->texture();
+	if (texture->m_bitmap == NULL || (texture->m_format != TEXFORMAT_PALETTE16 && texture->m_format != TEXFORMAT_RGB32))
+		return TEXFORMAT_UNDEFINED;
+
+	texinfo.base = texture->m_bitmap->raw_pixptr(texture->m_sbounds.min_y, texture->m_sbounds.min_x);
+	texinfo.rowpixels = texture->m_bitmap->rowpixels();
+	texinfo.width = texture->m_sbounds.width();
+	texinfo.height = texture->m_sbounds.height();
+	texinfo.seqid = texture->m_curseq;
+	texinfo.osddata = texture->m_osddata;
+	texinfo.palette = texture->get_adjusted_palette(container);
+	return texture->m_format;
+}
+
+
 //-------------------------------------------------
 //  map_point_container - attempts to map a point
 //  on the specified render_target to the
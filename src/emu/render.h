@@ -633,6 +633,9 @@ public:
 	// get a primitive list
 	render_primitive_list &get_primitives();
 
+	// get the screen bitmap when it can be shown as-is
+	int get_passthrough(render_texinfo &texinfo);
+
 	// hit testing
 	bool map_point_container(INT32 target_x, INT32 target_y, render_container &container, float &container_x, float &container_y);
 	bool map_point_input(INT32 target_x, INT32 target_y, const char *&input_tag, ioport_value &input_mask, float &input_x, float &input_y);
@@ -0,0 +1,266 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    rendsimd.h
+
+    SIMD span kernels for the software renderer. Each kernel converts or
+    blends a contiguous run of 32bpp ARGB source pixels into one of the
+    two destination layouts used by the OSD (RGB565 and XRGB8888), and
+    produces exactly the same pixels as the scalar loops in rendersw.inc.
+
+    The implementation is chosen at compile time, like rgbutil.h: SSE2
+    where it can be assumed, NEON on ARM, and plain C otherwise.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __RENDSIMD_H__
+#define __RENDSIMD_H__
+
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || (defined(_MSC_VER) && defined(PTR64)))
+#include <emmintrin.h>
+#define RENDSIMD_SSE2       1
+#elif (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define RENDSIMD_NEON       1
+#endif
+
+
+/***************************************************************************
+    SCALAR HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    rendsimd_pixel_to_rgb565 - convert one
+    ARGB32 pixel to RGB565
+-------------------------------------------------*/
+
+static inline UINT16 rendsimd_pixel_to_rgb565(UINT32 pix)
+{
+	return (((pix >> 19) & 0x1f) << 11) | (((pix >> 10) & 0x3f) << 5) | ((pix >> 3) & 0x1f);
+}
+
+
+/*-------------------------------------------------
+    rendsimd_blend_pixel_rgb565 - alpha blend one
+    ARGB32 pixel onto an RGB565 pixel
+-------------------------------------------------*/
+
+static inline UINT16 rendsimd_blend_pixel_rgb565(UINT16 dpix, UINT32 pix)
+{
+	UINT32 ta = pix >> 24;
+	if (ta == 0)
+		return dpix;
+	UINT32 invta = 0x100 - ta;
+	UINT32 r = (((pix >> 19) & 0x1f) * ta + ((dpix >> 11) & 0x1f) * invta) >> 8;
+	UINT32 g = (((pix >> 10) & 0x3f) * ta + ((dpix >> 5) & 0x3f) * invta) >> 8;
+	UINT32 b = (((pix >> 3) & 0x1f) * ta + (dpix & 0x1f) * invta) >> 8;
+	return (r << 11) | (g << 5) | b;
+}
+
+
+/*-------------------------------------------------
+    rendsimd_blend_pixel_rgb32 - alpha blend one
+    ARGB32 pixel onto an XRGB8888 pixel
+-------------------------------------------------*/
+
+static inline UINT32 rendsimd_blend_pixel_rgb32(UINT32 dpix, UINT32 pix)
+{
+	UINT32 ta = pix >> 24;
+	if (ta == 0)
+		return dpix;
+	UINT32 invta = 0x100 - ta;
+	UINT32 r = (((pix >> 16) & 0xff) * ta + ((dpix >> 16) & 0xff) * invta) >> 8;
+	UINT32 g = (((pix >> 8) & 0xff) * ta + ((dpix >> 8) & 0xff) * invta) >> 8;
+	UINT32 b = ((pix & 0xff) * ta + (dpix & 0xff) * invta) >> 8;
+	return (r << 16) | (g << 8) | b;
+}
+
+
+
+/***************************************************************************
+    SPAN KERNELS
+***************************************************************************/
+
+/*-------------------------------------------------
+    rendsimd_rgb32_to_rgb565 - convert a run of
+    ARGB32 pixels to RGB565
+-------------------------------------------------*/
+
+static inline void rendsimd_rgb32_to_rgb565(UINT16 *dest, const UINT32 *src, UINT32 count)
+{
+	UINT32 x = 0;
+
+#if defined(RENDSIMD_SSE2)
+	const __m128i mask5 = _mm_set1_epi32(0x1f);
+	const __m128i mask6 = _mm_set1_epi32(0x3f);
+	for ( ; x + 8 <= count; x += 8)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i *)&src[x]);
+		__m128i hi = _mm_loadu_si128((const __m128i *)&src[x + 4]);
+
+		__m128i plo = _mm_or_si128(_mm_or_si128(
+				_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(lo, 19), mask5), 11),
+				_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(lo, 10), mask6), 5)),
+				_mm_and_si128(_mm_srli_epi32(lo, 3), mask5));
+		__m128i phi = _mm_or_si128(_mm_or_si128(
+				_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(hi, 19), mask5), 11),
+				_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(hi, 10), mask6), 5)),
+				_mm_and_si128(_mm_srli_epi32(hi, 3), mask5));
+
+		// sign-extend the low halves so the saturating pack keeps all 16 bits
+		plo = _mm_srai_epi32(_mm_slli_epi32(plo, 16), 16);
+		phi = _mm_srai_epi32(_mm_slli_epi32(phi, 16), 16);
+		_mm_storeu_si128((__m128i *)&dest[x], _mm_packs_epi32(plo, phi));
+	}
+#elif defined(RENDSIMD_NEON)
+	for ( ; x + 8 <= count; x += 8)
+	{
+		// little-endian ARGB32 deinterleaves into B, G, R, A
+		uint8x8x4_t pix = vld4_u8((const uint8_t *)&src[x]);
+		uint16x8_t r = vshlq_n_u16(vmovl_u8(vshr_n_u8(pix.val[2], 3)), 11);
+		uint16x8_t g = vshlq_n_u16(vmovl_u8(vshr_n_u8(pix.val[1], 2)), 5);
+		uint16x8_t b = vmovl_u8(vshr_n_u8(pix.val[0], 3));
+		vst1q_u16(&dest[x], vorrq_u16(vorrq_u16(r, g), b));
+	}
+#endif
+
+	for ( ; x < count; x++)
+		dest[x] = rendsimd_pixel_to_rgb565(src[x]);
+}
+
+
+/*-------------------------------------------------
+    rendsimd_blend_argb32_rgb565 - alpha blend a
+    run of ARGB32 pixels onto RGB565 pixels
+-------------------------------------------------*/
+
+static inline void rendsimd_blend_argb32_rgb565(UINT16 *dest, const UINT32 *src, UINT32 count)
+{
+	UINT32 x = 0;
+
+#if defined(RENDSIMD_SSE2)
+	const __m128i mask5 = _mm_set1_epi32(0x1f);
+	const __m128i mask6 = _mm_set1_epi32(0x3f);
+	const __m128i dmask5 = _mm_set1_epi16(0x1f);
+	const __m128i dmask6 = _mm_set1_epi16(0x3f);
+	const __m128i k256 = _mm_set1_epi16(0x100);
+	for ( ; x + 8 <= count; x += 8)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i *)&src[x]);
+		__m128i hi = _mm_loadu_si128((const __m128i *)&src[x + 4]);
+		__m128i dpix = _mm_loadu_si128((const __m128i *)&dest[x]);
+
+		// narrow the reduced source channels and alpha to 16 bits
+		__m128i sr = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 19), mask5), _mm_and_si128(_mm_srli_epi32(hi, 19), mask5));
+		__m128i sg = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 10), mask6), _mm_and_si128(_mm_srli_epi32(hi, 10), mask6));
+		__m128i sb = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 3), mask5), _mm_and_si128(_mm_srli_epi32(hi, 3), mask5));
+		__m128i ta = _mm_packs_epi32(_mm_srli_epi32(lo, 24), _mm_srli_epi32(hi, 24));
+		__m128i invta = _mm_sub_epi16(k256, ta);
+
+		__m128i dr = _mm_and_si128(_mm_srli_epi16(dpix, 11), dmask5);
+		__m128i dg = _mm_and_si128(_mm_srli_epi16(dpix, 5), dmask6);
+		__m128i db = _mm_and_si128(dpix, dmask5);
+
+		// products stay below 64 * 256, so 16-bit lanes are exact
+		__m128i r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(sr, ta), _mm_mullo_epi16(dr, invta)), 8);
+		__m128i g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(sg, ta), _mm_mullo_epi16(dg, invta)), 8);
+		__m128i b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(sb, ta), _mm_mullo_epi16(db, invta)), 8);
+
+		__m128i result = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+		_mm_storeu_si128((__m128i *)&dest[x], result);
+	}
+#elif defined(RENDSIMD_NEON)
+	const uint16x8_t dmask5 = vdupq_n_u16(0x1f);
+	const uint16x8_t dmask6 = vdupq_n_u16(0x3f);
+	const uint16x8_t k256 = vdupq_n_u16(0x100);
+	for ( ; x + 8 <= count; x += 8)
+	{
+		uint8x8x4_t pix = vld4_u8((const uint8_t *)&src[x]);
+		uint16x8_t dpix = vld1q_u16(&dest[x]);
+		uint8x8_t ta = pix.val[3];
+		uint16x8_t invta = vsubq_u16(k256, vmovl_u8(ta));
+
+		uint16x8_t dr = vandq_u16(vshrq_n_u16(dpix, 11), dmask5);
+		uint16x8_t dg = vandq_u16(vshrq_n_u16(dpix, 5), dmask6);
+		uint16x8_t db = vandq_u16(dpix, dmask5);
+
+		uint16x8_t r = vshrq_n_u16(vmlaq_u16(vmull_u8(vshr_n_u8(pix.val[2], 3), ta), dr, invta), 8);
+		uint16x8_t g = vshrq_n_u16(vmlaq_u16(vmull_u8(vshr_n_u8(pix.val[1], 2), ta), dg, invta), 8);
+		uint16x8_t b = vshrq_n_u16(vmlaq_u16(vmull_u8(vshr_n_u8(pix.val[0], 3), ta), db, invta), 8);
+
+		vst1q_u16(&dest[x], vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b));
+	}
+#endif
+
+	for ( ; x < count; x++)
+		dest[x] = rendsimd_blend_pixel_rgb565(dest[x], src[x]);
+}
+
+
+/*-------------------------------------------------
+    rendsimd_blend_argb32_rgb32 - alpha blend a
+    run of ARGB32 pixels onto XRGB8888 pixels
+-------------------------------------------------*/
+
+static inline void rendsimd_blend_argb32_rgb32(UINT32 *dest, const UINT32 *src, UINT32 count)
+{
+	UINT32 x = 0;
+
+#if defined(RENDSIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i k256 = _mm_set1_epi16(0x100);
+	const __m128i rgbmask = _mm_set1_epi32(0x00ffffff);
+	for ( ; x + 4 <= count; x += 4)
+	{
+		__m128i pix = _mm_loadu_si128((const __m128i *)&src[x]);
+		__m128i dpix = _mm_loadu_si128((const __m128i *)&dest[x]);
+
+		// widen to 16-bit channels, two pixels per register
+		__m128i slo = _mm_unpacklo_epi8(pix, zero);
+		__m128i shi = _mm_unpackhi_epi8(pix, zero);
+		__m128i dlo = _mm_unpacklo_epi8(dpix, zero);
+		__m128i dhi = _mm_unpackhi_epi8(dpix, zero);
+
+		// broadcast each pixel's alpha across its channels
+		__m128i talo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(slo, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3));
+		__m128i tahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(shi, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3));
+
+		// s * ta + d * (256 - ta) never exceeds 255 * 256, so 16-bit lanes are exact
+		__m128i rlo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(slo, talo), _mm_mullo_epi16(dlo, _mm_sub_epi16(k256, talo))), 8);
+		__m128i rhi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(shi, tahi), _mm_mullo_epi16(dhi, _mm_sub_epi16(k256, tahi))), 8);
+		__m128i blended = _mm_and_si128(_mm_packus_epi16(rlo, rhi), rgbmask);
+
+		// fully transparent texels leave the destination untouched
+		__m128i keep = _mm_cmpeq_epi32(_mm_srli_epi32(pix, 24), zero);
+		__m128i result = _mm_or_si128(_mm_and_si128(keep, dpix), _mm_andnot_si128(keep, blended));
+		_mm_storeu_si128((__m128i *)&dest[x], result);
+	}
+#elif defined(RENDSIMD_NEON)
+	const uint16x8_t k256 = vdupq_n_u16(0x100);
+	const uint8x8_t zero = vdup_n_u8(0);
+	for ( ; x + 8 <= count; x += 8)
+	{
+		uint8x8x4_t pix = vld4_u8((const uint8_t *)&src[x]);
+		uint8x8x4_t dpix = vld4_u8((const uint8_t *)&dest[x]);
+		uint8x8_t ta = pix.val[3];
+		uint16x8_t invta = vsubq_u16(k256, vmovl_u8(ta));
+		uint8x8_t keep = vceq_u8(ta, zero);
+		uint8x8x4_t result;
+
+		for (int ch = 0; ch < 3; ch++)
+		{
+			uint8x8_t blended = vshrn_n_u16(vmlaq_u16(vmull_u8(pix.val[ch], ta), vmovl_u8(dpix.val[ch]), invta), 8);
+			result.val[ch] = vbsl_u8(keep, dpix.val[ch], blended);
+		}
+		result.val[3] = vbsl_u8(keep, dpix.val[3], zero);
+		vst4_u8((uint8_t *)&dest[x], result);
+	}
+#endif
+
+	for ( ; x < count; x++)
+		dest[x] = rendsimd_blend_pixel_rgb32(dest[x], src[x]);
+}
+
+#endif  /* __RENDSIMD_H__ */
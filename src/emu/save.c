@@ -20,6 +20,23 @@
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
 
+****************************************************************************
+
+    Rewind history:
+
+    With -rewind, a copy of the state captured at the end of the most
+    recent frame is kept as a reference, and each capture also records
+    a delta back to the frame before, made of records:
+
+    00..03  Number of unchanged bytes to skip
+    04..07  Number of changed bytes that follow
+    08..    Changed bytes, XORed with the reference state
+
+    XORing the newest delta into the reference steps it back one frame,
+    so the history is walked newest first and the oldest deltas can be
+    dropped whenever it outgrows -rewind_capacity. Deltas are native-
+    endian and never leave memory; save states are always complete.
+
 ***************************************************************************/
 
 #include "emu.h"
@@ -44,6 +61,8 @@
 const int SAVE_VERSION      = 2;
 const int HEADER_SIZE       = 32;
 
+const int DELTA_BLOCK_SIZE  = 64;
+
 // Available flags
 enum
 {
@@ -62,7 +81,10 @@ enum
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
-		m_illegal_regs(0)
+		m_illegal_regs(0),
+		m_rewind_enabled(false),
+		m_rewind_capacity(0),
+		m_rewind_bytes(0)
 {
 }
 
@@ -77,7 +99,65 @@ void save_manager::allow_registration(bool allowed)
 	// allow/deny registration
 	m_reg_allowed = allowed;
 	if (!allowed)
+	{
+		compile_plan();
 		dump_registry();
+
+		// the rewind history needs room for the largest delta a frame can produce
+		if (machine().options().rewind() && m_illegal_regs == 0)
+		{
+			m_rewind_enabled = true;
+			m_rewind_capacity = UINT64(machine().options().rewind_capacity()) << 20;
+			m_rewind_scratch.resize(delta_size());
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  compile_plan - flatten the registry once it
+//  is closed: merge entries that are adjacent in
+//  memory into spans and gather the callbacks
+//  into arrays
+//-------------------------------------------------
+
+void save_manager::compile_plan()
+{
+	m_span_list.reset();
+	m_presave_array.reset();
+	m_postload_array.reset();
+
+	UINT32 offset = 0;
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		// assign each entry its offset within the flattened state
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		entry->m_offset = offset;
+		offset += totalsize;
+
+		// extend the previous span if this entry directly follows it
+		if (m_span_list.count() > 0)
+		{
+			state_span &last = m_span_list[m_span_list.count() - 1];
+			if (last.m_data + last.m_size == (UINT8 *)entry->m_data)
+			{
+				last.m_size += totalsize;
+				continue;
+			}
+		}
+
+		state_span &span = m_span_list.append();
+		span.m_data = (UINT8 *)entry->m_data;
+		span.m_offset = entry->m_offset;
+		span.m_size = totalsize;
+	}
+
+	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
+		m_presave_array.append(func);
+	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
+		m_postload_array.append(func);
+
+	LOG(("%d entries compiled into %d spans\n", m_entry_list.count(), m_span_list.count()));
 }
 
 
@@ -221,6 +301,14 @@ save_error save_manager::check_file(running_machine &machine, emu_file &file, co
 
 void save_manager::dispatch_postload()
 {
+	// once registration is closed, walk the compiled array
+	if (!m_reg_allowed)
+	{
+		for (int index = 0; index < m_postload_array.count(); index++)
+			m_postload_array[index]->m_func();
+		return;
+	}
+
 	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
 		func->m_func();
 }
@@ -266,6 +354,9 @@ save_error save_manager::read_file(emu_file &file)
 	// call the post-load functions
 	dispatch_postload();
 
+	// the rewind history led up to a state we just left
+	rewind_reset();
+
 	return STATERR_NONE;
 }
 
@@ -292,21 +383,35 @@ save_error save_manager::retro_read_file(retro_buffer_reader &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
-	// read all the data, flipping if necessary
-	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	// native-endian data is read span by span
+	if (!flip)
 	{
-		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.read(entry->m_data, totalsize) != totalsize)
-			return STATERR_READ_ERROR;
+		for (int index = 0; index < m_span_list.count(); index++)
+		{
+			const state_span &span = m_span_list[index];
+			if (file.read(span.m_data, span.m_size) != span.m_size)
+				return STATERR_READ_ERROR;
+		}
+	}
 
-		// handle flipping
-		if (flip)
+	// otherwise read entry by entry, flipping as we go
+	else
+	{
+		for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		{
+			UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+			if (file.read(entry->m_data, totalsize) != totalsize)
+				return STATERR_READ_ERROR;
 			entry->flip_data();
+		}
 	}
 
 	// call the post-load functions
 	dispatch_postload();
 
+	// the rewind history led up to a state we just left
+	rewind_reset();
+
 	return STATERR_NONE;
 }
 
@@ -318,10 +423,32 @@ save_error save_manager::retro_read_file(retro_buffer_reader &file)
 
 void save_manager::dispatch_presave()
 {
+	// once registration is closed, walk the compiled array
+	if (!m_reg_allowed)
+	{
+		for (int index = 0; index < m_presave_array.count(); index++)
+			m_presave_array[index]->m_func();
+		return;
+	}
+
 	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
 		func->m_func();
 }
 
+//-------------------------------------------------
+//  state_size - return the number of bytes
+//  retro_write_file will produce, computed from
+//  the registry without performing a save
+//-------------------------------------------------
+
+UINT32 save_manager::state_size() const
+{
+	UINT32 totalsize = HEADER_SIZE;
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		totalsize += entry->m_typesize * entry->m_typecount;
+	return totalsize;
+}
+
 //-------------------------------------------------
 //  retro_write_file - writes the data to a buffer
 //-------------------------------------------------
@@ -350,11 +477,11 @@ save_error save_manager::retro_write_file(retro_buffer_writer &file)
 	// call the pre-save functions
 	dispatch_presave();
 
-	// then write all the data
-	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	// then write all the data, one span at a time
+	for (int index = 0; index < m_span_list.count(); index++)
 	{
-		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.write(entry->m_data, totalsize) != totalsize)
+		const state_span &span = m_span_list[index];
+		if (file.write(span.m_data, span.m_size) != span.m_size)
 			return STATERR_WRITE_ERROR;
 	}
 	return STATERR_NONE;
@@ -399,6 +526,194 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  rewind_capture - add the current state to the
+//  rewind history
+//-------------------------------------------------
+
+void save_manager::rewind_capture()
+{
+	if (!m_rewind_enabled)
+		return;
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// the first capture only becomes the reference
+	if (m_snapshot.count() == 0)
+	{
+		m_snapshot.resize(state_size() - HEADER_SIZE);
+		for (int index = 0; index < m_span_list.count(); index++)
+		{
+			const state_span &span = m_span_list[index];
+			memcpy(&m_snapshot[0] + span.m_offset, span.m_data, span.m_size);
+		}
+		return;
+	}
+
+	// a frame that changed nothing has nothing to step back over
+	UINT32 length = write_delta(&m_rewind_scratch[0]);
+	if (length == 0)
+		return;
+
+	rewind_entry &entry = m_rewind_list.append(*global_alloc(rewind_entry(&m_rewind_scratch[0], length)));
+	m_rewind_bytes += length;
+
+	// forget the oldest steps once over capacity, but always keep the newest
+	while (m_rewind_bytes > m_rewind_capacity && m_rewind_list.first() != &entry)
+	{
+		m_rewind_bytes -= m_rewind_list.first()->m_data.count();
+		m_rewind_list.remove(*m_rewind_list.first());
+	}
+}
+
+
+//-------------------------------------------------
+//  rewind_step - step back to the frame before
+//  the newest one in the history; returns false
+//  if there is none
+//-------------------------------------------------
+
+bool save_manager::rewind_step()
+{
+	rewind_entry *entry = m_rewind_list.last();
+	if (entry == NULL)
+		return false;
+
+	read_delta(&entry->m_data[0], entry->m_data.count());
+	m_rewind_bytes -= entry->m_data.count();
+	m_rewind_list.remove(*entry);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  rewind_reset - discard the rewind history
+//-------------------------------------------------
+
+void save_manager::rewind_reset()
+{
+	m_rewind_list.reset();
+	m_rewind_bytes = 0;
+	m_snapshot.reset();
+}
+
+
+//-------------------------------------------------
+//  delta_size - return the largest delta that
+//  write_delta can produce: every other block
+//  of every span changed
+//-------------------------------------------------
+
+UINT32 save_manager::delta_size() const
+{
+	UINT32 totalsize = 0;
+	for (int index = 0; index < m_span_list.count(); index++)
+	{
+		UINT32 blocks = (m_span_list[index].m_size + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE;
+		totalsize += m_span_list[index].m_size + 2 * sizeof(UINT32) * ((blocks + 1) / 2);
+	}
+	return totalsize;
+}
+
+
+//-------------------------------------------------
+//  write_delta - write the blocks that changed
+//  since the reference to a buffer of at least
+//  delta_size() bytes, and make the current
+//  state the new reference; returns the number
+//  of bytes written
+//-------------------------------------------------
+
+UINT32 save_manager::write_delta(UINT8 *dest)
+{
+	UINT8 *start = dest;
+
+	// emit runs of changed blocks; runs never cross a span boundary
+	UINT32 skip = 0;
+	for (int index = 0; index < m_span_list.count(); index++)
+	{
+		const state_span &span = m_span_list[index];
+		UINT32 totalsize = span.m_size;
+		UINT8 *src = span.m_data;
+		UINT8 *ref = &m_snapshot[0] + span.m_offset;
+		UINT32 pos = 0;
+
+		while (pos < totalsize)
+		{
+			// skip over unchanged blocks
+			UINT32 blocksize = MIN(DELTA_BLOCK_SIZE, totalsize - pos);
+			if (memcmp(src + pos, ref + pos, blocksize) == 0)
+			{
+				skip += blocksize;
+				pos += blocksize;
+				continue;
+			}
+
+			// find the end of the changed run
+			UINT32 runstart = pos;
+			while (pos < totalsize)
+			{
+				blocksize = MIN(DELTA_BLOCK_SIZE, totalsize - pos);
+				if (memcmp(src + pos, ref + pos, blocksize) == 0)
+					break;
+				pos += blocksize;
+			}
+
+			// write the record header
+			UINT32 record[2];
+			record[0] = skip;
+			record[1] = pos - runstart;
+			memcpy(dest, record, sizeof(record));
+			dest += sizeof(record);
+			skip = 0;
+
+			// XOR against the reference, then update the reference
+			for (UINT32 i = runstart; i < pos; i++)
+				*dest++ = src[i] ^ ref[i];
+			memcpy(ref + runstart, src + runstart, pos - runstart);
+		}
+	}
+	return dest - start;
+}
+
+
+//-------------------------------------------------
+//  read_delta - XOR a delta into the reference,
+//  stepping it back to the frame before, and
+//  load the result
+//-------------------------------------------------
+
+void save_manager::read_delta(const UINT8 *data, UINT32 length)
+{
+	const UINT8 *end = data + length;
+	UINT32 pos = 0;
+	while (data < end)
+	{
+		UINT32 record[2];
+		memcpy(record, data, sizeof(record));
+		data += sizeof(record);
+
+		pos += record[0];
+		UINT8 *ref = &m_snapshot[0] + pos;
+		for (UINT32 i = 0; i < record[1]; i++)
+			ref[i] ^= data[i];
+		data += record[1];
+		pos += record[1];
+	}
+
+	// then load it
+	for (int index = 0; index < m_span_list.count(); index++)
+	{
+		const state_span &span = m_span_list[index];
+		memcpy(span.m_data, &m_snapshot[0] + span.m_offset, span.m_size);
+	}
+
+	// call the post-load functions
+	dispatch_postload();
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -482,6 +797,18 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 }
 
 
+//-------------------------------------------------
+//  rewind_entry - constructor
+//-------------------------------------------------
+
+save_manager::rewind_entry::rewind_entry(const UINT8 *data, UINT32 length)
+	: m_next(NULL)
+{
+	m_data.resize(length);
+	memcpy(&m_data[0], data, length);
+}
+
+
 //-------------------------------------------------
 //  state_callback - constructor
 //-------------------------------------------------
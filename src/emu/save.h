@@ -172,16 +172,26 @@ public:
 
 	// file processing
 	static save_error check_file(running_machine &machine, emu_file &file, const char *gamename, void (CLIB_DECL *errormsg)(const char *fmt, ...));
+	UINT32 state_size() const;
 	save_error retro_write_file(retro_buffer_writer &file);
 	save_error write_file(emu_file &file);
 	save_error retro_read_file(retro_buffer_reader &file);
 	save_error read_file(emu_file &file);
 
+	// rewind history
+	void rewind_capture();
+	bool rewind_step();
+	void rewind_reset();
+
 private:
 	// internal helpers
 	UINT32 signature() const;
 	void dump_registry() const;
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
+	void compile_plan();
+	UINT32 delta_size() const;
+	UINT32 write_delta(UINT8 *dest);
+	void read_delta(const UINT8 *data, UINT32 length);
 
 	// state callback item
 	class state_callback
@@ -198,6 +208,29 @@ private:
 		save_prepost_delegate m_func;               // delegate
 	};
 
+	// one step back in the rewind history
+	class rewind_entry
+	{
+	public:
+		// construction/destruction
+		rewind_entry(const UINT8 *data, UINT32 length);
+
+		// getters
+		rewind_entry *next() const { return m_next; }
+
+		// state
+		rewind_entry *      m_next;                 // pointer to next entry
+		dynamic_buffer      m_data;                 // delta back to the previous frame
+	};
+
+	// contiguous run of memory covering one or more adjacent entries
+	struct state_span
+	{
+		UINT8 *             m_data;                 // pointer to the first byte
+		UINT32              m_offset;               // offset within the flattened state
+		UINT32              m_size;                 // number of bytes
+	};
+
 	// internal state
 	running_machine &       m_machine;              // reference to our machine
 	bool                    m_reg_allowed;          // are registrations allowed?
@@ -206,6 +239,17 @@ private:
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
 	simple_list<state_callback> m_postload_list;    // list of post-load functions
+
+	dynamic_array<state_span> m_span_list;          // compiled spans, valid once registration is closed
+	dynamic_array<state_callback *> m_presave_array; // compiled pre-save functions
+	dynamic_array<state_callback *> m_postload_array; // compiled post-load functions
+
+	bool                    m_rewind_enabled;       // capture a rewind history?
+	UINT64                  m_rewind_capacity;      // bytes of deltas to keep
+	UINT64                  m_rewind_bytes;         // bytes of deltas kept
+	simple_list<rewind_entry> m_rewind_list;        // deltas, oldest first
+	dynamic_buffer          m_rewind_scratch;       // room for the largest delta
+	dynamic_buffer          m_snapshot;             // state at the newest capture
 };
 
 
@@ -43,7 +43,6 @@ enum
 emu_timer::emu_timer()
 	: m_machine(NULL),
 		m_next(NULL),
-		m_prev(NULL),
 		m_param(0),
 		m_ptr(NULL),
 		m_enabled(false),
@@ -52,7 +51,10 @@ emu_timer::emu_timer()
 		m_start(attotime::zero),
 		m_expire(attotime::never),
 		m_device(NULL),
-		m_id(0)
+		m_id(0),
+		m_heapexpire(attotime::never),
+		m_heapseq(0),
+		m_heapindex(-1)
 {
 }
 
@@ -76,7 +78,6 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	// ensure the entire timer state is clean
 	m_machine = &machine;
 	m_next = NULL;
-	m_prev = NULL;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -92,8 +93,8 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	if (!m_temporary)
 		register_save();
 
-	// insert into the list
-	machine.scheduler().timer_list_insert(*this);
+	// insert into the heap
+	machine.scheduler().timer_heap_insert(*this);
 	return *this;
 }
 
@@ -108,7 +109,6 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	// ensure the entire timer state is clean
 	m_machine = &device.machine();
 	m_next = NULL;
-	m_prev = NULL;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -124,21 +124,21 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	if (!m_temporary)
 		register_save();
 
-	// insert into the list
-	machine().scheduler().timer_list_insert(*this);
+	// insert into the heap
+	machine().scheduler().timer_heap_insert(*this);
 	return *this;
 }
 
 
 //-------------------------------------------------
-//  release - release us from the global list
+//  release - release us from the global heap
 //  management when deallocating
 //-------------------------------------------------
 
 emu_timer &emu_timer::release()
 {
-	// unhook us from the global list
-	machine().scheduler().timer_list_remove(*this);
+	// unhook us from the global heap
+	machine().scheduler().timer_heap_remove(*this);
 	return *this;
 }
 
@@ -156,9 +156,9 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// remove the timer and insert back into the heap
+		machine().scheduler().timer_heap_remove(*this);
+		machine().scheduler().timer_heap_insert(*this);
 	}
 	return old;
 }
@@ -177,7 +177,7 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	if (scheduler.m_callback_timer == this)
 		scheduler.m_callback_timer_modified = true;
 
-	// compute the time of the next firing and insert into the list
+	// compute the time of the next firing and insert into the heap
 	m_param = param;
 	m_enabled = true;
 
@@ -191,8 +191,8 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	m_period = period;
 
 	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	scheduler.timer_heap_remove(*this);
+	scheduler.timer_heap_insert(*this);
 
 	// if this was inserted as the head, abort the current timeslice and resync
 	if (this == scheduler.first_timer())
@@ -233,6 +233,7 @@ attotime emu_timer::remaining() const
 void emu_timer::register_save()
 {
 	// determine our instance number and name
+	device_scheduler &scheduler = machine().scheduler();
 	int index = 0;
 	astring name;
 
@@ -240,18 +241,24 @@ void emu_timer::register_save()
 	if (m_device == NULL)
 	{
 		name = m_callback.name();
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != NULL; curtimer = curtimer->next())
+		for (int heapindex = 0; heapindex < scheduler.m_timer_heap.count(); heapindex++)
+		{
+			emu_timer *curtimer = scheduler.m_timer_heap[heapindex];
 			if (!curtimer->m_temporary && curtimer->m_device == NULL && strcmp(curtimer->m_callback.name(), m_callback.name()) == 0)
 				index++;
+		}
 	}
 
 	// for device timers, it is an index based on the device and timer ID
 	else
 	{
 		name.printf("%s/%d", m_device->tag(), m_id);
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != NULL; curtimer = curtimer->next())
+		for (int heapindex = 0; heapindex < scheduler.m_timer_heap.count(); heapindex++)
+		{
+			emu_timer *curtimer = scheduler.m_timer_heap[heapindex];
 			if (!curtimer->m_temporary && curtimer->m_device != NULL && curtimer->m_device == m_device && curtimer->m_id == m_id)
 				index++;
+		}
 	}
 
 	// save the bits
@@ -276,8 +283,8 @@ inline void emu_timer::schedule_next_period()
 
 	// remove and re-insert us
 	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	scheduler.timer_heap_remove(*this);
+	scheduler.timer_heap_insert(*this);
 }
 
 
@@ -310,16 +317,16 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_executing_device(NULL),
 	m_execute_list(NULL),
 	m_basetime(attotime::zero),
-	m_timer_list(NULL),
+	m_tick_epoch(0),
+	m_timer_sequence(0),
 	m_callback_timer(NULL),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true);
-	m_timer_list->adjust(attotime::never);
+	// add a single never-expiring timer so there is always one in the heap
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -335,8 +342,8 @@ device_scheduler::device_scheduler(running_machine &machine) :
 device_scheduler::~device_scheduler()
 {
 	// remove all timers
-	while (m_timer_list != NULL)
-		m_timer_allocator.reclaim(m_timer_list->release());
+	while (m_timer_heap.count() > 0)
+		m_timer_allocator.reclaim(m_timer_heap[m_timer_heap.count() - 1]->release());
 }
 
 
@@ -364,8 +371,8 @@ attotime device_scheduler::time() const
 bool device_scheduler::can_save() const
 {
 	// if any live temporary timers exit, fail
-	for (emu_timer *timer = m_timer_list; timer != NULL; timer = timer->next())
-		if (timer->m_temporary && !timer->expire().is_never())
+	for (int index = 0; index < m_timer_heap.count(); index++)
+		if (m_timer_heap[index]->m_temporary && !m_timer_heap[index]->expire().is_never())
 		{
 			logerror("Failed save state attempt due to anonymous timers:\n");
 			dump_timers();
@@ -418,15 +425,33 @@ void device_scheduler::timeslice()
 	while (m_basetime >= m_quantum_list.first()->m_expire)
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
+	// the loop below works in scheduler ticks; make sure they are relative to the current second
+	if (UNEXPECTED(m_basetime.seconds != m_tick_epoch))
+		rebase_ticks();
+	attoseconds_t basetick = time_to_tick(m_basetime);
+
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (1)
 	{
+		// keep the epoch within a second of the base time so ticks never overflow
+		if (UNEXPECTED(basetick >= ATTOSECONDS_PER_SECOND))
+		{
+			m_basetime = tick_to_time(basetick);
+			rebase_ticks();
+			basetick = time_to_tick(m_basetime);
+		}
+
+		// stop once the next timer is due
+		attoseconds_t timertick = time_to_tick(m_timer_heap[0]->m_heapexpire);
+		if (basetick >= timertick)
+			break;
+
 		// by default, assume our target is the end of the next quantum
-		attotime target = m_basetime + attotime(0, m_quantum_list.first()->m_actual);
+		attoseconds_t target = basetick + m_quantum_list.first()->m_actual;
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (timertick < target)
+			target = timertick;
 
 		// do we have pending suspension changes?
 		if (m_suspend_changes_pending)
@@ -436,14 +461,24 @@ void device_scheduler::timeslice()
 		for (device_execute_interface *exec = m_execute_list; exec != NULL; exec = exec->m_nextexec)
 		{
 			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds >= exec->m_localtime.seconds))
+			if (EXPECTED(exec->m_suspend == 0 || exec->m_eatcycles))
 			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds - exec->m_localtime.attoseconds;
-				if (delta < 0 && target.seconds > exec->m_localtime.seconds)
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
+				// compute how many attoseconds to execute this CPU; CPUs too far from
+				// the epoch to be expressed in ticks fall back to attotime math
+				attoseconds_t delta;
+				if (EXPECTED(tick_valid(exec->m_localtick)))
+					delta = target - exec->m_localtick;
+				else
+				{
+					attotime targettime = tick_to_time(target);
+					delta = -1;
+					if (targettime.seconds >= exec->m_localtime.seconds)
+					{
+						delta = targettime.attoseconds - exec->m_localtime.attoseconds;
+						if (delta < 0 && targettime.seconds > exec->m_localtime.seconds)
+							delta += ATTOSECONDS_PER_SECOND;
+					}
+				}
 
 				// if we have enough for at least 1 cycle, do the math
 				if (delta >= exec->m_attoseconds_per_cycle)
@@ -463,7 +498,7 @@ void device_scheduler::timeslice()
 							exec->run();
 						else
 						{
-							debugger_start_cpu_hook(&exec->device(), target);
+							debugger_start_cpu_hook(&exec->device(), tick_to_time(target));
 							exec->run();
 							debugger_stop_cpu_hook(&exec->device());
 						}
@@ -475,28 +510,39 @@ void device_scheduler::timeslice()
 						ran -= exec->m_cycles_stolen;
 					}
 
+					// count cycles eaten only because of idle loop detection
+					else if (exec->m_suspend == SUSPEND_REASON_SPIN && exec->m_idle_spinning)
+						exec->m_idle_cycles += ran;
+
 					// account for these cycles
 					exec->m_totalcycles += ran;
 
 					// update the local time for this CPU
-					attotime delta(0, exec->m_attoseconds_per_cycle * ran);
-					assert(delta >= attotime::zero);
-					exec->m_localtime += delta;
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
+					attoseconds_t ranattos = exec->m_attoseconds_per_cycle * ran;
+					assert(ranattos >= 0);
+					if (EXPECTED(tick_valid(exec->m_localtick)))
+						exec->m_localtick += ranattos;
+					else
 					{
-						target = max(exec->m_localtime, m_basetime);
+						exec->m_localtime += attotime(0, ranattos);
+						exec->m_localtick = time_to_tick(exec->m_localtime);
 					}
+
+					// if the new local CPU time is less than our target, move the target up, but not before the base
+					if (exec->m_localtick < target)
+						target = MAX(exec->m_localtick, basetick);
 				}
 			}
 		}
 		m_executing_device = NULL;
 
 		// update the base time
-		m_basetime = target;
+		basetick = target;
 	}
 
+	// convert the base time back once we're done
+	m_basetime = tick_to_time(basetick);
+
 	// execute timers
 	execute_timers();
 }
@@ -636,6 +682,11 @@ void device_scheduler::timed_trigger(void *ptr, INT32 param)
 
 void device_scheduler::presave()
 {
+	// bring the saved local times up to date with the ticks
+	for (device_execute_interface *exec = m_execute_list; exec != NULL; exec = exec->m_nextexec)
+		if (tick_valid(exec->m_localtick))
+			exec->m_localtime = tick_to_time(exec->m_localtick);
+
 	// report the timer state after a log
 	logerror("Prior to saving state:\n");
 	dump_timers();
@@ -648,11 +699,13 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != NULL)
+	// remove all timers in their current order and keep the permanent ones
+	dynamic_array<emu_timer *> sorted;
+	dynamic_array<emu_timer *> permanent;
+	timer_heap_sorted(sorted);
+	for (int index = 0; index < sorted.count(); index++)
 	{
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *sorted[index];
 
 		// temporary timers go away entirely (except our special never-expiring one)
 		if (timer.m_temporary && !timer.expire().is_never())
@@ -660,17 +713,21 @@ void device_scheduler::postload()
 
 		// permanent ones get added to our private list
 		else
-			private_list.append(timer_list_remove(timer));
+			permanent.append(&timer_heap_remove(timer));
 	}
 
 	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != NULL)
-		timer_list_insert(*timer);
+	for (int index = 0; index < permanent.count(); index++)
+		timer_heap_insert(*permanent[index]);
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
 
+	// recompute the ticks from the restored local times
+	m_tick_epoch = m_basetime.seconds;
+	for (device_execute_interface *exec = m_execute_list; exec != NULL; exec = exec->m_nextexec)
+		exec->m_localtick = time_to_tick(exec->m_localtime);
+
 	// report the timer state after a log
 	logerror("After resetting/reordering timers:\n");
 	dump_timers();
@@ -791,68 +848,143 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  timer_heap_before - return true if timer a
+//  fires before timer b; equal expirations fire
+//  in the order they were inserted
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+static inline bool timer_heap_before(const attotime &aexpire, UINT64 aseq, const attotime &bexpire, UINT64 bseq)
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	return (aexpire < bexpire) || (aexpire == bexpire && aseq < bseq);
+}
 
-	// loop over the timer list
-	emu_timer *prevtimer = NULL;
-	for (emu_timer *curtimer = m_timer_list; curtimer != NULL; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
 
-			if (curtimer->m_prev != NULL)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
+//-------------------------------------------------
+//  timer_heap_insert - insert a new timer into
+//  the heap at the appropriate location
+//-------------------------------------------------
 
-			curtimer->m_prev = &timer;
-			return timer;
-		}
-	}
+emu_timer &device_scheduler::timer_heap_insert(emu_timer &timer)
+{
+	assert(timer.m_heapindex == -1);
 
-	// need to insert after the last one
-	if (prevtimer != NULL)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
+	// disabled timers sort to the end; the key is fixed until the timer is re-inserted
+	timer.m_heapexpire = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_heapseq = m_timer_sequence++;
 
-	timer.m_prev = prevtimer;
-	timer.m_next = NULL;
+	// add as the last leaf and float up to our spot
+	timer.m_heapindex = m_timer_heap.count();
+	m_timer_heap.append(&timer);
+	timer_heap_up(timer.m_heapindex);
 	return timer;
 }
 
 
 //-------------------------------------------------
-//  timer_list_remove - remove a timer from the
-//  linked list
+//  timer_heap_remove - remove a timer from the
+//  heap
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
+emu_timer &device_scheduler::timer_heap_remove(emu_timer &timer)
 {
-	// remove it from the list
-	if (timer.m_prev != NULL)
-		timer.m_prev->m_next = timer.m_next;
-	else
-		m_timer_list = timer.m_next;
-
-	if (timer.m_next != NULL)
-		timer.m_next->m_prev = timer.m_prev;
+	int index = timer.m_heapindex;
+	int last = m_timer_heap.count() - 1;
+	assert(index >= 0 && index <= last && m_timer_heap[index] == &timer);
+
+	// move the last leaf into the hole and restore the ordering around it
+	emu_timer *moved = m_timer_heap[last];
+	m_timer_heap.resize_keep(last);
+	if (moved != &timer)
+	{
+		m_timer_heap[index] = moved;
+		moved->m_heapindex = index;
+		timer_heap_up(index);
+		timer_heap_down(moved->m_heapindex);
+	}
 
+	timer.m_heapindex = -1;
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_heap_up - move the timer at the given
+//  index towards the root until it is ordered
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_up(int index)
+{
+	emu_timer *timer = m_timer_heap[index];
+	while (index > 0)
+	{
+		int parent = (index - 1) / 2;
+		emu_timer *ptimer = m_timer_heap[parent];
+		if (!timer_heap_before(timer->m_heapexpire, timer->m_heapseq, ptimer->m_heapexpire, ptimer->m_heapseq))
+			break;
+		m_timer_heap[index] = ptimer;
+		ptimer->m_heapindex = index;
+		index = parent;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heapindex = index;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_down - move the timer at the given
+//  index towards the leaves until it is ordered
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_down(int index)
+{
+	int count = m_timer_heap.count();
+	emu_timer *timer = m_timer_heap[index];
+	while (true)
+	{
+		// pick the earlier of the two children
+		int child = index * 2 + 1;
+		if (child >= count)
+			break;
+		if (child + 1 < count && timer_heap_before(m_timer_heap[child + 1]->m_heapexpire, m_timer_heap[child + 1]->m_heapseq, m_timer_heap[child]->m_heapexpire, m_timer_heap[child]->m_heapseq))
+			child++;
+
+		emu_timer *ctimer = m_timer_heap[child];
+		if (!timer_heap_before(ctimer->m_heapexpire, ctimer->m_heapseq, timer->m_heapexpire, timer->m_heapseq))
+			break;
+		m_timer_heap[index] = ctimer;
+		ctimer->m_heapindex = index;
+		index = child;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heapindex = index;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sorted - return every timer in the
+//  order it will fire, for dumping and for
+//  deterministic re-insertion
+//-------------------------------------------------
+
+int CLIB_DECL device_scheduler::timer_heap_compare(const void *item1, const void *item2)
+{
+	const emu_timer *timer1 = *(const emu_timer * const *)item1;
+	const emu_timer *timer2 = *(const emu_timer * const *)item2;
+	if (timer1 == timer2)
+		return 0;
+	return timer_heap_before(timer1->m_heapexpire, timer1->m_heapseq, timer2->m_heapexpire, timer2->m_heapseq) ? -1 : 1;
+}
+
+void device_scheduler::timer_heap_sorted(dynamic_array<emu_timer *> &sorted) const
+{
+	sorted.resize(m_timer_heap.count());
+	for (int index = 0; index < m_timer_heap.count(); index++)
+		sorted[index] = m_timer_heap[index];
+	if (sorted.count() > 1)
+		qsort(&sorted[0], sorted.count(), sizeof(sorted[0]), timer_heap_compare);
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
@@ -860,10 +992,10 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 inline void device_scheduler::execute_timers()
 {
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (m_timer_heap[0]->m_heapexpire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *m_timer_heap[0];
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -948,6 +1080,25 @@ void device_scheduler::add_scheduling_quantum(const attotime &quantum, const att
 }
 
 
+//-------------------------------------------------
+//  rebase_ticks - move the tick epoch to the
+//  current base time second
+//-------------------------------------------------
+
+void device_scheduler::rebase_ticks()
+{
+	// convert the ticks back to local times against the old epoch
+	for (device_execute_interface *exec = m_execute_list; exec != NULL; exec = exec->m_nextexec)
+		if (tick_valid(exec->m_localtick))
+			exec->m_localtime = tick_to_time(exec->m_localtick);
+
+	// and forward again against the new one
+	m_tick_epoch = m_basetime.seconds;
+	for (device_execute_interface *exec = m_execute_list; exec != NULL; exec = exec->m_nextexec)
+		exec->m_localtick = time_to_tick(exec->m_localtime);
+}
+
+
 //-------------------------------------------------
 //  dump_timers - dump the current timer state
 //-------------------------------------------------
@@ -956,7 +1107,11 @@ void device_scheduler::dump_timers() const
 {
 	logerror("=============================================\n");
 	logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = first_timer(); timer != NULL; timer = timer->next())
-		timer->dump();
+
+	// the heap is only partially ordered, so dump a sorted copy
+	dynamic_array<emu_timer *> sorted;
+	timer_heap_sorted(sorted);
+	for (int index = 0; index < sorted.count(); index++)
+		sorted[index]->dump();
 	logerror("=============================================\n");
 }
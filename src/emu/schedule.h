@@ -67,7 +67,6 @@ class emu_timer
 
 public:
 	// getters
-	emu_timer *next() const { return m_next; }
 	running_machine &machine() const { assert(m_machine != NULL); return *m_machine; }
 	bool enabled() const { return m_enabled; }
 	int param() const { return m_param; }
@@ -96,8 +95,7 @@ private:
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the allocator's free list
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -108,6 +106,9 @@ private:
 	attotime            m_expire;       // time when the timer will expire
 	device_t *          m_device;       // for device timers, a pointer to the device
 	device_timer_id     m_id;           // for device timers, the ID of the timer
+	attotime            m_heapexpire;   // expiration time the heap is ordered by
+	UINT64              m_heapseq;      // insertion sequence; orders equal expirations
+	int                 m_heapindex;    // index within the scheduler's heap, or -1
 };
 
 
@@ -126,7 +127,7 @@ public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
-	emu_timer *first_timer() const { return m_timer_list; }
+	emu_timer *first_timer() const { return (m_timer_heap.count() > 0) ? m_timer_heap[0] : NULL; }
 	device_execute_interface *currently_executing() const { return m_executing_device; }
 	bool can_save() const;
 
@@ -171,9 +172,31 @@ private:
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
 
+	// tick helpers
+	static bool tick_valid(attoseconds_t tick) { return tick > TICK_PAST && tick < TICK_FUTURE; }
+	attoseconds_t time_to_tick(const attotime &time) const
+	{
+		seconds_t secs = time.seconds - m_tick_epoch;
+		if (secs >= TICK_SECONDS) return TICK_FUTURE;
+		if (secs < -TICK_SECONDS) return TICK_PAST;
+		return secs * ATTOSECONDS_PER_SECOND + time.attoseconds;
+	}
+	attotime tick_to_time(attoseconds_t tick) const
+	{
+		seconds_t secs = m_tick_epoch + tick / ATTOSECONDS_PER_SECOND;
+		attoseconds_t attos = tick % ATTOSECONDS_PER_SECOND;
+		if (attos < 0) { attos += ATTOSECONDS_PER_SECOND; secs--; }
+		return attotime(secs, attos);
+	}
+	void rebase_ticks();
+
 	// timer helpers
-	emu_timer &timer_list_insert(emu_timer &timer);
-	emu_timer &timer_list_remove(emu_timer &timer);
+	emu_timer &timer_heap_insert(emu_timer &timer);
+	emu_timer &timer_heap_remove(emu_timer &timer);
+	void timer_heap_up(int index);
+	void timer_heap_down(int index);
+	void timer_heap_sorted(dynamic_array<emu_timer *> &sorted) const;
+	static int CLIB_DECL timer_heap_compare(const void *item1, const void *item2);
 	void execute_timers();
 
 	// internal state
@@ -182,8 +205,16 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// scheduler ticks are plain attoseconds counted from the start of the
+	// epoch second, so the timeslice loop can do its math in 64 bits
+	static const seconds_t      TICK_SECONDS = 8;           // ticks cover +/- this many seconds around the epoch
+	static const attoseconds_t  TICK_PAST = (attoseconds_t)U64(0x8000000000000000); // saturated value for earlier times
+	static const attoseconds_t  TICK_FUTURE = (attoseconds_t)U64(0x7fffffffffffffff); // saturated value for later times
+	seconds_t                   m_tick_epoch;               // second that tick 0 corresponds to
+
+	// binary heap of timers, ordered by expiration time and then insertion
+	dynamic_array<emu_timer *>  m_timer_heap;               // heap array; element 0 expires first
+	UINT64                      m_timer_sequence;           // next insertion sequence number
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -14,10 +14,6 @@
 #include "config.h"
 #include "sound/wavwrite.h"
 
-#include "libretro.h"
-
-extern int retro_pause;
-extern retro_audio_sample_batch_t audio_batch_cb;
 
 
 //**************************************************************************
@@ -1035,11 +1031,7 @@ void sound_manager::update(void *ptr, int param)
 	if (finalmix_offset > 0)
 	{
 		if (!m_nosound_mode)
-      {
-         int samples_this_frame = finalmix_offset / 2;
-         if (retro_pause != -1)
-            audio_batch_cb(finalmix, samples_this_frame);
-      }
+			m_machine.osd().update_audio_stream(finalmix, finalmix_offset / 2);
 
 		if (m_wavfile != NULL)
 			wav_add_data_16(m_wavfile, finalmix, finalmix_offset);
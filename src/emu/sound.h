@@ -225,6 +225,7 @@ public:
 	void debugger_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_DEBUGGER); }
 	void system_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_SYSTEM); }
 	void system_enable(bool turn_on = true) { mute(!turn_on, MUTE_REASON_SYSTEM); }
+	void flush() { update(); }
 
 	// user gain controls
 	bool indexed_mixer_input(int index, mixer_input &info) const;
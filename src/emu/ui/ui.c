@@ -1604,6 +1604,13 @@ UINT32 ui_manager::handler_ingame(running_machine &machine, render_container *co
 		return machine.ui().set_handler(handler_quick_load,0);
 	}
 
+	// handle a rewind request; holding the key steps back a frame at a time
+	if (ui_input_pressed_repeat(machine, IPT_UI_REWIND_SINGLE, 1) && machine.options().rewind())
+	{
+		if (!machine.save().rewind_step())
+			popmessage("No earlier frame to rewind to");
+	}
+
 
 	// handle a toggle cheats request
 	if (ui_input_pressed(machine, IPT_UI_TOGGLE_CHEAT))
@@ -184,6 +184,10 @@ void video_manager::frame_update(bool debug)
       }
    }
 
+	// add the frame to the rewind history
+	if (phase == MACHINE_PHASE_RUNNING && !machine().paused() && !debug)
+		machine().save().rewind_capture();
+
 	// perform tasks for this frame
 	if (!debug)
 		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
@@ -1789,6 +1789,8 @@ void chihiro_state::machine_start()
 	if (machine().debug_flags & DEBUG_FLAG_ENABLED)
 		debug_console_register_command(machine(), "chihiro", CMDFLAG_NONE, 0, 1, 4, chihiro_debug_commands);
 	usbhack_counter = 0;
+	// let the recompiler access main RAM directly
+	downcast<i386_device *>(m_maincpu.target())->i386drc_add_fastram(0x00000000, 0x07ffffff, FALSE, m_maincpu->space(AS_PROGRAM).get_write_ptr(0));
 	// savestates
 	save_item(NAME(debug_irq_active));
 	save_item(NAME(debug_irq_number));
@@ -648,6 +648,9 @@ void dc_state::machine_start()
 	if(m_naomig1)
 		m_naomig1->set_dma_cb(naomi_g1_device::dma_cb(FUNC(dc_state::generic_dma), this));
 
+	// let the recompiler fetch code and data straight from main RAM; its mirrors take the slow path
+	m_maincpu->sh4drc_add_fastram(0x0c000000, 0x0c000000 + dc_ram.bytes() - 1, FALSE, dc_ram);
+
 	// save states
 	save_pointer(NAME(dc_sysctrl_regs), 0x200/4);
 	save_pointer(NAME(g2bus_regs), 0x100/4);
@@ -14,17 +14,6 @@
 #include "libretro.h"
 #include "libretro_shared.h"
 
-/* Empirically, i found that Mame savegames sizes are uniform for a given game,
-that is, they're always the same size as the game progress. Tested on a dozen 
-of different games both news and olds.
-Problem is: looking at the code i can't exclude that at some point a game
-can return a bigger state than the previous (i tried to follow the code but
-it goes too deep into the innards of Mame).
-To account for this, i report a bigger size than the one i got from mame,
-this multiplier tells how much extra space to reserve (currently 
-one and a half). */
-#define SAVE_SIZE_MULTIPLIER 1.5
-
 /* forward decls / externs / prototypes */
 bool retro_load_ok    = false;
 int retro_pause       = 0;
@@ -38,13 +27,25 @@ int SHIFTON           = -1;
 int NEWGAME_FROM_OSD  = 0;
 char RPATH[512];
 
-int serialize_size = 0; // memorize size of serialized savestate
+size_t serialize_size = 0; // memorize size of serialized savestate
 
 static char option_mouse[50];
 static char option_cheats[50];
 static char option_nag[50];
 static char option_info[50];
 static char option_renderer[50];
+static char option_passthrough[50];
+static char option_threaded[50];
+static char option_audio_sync[50];
+static char option_profiler[50];
+static char option_rewind[50];
+static char option_memstats[50];
+static char option_drc_cache[50];
+static char option_idle_detect[50];
+static char option_m68k_drc[50];
+static char option_sh4_drc[50];
+static char option_psx_drc[50];
+static char option_i386_drc[50];
 static char option_warnings[50];
 static char option_osd[50];
 static char option_cli[50];
@@ -64,17 +65,24 @@ const char *retro_system_directory;
 const char *retro_content_directory;
 
 retro_log_printf_t log_cb;
+struct retro_perf_callback perf_cb;
 
 static bool draw_this_frame;
 
 #ifdef M16B
 uint16_t videoBuffer[1600*1200];
 #define LOG_PIXEL_BYTES 1
+#define FB_PIXEL_FORMAT RETRO_PIXEL_FORMAT_RGB565
 #else
 unsigned int videoBuffer[1600*1200];
 #define LOG_PIXEL_BYTES 2*1
+#define FB_PIXEL_FORMAT RETRO_PIXEL_FORMAT_XRGB8888
 #endif
 
+/* buffer the current frame is drawn into: either videoBuffer or
+the one handed out by GET_CURRENT_SOFTWARE_FRAMEBUFFER */
+static void *fb_ptr = videoBuffer;
+
 retro_video_refresh_t video_cb = NULL;
 retro_environment_t environ_cb = NULL;
 
@@ -141,6 +149,18 @@ void retro_set_environment(retro_environment_t cb)
    sprintf(option_info, "%s_%s",core,"hide_infoscreen");
    sprintf(option_warnings,"%s_%s",core,"hide_warnings");
    sprintf(option_renderer,"%s_%s",core,"alternate_renderer");
+   sprintf(option_passthrough,"%s_%s",core,"native_passthrough");
+   sprintf(option_threaded,"%s_%s",core,"threaded_renderer");
+   sprintf(option_audio_sync,"%s_%s",core,"frame_exact_audio");
+   sprintf(option_profiler,"%s_%s",core,"profiler");
+   sprintf(option_rewind,"%s_%s",core,"rewind");
+   sprintf(option_memstats,"%s_%s",core,"memory_stats");
+   sprintf(option_drc_cache,"%s_%s",core,"drc_analysis_cache");
+   sprintf(option_idle_detect,"%s_%s",core,"idle_detection");
+   sprintf(option_m68k_drc,"%s_%s",core,"m68k_recompiler");
+   sprintf(option_sh4_drc,"%s_%s",core,"sh4_recompiler");
+   sprintf(option_psx_drc,"%s_%s",core,"psx_recompiler");
+   sprintf(option_i386_drc,"%s_%s",core,"i386_recompiler");
    sprintf(option_osd,"%s_%s",core,"boot_to_osd");
    sprintf(option_bios,"%s_%s",core,"boot_to_bios");
    sprintf(option_cli,"%s_%s",core,"boot_from_cli");
@@ -172,12 +192,24 @@ void retro_set_environment(retro_environment_t cb)
     { option_auto_save, "Auto save/load states; disabled|enabled" },
     { option_mouse, "XY device (Restart); none|lightgun|mouse" },
     { option_throttle, "Enable throttle; disabled|enabled" },
+    { option_audio_sync, "Frame-exact audio; disabled|enabled" },
+    { option_profiler, "Profiler perf counters; disabled|enabled" },
+    { option_rewind, "Core rewind history, Shift+~ steps back (Restart); disabled|enabled" },
+    { option_memstats, "Memory access statistics (Restart); disabled|enabled" },
+    { option_drc_cache, "DRC analysis cache (Restart); disabled|enabled" },
+    { option_idle_detect, "Idle loop detection (Restart); disabled|enabled" },
+    { option_m68k_drc, "M68000 recompiler (Restart); disabled|enabled" },
+    { option_sh4_drc, "SH4 recompiler (Restart); disabled|enabled" },
+    { option_psx_drc, "PSX recompiler (Restart); disabled|enabled" },
+    { option_i386_drc, "i386 recompiler (Restart); disabled|enabled" },
     { option_cheats, "Enable cheats; disabled|enabled" },
 //  { option_nobuffer, "Nobuffer patch; disabled|enabled" },
     { option_nag, "Hide nag screen; disabled|enabled" },
     { option_info, "Hide gameinfo screen; disabled|enabled" },
     { option_warnings, "Hide warnings screen; disabled|enabled" },
     { option_renderer, "Alternate render method; disabled|enabled" },
+    { option_passthrough, "Native resolution passthrough; disabled|enabled" },
+    { option_threaded, "Multithreaded software renderer; disabled|enabled" },
 
 #if !defined(WANT_PHILIPS_CDI)
     /* ONLY FOR MESS/UME */
@@ -310,6 +342,140 @@ static void check_variables(void)
          alternate_renderer = true;
    }
 
+   var.key   = option_passthrough;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         native_passthrough = false;
+      if (!strcmp(var.value, "enabled"))
+         native_passthrough = true;
+   }
+
+   var.key   = option_threaded;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         threaded_renderer = false;
+      if (!strcmp(var.value, "enabled"))
+         threaded_renderer = true;
+   }
+
+   var.key   = option_audio_sync;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      bool enable = !strcmp(var.value, "enabled");
+
+      /* start from an empty queue whenever the mode flips */
+      if (enable != audio_sync_enable)
+         retro_audio_reset();
+      audio_sync_enable = enable;
+   }
+
+   var.key   = option_rewind;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         rewind_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         rewind_enable = true;
+   }
+
+   var.key   = option_profiler;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      /* the profiler only runs while someone is reading its counters, and
+         only exists at all in PROFILER=1 builds */
+      g_profiler.enable(!strcmp(var.value, "enabled") && perf_cb.perf_register != NULL);
+      profiler_enable = g_profiler.enabled();
+   }
+
+   var.key   = option_memstats;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         memstats_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         memstats_enable = true;
+   }
+
+   var.key   = option_drc_cache;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         drc_cache_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         drc_cache_enable = true;
+   }
+
+   var.key   = option_idle_detect;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         idle_detect_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         idle_detect_enable = true;
+   }
+
+   var.key   = option_m68k_drc;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         m68k_drc_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         m68k_drc_enable = true;
+   }
+
+   var.key   = option_sh4_drc;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         sh4_drc_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         sh4_drc_enable = true;
+   }
+
+   var.key   = option_psx_drc;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         psx_drc_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         psx_drc_enable = true;
+   }
+
+   var.key   = option_i386_drc;
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "disabled"))
+         i386_drc_enable = false;
+      if (!strcmp(var.value, "enabled"))
+         i386_drc_enable = true;
+   }
+
    var.key   = option_osd;
    var.value = NULL;
 
@@ -467,7 +633,7 @@ void retro_get_system_av_info(struct retro_system_av_info *info)
       log_cb(RETRO_LOG_INFO, "AV_INFO: aspect_ratio = %f\n",info->geometry.aspect_ratio);
 
    info->timing.fps            = retro_fps;
-   info->timing.sample_rate    = 48000.0;
+   info->timing.sample_rate    = RETRO_SAMPLE_RATE;
 
    if (log_cb)
       log_cb(RETRO_LOG_INFO, "AV_INFO: fps = %f sample_rate = %f\n",info->timing.fps,info->timing.sample_rate);
@@ -487,6 +653,9 @@ void retro_init (void)
    else
       log_cb = NULL;
 
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_PERF_INTERFACE, &perf_cb))
+      memset(&perf_cb, 0, sizeof(perf_cb));
+
    if (environ_cb(RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY, &system_dir) && system_dir)
    {
       /* if defined, use the system directory */
@@ -542,7 +711,8 @@ int RLOOP=1;
 extern void retro_main_loop();
 
 // save state functions defined in mame.c
-extern void retro_save_state(retro_buffer_writer &buf);
+extern size_t retro_save_state_size();
+extern bool retro_save_state(retro_buffer_writer &buf);
 extern bool retro_load_state(retro_buffer_reader &buf);
 
 void retro_run (void)
@@ -586,7 +756,16 @@ void retro_run (void)
    process_keyboard_state();
    process_joypad_state();
 
-   if(retro_pause==0)retro_main_loop();
+   if(retro_pause==0)
+   {
+      retro_main_loop();
+
+      if (audio_sync_enable)
+         retro_audio_frame(retro_fps, RETRO_SAMPLE_RATE);
+
+      if (profiler_enable)
+         retro_profiler_frame();
+   }
 
    RLOOP=1;
 
@@ -594,9 +773,16 @@ void retro_run (void)
    do_glflush();
 #else
    if (draw_this_frame)
-      video_cb(videoBuffer, fb_width, fb_height, fb_pitch << LOG_PIXEL_BYTES);
+      video_cb(fb_ptr, fb_width, fb_height, fb_pitch << LOG_PIXEL_BYTES);
    else
       video_cb(NULL, fb_width, fb_height, fb_pitch << LOG_PIXEL_BYTES);
+
+   /* the frontend buffer is only valid until retro_run returns */
+   if (fb_ptr != videoBuffer)
+   {
+      fb_ptr = videoBuffer;
+      draw_this_frame = false;
+   }
 #endif
 }
 
@@ -657,39 +843,33 @@ void retro_unload_game(void)
 
 size_t retro_serialize_size(void) 
 { 
-	log_cb(RETRO_LOG_INFO, "RETRO_SERIALIZE_SIZE CALLED\n");
 	// serialize_size is memorized per-game, if we already have it
 	// we send the old value
 	if(serialize_size == 0)
 	{
-		// to calculate the size we must perform an actual savestate
-		// and measure it
-		retro_buffer_writer saveBuffer;
-		retro_save_state(saveBuffer);
-		// reserve some extra space (see comment on define)
-		serialize_size  = saveBuffer.size() * SAVE_SIZE_MULTIPLIER;
-		log_cb(RETRO_LOG_INFO, "RETRO_SERIALIZE_SIZE IS: %d, ALLOCATED: %d\n", saveBuffer.size(), serialize_size);
+		// the registry is closed once the machine is running, so the
+		// size of every state is known without performing a save
+		serialize_size = retro_save_state_size();
+		log_cb(RETRO_LOG_INFO, "RETRO_SERIALIZE_SIZE IS: %d\n", (int)serialize_size);
 	}
 
 	return serialize_size; 
 }
 bool retro_serialize(void *data, size_t size) 
 {
-	retro_buffer_writer saveBuffer;
-	retro_save_state(saveBuffer);
-	log_cb(RETRO_LOG_INFO, "RETRO_SERIALIZE ACTUAL SIZE IS: %d\n",saveBuffer.size());
-	// check if the save size is within both the buffer size and the precalculated serialize_size.
-	if( (saveBuffer.size() > size) || (size>serialize_size) ) 
+	// write straight into the frontend buffer; a short write means
+	// the buffer is smaller than the state
+	retro_buffer_writer saveBuffer(data, size);
+	if (!retro_save_state(saveBuffer))
 	{
-		log_cb(RETRO_LOG_ERROR, "RETRO_SERIALIZE too big. Got %d buffer size: %d stored size: %d\n",saveBuffer.size(), size, serialize_size);
+		log_cb(RETRO_LOG_ERROR, "RETRO_SERIALIZE failed. Buffer size: %d stored size: %d\n", (int)size, (int)serialize_size);
 		return false;
 	}
-	memcpy(data, saveBuffer.data(), saveBuffer.size()); 
 	return true;
 }
 bool retro_unserialize(const void * data, size_t size) 
 { 
-	log_cb(RETRO_LOG_INFO, "RETRO_UNSERIALIZE. SIZE: %d\n",size);
+	// the reader consumes the frontend buffer in place
 	retro_buffer_reader readBuffer(data, size);
 	bool ret = retro_load_state(readBuffer);
 	if(!ret) {
@@ -709,7 +889,28 @@ void retro_set_controller_port_device(unsigned in_port, unsigned device) {}
 
 void *retro_get_fb_ptr(void)
 {
-   return videoBuffer;
+   struct retro_framebuffer fb;
+
+   fb.width        = fb_width;
+   fb.height       = fb_height;
+   fb.access_flags = RETRO_MEMORY_ACCESS_WRITE | RETRO_MEMORY_ACCESS_READ;
+
+   /* render straight into the frontend buffer when it matches our
+   pixel format; the renderer blends, so it must also be cached */
+   if (environ_cb(RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER, &fb)
+         && fb.data != NULL
+         && fb.format == FB_PIXEL_FORMAT
+         && (fb.memory_flags & RETRO_MEMORY_TYPE_CACHED)
+         && (fb.pitch & ((1 << LOG_PIXEL_BYTES) - 1)) == 0
+         && (fb.pitch >> LOG_PIXEL_BYTES) >= fb_width)
+   {
+      fb_pitch = fb.pitch >> LOG_PIXEL_BYTES;
+      fb_ptr   = fb.data;
+   }
+   else
+      fb_ptr   = videoBuffer;
+
+   return fb_ptr;
 }
 
 void retro_frame_draw_enable(bool enable)
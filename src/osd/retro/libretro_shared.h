@@ -32,6 +32,18 @@ extern bool hide_gameinfo;
 extern int mouse_mode;
 extern bool cheats_enable;
 extern bool alternate_renderer;
+extern bool native_passthrough;
+extern bool threaded_renderer;
+extern bool audio_sync_enable;
+extern bool profiler_enable;
+extern bool rewind_enable;
+extern bool memstats_enable;
+extern bool drc_cache_enable;
+extern bool idle_detect_enable;
+extern bool m68k_drc_enable;
+extern bool sh4_drc_enable;
+extern bool psx_drc_enable;
+extern bool i386_drc_enable;
 extern bool boot_to_osd_enable;
 extern bool boot_to_bios_enable;
 extern bool softlist_enable;
@@ -65,6 +77,9 @@ extern int fb_pitch;
 extern float retro_aspect;
 extern float retro_fps;
 
+/* rate passed to the core with -samplerate */
+#define RETRO_SAMPLE_RATE 48000.0
+
 #if defined(WANT_MAME)
 static const char core[] = "mame2015";
 #elif defined(WANT_MESS)
@@ -80,12 +95,21 @@ static const char core[] = "mame2015";
 
 /* libretro callbacks */
 extern retro_log_printf_t log_cb;
+extern struct retro_perf_callback perf_cb;
 extern retro_input_state_t input_state_cb;
 
 void retro_frame_draw_enable(bool enable);
 
 void *retro_get_fb_ptr(void);
 
+void retro_audio_reset(void);
+
+void retro_audio_queue(const INT16 *buffer, int samples);
+
+void retro_audio_frame(double fps, double sample_rate);
+
+void retro_profiler_frame(void);
+
 void process_keyboard_state(void);
 
 void process_joypad_state(void);
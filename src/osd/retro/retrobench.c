@@ -0,0 +1,288 @@
+/***************************************************************************
+
+    retrobench.c
+
+    Headless libretro frontend for benchmarking the core. It loads one
+    driver, runs a fixed number of frames unthrottled with no inputs
+    pressed and prints the time spent in each frame together with the
+    profiler buckets, as CSV or JSON.
+
+    Build with "make bench PROFILER=1"; without the profiler compiled
+    in only the frame timings are meaningful.
+
+    usage: <core>_bench [-frames N] [-json] [-system dir] [-save dir] rom
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "emu.h"
+#include "libretro.h"
+#include "retroosd.h"
+
+extern retro_osd_interface *retro_global_osd;
+
+/* core options forced for reproducible, unattended runs */
+struct bench_option
+{
+   const char *suffix;
+   const char *value;
+};
+
+static const bench_option bench_options[] =
+{
+   { "_hide_nagscreen",  "enabled" },
+   { "_hide_infoscreen", "enabled" },
+   { "_hide_warnings",   "enabled" },
+   { "_throttle",        "disabled" },
+   { "_read_config",     "disabled" },
+   { "_write_config",    "disabled" },
+   { "_auto_save",       "disabled" },
+   { "_boot_to_osd",     "disabled" },
+   { "_cheats_enable",   "disabled" }
+};
+
+/* non-device profiler buckets reported per frame */
+static const profile_type bench_buckets[] =
+{
+   PROFILER_DRC_COMPILE,
+   PROFILER_MEMREAD,
+   PROFILER_MEMWRITE,
+   PROFILER_VIDEO,
+   PROFILER_DRAWGFX,
+   PROFILER_COPYBITMAP,
+   PROFILER_TILEMAP_DRAW,
+   PROFILER_TILEMAP_DRAW_ROZ,
+   PROFILER_TILEMAP_UPDATE,
+   PROFILER_BLIT,
+   PROFILER_SOUND,
+   PROFILER_TIMER_CALLBACK,
+   PROFILER_INPUT,
+   PROFILER_EXTRA,
+   PROFILER_IDLE
+};
+
+#define BENCH_MAX_COLUMNS  (PROFILER_DEVICE_MAX + ARRAY_LENGTH(bench_buckets))
+
+struct bench_column
+{
+   profile_type type;
+   const char *name;
+   UINT64 total;
+};
+
+static const char *bench_system_dir = ".";
+static const char *bench_save_dir = ".";
+
+static void bench_log(enum retro_log_level level, const char *fmt, ...)
+{
+   va_list args;
+
+   /* keep stdout clean for the results */
+   if (level < RETRO_LOG_WARN)
+      return;
+
+   va_start(args, fmt);
+   vfprintf(stderr, fmt, args);
+   va_end(args);
+}
+
+static bool bench_environment(unsigned cmd, void *data)
+{
+   switch (cmd)
+   {
+      case RETRO_ENVIRONMENT_GET_LOG_INTERFACE:
+         ((struct retro_log_callback *)data)->log = bench_log;
+         return true;
+
+      case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY:
+      case RETRO_ENVIRONMENT_GET_CONTENT_DIRECTORY:
+         *(const char **)data = bench_system_dir;
+         return true;
+
+      case RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY:
+         *(const char **)data = bench_save_dir;
+         return true;
+
+      case RETRO_ENVIRONMENT_GET_VARIABLE:
+      {
+         struct retro_variable *var = (struct retro_variable *)data;
+         size_t keylen = strlen(var->key);
+
+         var->value = NULL;
+         for (int optnum = 0; optnum < ARRAY_LENGTH(bench_options); optnum++)
+         {
+            size_t suffixlen = strlen(bench_options[optnum].suffix);
+            if (keylen > suffixlen && !strcmp(var->key + keylen - suffixlen, bench_options[optnum].suffix))
+               var->value = bench_options[optnum].value;
+         }
+         return var->value != NULL;
+      }
+
+      case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT:
+      case RETRO_ENVIRONMENT_SET_VARIABLES:
+      case RETRO_ENVIRONMENT_SET_SYSTEM_AV_INFO:
+         return true;
+
+      default:
+         return false;
+   }
+}
+
+static void bench_video_refresh(const void *data, unsigned width, unsigned height, size_t pitch) { }
+static void bench_audio_sample(int16_t left, int16_t right) { }
+static size_t bench_audio_sample_batch(const int16_t *data, size_t frames) { return frames; }
+static void bench_input_poll(void) { }
+static int16_t bench_input_state(unsigned port, unsigned device, unsigned index, unsigned id) { return 0; }
+
+static double ticks_to_usec(UINT64 ticks)
+{
+   return (double)ticks * 1000000.0 / (double)osd_ticks_per_second();
+}
+
+/* the profiler counts in get_profile_ticks units, which may be raw cycles */
+static double profile_ticks_per_usec;
+
+static void calibrate_profile_ticks(void)
+{
+   osd_ticks_t start = osd_ticks();
+   INT64 profstart = get_profile_ticks();
+
+   while (osd_ticks() - start < osd_ticks_per_second() / 10) { }
+
+   profile_ticks_per_usec = (double)(get_profile_ticks() - profstart) / ticks_to_usec(osd_ticks() - start);
+}
+
+static void usage(const char *argv0)
+{
+   fprintf(stderr, "usage: %s [-frames N] [-json] [-system dir] [-save dir] rom\n", argv0);
+   exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+   static bench_column columns[BENCH_MAX_COLUMNS];
+   const char *rompath = NULL;
+   int frames = 1000;
+   bool json = false;
+   int numcolumns = 0;
+
+   for (int argnum = 1; argnum < argc; argnum++)
+   {
+      if (!strcmp(argv[argnum], "-frames") && argnum + 1 < argc)
+         frames = atoi(argv[++argnum]);
+      else if (!strcmp(argv[argnum], "-json"))
+         json = true;
+      else if (!strcmp(argv[argnum], "-csv"))
+         json = false;
+      else if (!strcmp(argv[argnum], "-system") && argnum + 1 < argc)
+         bench_system_dir = argv[++argnum];
+      else if (!strcmp(argv[argnum], "-save") && argnum + 1 < argc)
+         bench_save_dir = argv[++argnum];
+      else if (argv[argnum][0] != '-' && rompath == NULL)
+         rompath = argv[argnum];
+      else
+         usage(argv[0]);
+   }
+   if (rompath == NULL || frames <= 0)
+      usage(argv[0]);
+
+   retro_set_environment(bench_environment);
+   retro_set_video_refresh(bench_video_refresh);
+   retro_set_audio_sample(bench_audio_sample);
+   retro_set_audio_sample_batch(bench_audio_sample_batch);
+   retro_set_input_poll(bench_input_poll);
+   retro_set_input_state(bench_input_state);
+   retro_init();
+
+   struct retro_game_info info;
+   memset(&info, 0, sizeof(info));
+   info.path = rompath;
+   if (!retro_load_game(&info))
+   {
+      fprintf(stderr, "unable to load %s\n", rompath);
+      return 1;
+   }
+
+   /* the first retro_run starts the machine */
+   retro_run();
+   running_machine &machine = retro_global_osd->machine();
+
+   calibrate_profile_ticks();
+   g_profiler.enable(true);
+   if (!g_profiler.enabled())
+      fprintf(stderr, "profiler not compiled in, rebuild with PROFILER=1 for bucket timings\n");
+
+   /* one column per executing device, then the fixed buckets */
+   device_iterator iter(machine.root_device());
+   execute_interface_iterator execiter(machine.root_device());
+   for (device_execute_interface *exec = execiter.first(); exec != NULL; exec = execiter.next())
+   {
+      int index = iter.indexof(exec->device());
+      if (index >= 0 && index < PROFILER_DEVICE_MAX)
+      {
+         columns[numcolumns].type = profile_type(PROFILER_DEVICE_FIRST + index);
+         columns[numcolumns++].name = exec->device().tag();
+      }
+   }
+   for (int bucket = 0; bucket < ARRAY_LENGTH(bench_buckets); bucket++)
+   {
+      columns[numcolumns].type = bench_buckets[bucket];
+      columns[numcolumns++].name = profiler_type_name(bench_buckets[bucket]);
+   }
+
+   if (json)
+      printf("{\n  \"driver\": \"%s\",\n  \"frames\": [\n", machine.system().name);
+   else
+   {
+      printf("frame,usec");
+      for (int col = 0; col < numcolumns; col++)
+         printf(",\"%s\"", columns[col].name);
+      printf("\n");
+   }
+
+   UINT64 totalticks = 0;
+   for (int frame = 0; frame < frames; frame++)
+   {
+      g_profiler.clear();
+
+      osd_ticks_t start = osd_ticks();
+      retro_run();
+      UINT64 ticks = osd_ticks() - start;
+      totalticks += ticks;
+
+      if (json)
+         printf("    { \"frame\": %d, \"usec\": %.1f", frame, ticks_to_usec(ticks));
+      else
+         printf("%d,%.1f", frame, ticks_to_usec(ticks));
+
+      for (int col = 0; col < numcolumns; col++)
+      {
+         UINT64 data = g_profiler.data(columns[col].type);
+         columns[col].total += data;
+         if (json)
+            printf(", \"%s\": %.1f", columns[col].name, data / profile_ticks_per_usec);
+         else
+            printf(",%.1f", data / profile_ticks_per_usec);
+      }
+      printf(json ? ((frame + 1 < frames) ? " },\n" : " }\n") : "\n");
+   }
+
+   if (json)
+   {
+      printf("  ],\n  \"total\": { \"usec\": %.1f", ticks_to_usec(totalticks));
+      for (int col = 0; col < numcolumns; col++)
+         printf(", \"%s\": %.1f", columns[col].name, columns[col].total / profile_ticks_per_usec);
+      printf(" }\n}\n");
+   }
+   else
+      fprintf(stderr, "%d frames in %.1f ms, %.1f fps\n", frames, ticks_to_usec(totalticks) / 1000.0,
+            (double)frames * 1000000.0 / ticks_to_usec(totalticks));
+
+   retro_unload_game();
+   retro_deinit();
+   return 0;
+}
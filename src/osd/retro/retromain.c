@@ -83,6 +83,18 @@ bool hide_gameinfo = false;
 int mouse_mode = 0;
 bool cheats_enable = false;
 bool alternate_renderer = false;
+bool native_passthrough = false;
+bool threaded_renderer = false;
+bool audio_sync_enable = false;
+bool profiler_enable = false;
+bool rewind_enable = false;
+bool memstats_enable = false;
+bool drc_cache_enable = false;
+bool idle_detect_enable = false;
+bool m68k_drc_enable = false;
+bool sh4_drc_enable = false;
+bool psx_drc_enable = false;
+bool i386_drc_enable = false;
 bool boot_to_osd_enable = false;
 bool boot_to_bios_enable = false;
 bool experimental_cmdline = false;
@@ -117,24 +129,27 @@ int PARAMCOUNT=0;
 
 
 // path configuration
-#define NB_OPTPATH 12
+#define NB_OPTPATH 13
 
 static const char *dir_name[NB_OPTPATH]= {
     "cfg","nvram","hi"/*,"memcard"*/,"input",
     "states" ,"snaps","diff","samples",
-    "artwork","cheat","ini","hash"
+    "artwork","cheat","ini","hash",
+    "drccache"
 };
 
 static const char *opt_name[NB_OPTPATH]= {
     "-cfg_directory","-nvram_directory","-hiscore_directory",/*"-memcard_directory",*/"-input_directory",
     "-state_directory" ,"-snapshot_directory","-diff_directory","-samplepath",
-    "-artpath","-cheatpath","-inipath","-hashpath"
+    "-artpath","-cheatpath","-inipath","-hashpath",
+    "-drccache_directory"
 };
 
 int opt_type[NB_OPTPATH]={ // 0 for save_dir | 1 for system_dir
     0,0,0,0,
     0,0,0,1,
-    1,1,1,1
+    1,1,1,1,
+    0
 };
 
 #if defined(HAVE_OPENGL) || defined(HAVE_OPENGLES)
@@ -432,11 +447,127 @@ void osd_common_t::update_audio_stream(const INT16 *buffer, int samples_this_fra
 	// It provides an array of stereo samples in L-R order which should be
 	// output at the configured sample_rate.
 	//
-   if (retro_pause != -1)
+   if (audio_sync_enable)
+      retro_audio_queue(buffer, samples_this_frame);
+   else if (retro_pause != -1)
       audio_batch_cb(buffer, samples_this_frame);
 }
 
 
+//-------------------------------------------------
+//  frame-exact audio - the mixer is flushed at the
+//  end of every retro_run, and its output is queued
+//  here and resampled to exactly the number of
+//  samples the frontend expects for that frame
+//-------------------------------------------------
+
+#define AUDIO_FIFO_FRAMES     16384             /* stereo frames, power of 2 */
+#define AUDIO_FIFO_MASK       (AUDIO_FIFO_FRAMES - 1)
+#define AUDIO_RATE_CONTROL    0.005             /* maximum resampling ratio deviation */
+#define AUDIO_JITTER          0.25              /* slack held beyond one frame, in frames */
+
+static INT16 audio_fifo[AUDIO_FIFO_FRAMES * 2];
+static INT16 audio_out[AUDIO_FIFO_FRAMES * 2];
+static UINT32 audio_read;                       /* index of the current input frame */
+static UINT32 audio_write;                      /* index one past the newest input frame */
+static double audio_phase;                      /* fractional position past audio_read */
+static double audio_carry;                      /* fractional output frames owed */
+static bool audio_primed;
+
+void retro_audio_reset(void)
+{
+   memset(audio_fifo, 0, sizeof(audio_fifo));
+   audio_read = audio_write = 0;
+   audio_phase = audio_carry = 0.0;
+   audio_primed = false;
+}
+
+void retro_audio_queue(const INT16 *buffer, int samples)
+{
+   /* on overflow drop the oldest input rather than the newest */
+   for (int sample = 0; sample < samples; sample++, audio_write++)
+   {
+      audio_fifo[(audio_write & AUDIO_FIFO_MASK) * 2 + 0] = buffer[sample * 2 + 0];
+      audio_fifo[(audio_write & AUDIO_FIFO_MASK) * 2 + 1] = buffer[sample * 2 + 1];
+   }
+   if (audio_write - audio_read > AUDIO_FIFO_FRAMES - 4)
+      audio_read = audio_write - (AUDIO_FIFO_FRAMES - 4);
+}
+
+/* 4-point Catmull-Rom interpolation between y0 and y1 */
+static inline INT16 audio_interpolate(INT32 ym1, INT32 y0, INT32 y1, INT32 y2, double t)
+{
+   double a = 0.5 * (double)(3 * (y0 - y1) + y2 - ym1);
+   double b = (double)ym1 - 2.5 * (double)y0 + (double)(2 * y1) - 0.5 * (double)y2;
+   double c = 0.5 * (double)(y1 - ym1);
+   double result = ((a * t + b) * t + c) * t + (double)y0;
+
+   if (result < -32768.0)
+      return -32768;
+   if (result > 32767.0)
+      return 32767;
+   return (INT16)floor(result + 0.5);
+}
+
+void retro_audio_frame(double fps, double sample_rate)
+{
+   /* pick up everything mixed since the last periodic update, so the
+      FIFO never has to ride out a whole 50Hz mixer period */
+   retro_global_osd->machine().sound().flush();
+
+   /* exactly sample_rate / fps frames on average, carrying the fraction */
+   audio_carry += sample_rate / fps;
+   int frames = (int)audio_carry;
+   audio_carry -= frames;
+   if (frames > AUDIO_FIFO_FRAMES)
+      frames = AUDIO_FIFO_FRAMES;
+
+   /* hold this frame, the interpolator's taps and a little slack for
+      emulated frames that run short */
+   double target = frames * (1.0 + AUDIO_JITTER) + 3;
+   double fill = (double)(audio_write - audio_read) - audio_phase;
+
+   if (!audio_primed && fill >= target)
+      audio_primed = true;
+
+   /* nudge the ratio to steer the fill level back towards the target */
+   double step = 1.0 + AUDIO_RATE_CONTROL * (fill - target) / target;
+   if (step < 1.0 - AUDIO_RATE_CONTROL)
+      step = 1.0 - AUDIO_RATE_CONTROL;
+   if (step > 1.0 + AUDIO_RATE_CONTROL)
+      step = 1.0 + AUDIO_RATE_CONTROL;
+
+   for (int frame = 0; frame < frames; frame++)
+   {
+      /* underruns repeat the current input frame until more arrives */
+      if (!audio_primed || audio_write - audio_read < 3)
+      {
+         audio_primed = false;
+         audio_out[frame * 2 + 0] = audio_fifo[(audio_read & AUDIO_FIFO_MASK) * 2 + 0];
+         audio_out[frame * 2 + 1] = audio_fifo[(audio_read & AUDIO_FIFO_MASK) * 2 + 1];
+         continue;
+      }
+
+      const INT16 *ym1 = &audio_fifo[((audio_read - 1) & AUDIO_FIFO_MASK) * 2];
+      const INT16 *y0 = &audio_fifo[((audio_read + 0) & AUDIO_FIFO_MASK) * 2];
+      const INT16 *y1 = &audio_fifo[((audio_read + 1) & AUDIO_FIFO_MASK) * 2];
+      const INT16 *y2 = &audio_fifo[((audio_read + 2) & AUDIO_FIFO_MASK) * 2];
+      audio_out[frame * 2 + 0] = audio_interpolate(ym1[0], y0[0], y1[0], y2[0], audio_phase);
+      audio_out[frame * 2 + 1] = audio_interpolate(ym1[1], y0[1], y1[1], y2[1], audio_phase);
+
+      audio_phase += step;
+      while (audio_phase >= 1.0)
+      {
+         audio_phase -= 1.0;
+         audio_read++;
+      }
+   }
+
+   if (frames > 0 && retro_pause != -1)
+      audio_batch_cb(audio_out, frames);
+}
+
+
 //-------------------------------------------------
 //  set_mastervolume - set the system volume
 //-------------------------------------------------
@@ -1790,14 +1921,38 @@ static void Set_Default_Option(void)
       Add_Option("-nothrottle");
 
    Add_Option("-joystick");
+   char samplerate[16];
+   sprintf(samplerate, "%d", (int)RETRO_SAMPLE_RATE);
    Add_Option("-samplerate");
-   Add_Option("48000");
+   Add_Option(samplerate);
 
    if(cheats_enable)
       Add_Option("-cheat");
    else
       Add_Option("-nocheat");
 
+   if(rewind_enable)
+      Add_Option("-rewind");
+
+   if(memstats_enable)
+      Add_Option("-memstats");
+
+   if(drc_cache_enable)
+      Add_Option("-drc_analysis_cache");
+
+   if(idle_detect_enable)
+      Add_Option("-idle_detect");
+
+   if(m68k_drc_enable)
+      Add_Option("-drc_m68k");
+
+   if(sh4_drc_enable)
+      Add_Option("-drc_sh4");
+   if(psx_drc_enable)
+      Add_Option("-drc_psx");
+   if(i386_drc_enable)
+      Add_Option("-drc_i386");
+
    if(mouse_mode == 0)
    {
       Add_Option("-nomouse");
@@ -2335,6 +2490,134 @@ int mmain(int argc, const char *argv)
 #include "../../emu/drawgfx.h"
 #include "osdepend.h"
 
+#if !defined(HAVE_OPENGL) && !defined(HAVE_OPENGLES)
+//============================================================
+//  draw_primitives_banded - split the software renderer
+//  into horizontal bands spread over a work queue
+//============================================================
+
+#define RENDER_MAX_BANDS 8
+
+struct render_band
+{
+   const render_primitive_list *primlist;
+   void *dstdata;
+   UINT32 width, height, pitch;
+   UINT32 miny, maxy;
+};
+
+static osd_work_queue *render_queue = NULL;
+static render_band render_bands[RENDER_MAX_BANDS];
+static int render_band_count = 1;
+
+static void *draw_band(void *param, int threadid)
+{
+   const render_band *band = (const render_band *)param;
+#ifdef M16B
+   software_renderer<UINT16, 3,2,3, 11,5,0>::draw_primitives_band(*band->primlist, band->dstdata, band->width, band->height, band->miny, band->maxy, band->pitch);
+#else
+   software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives_band(*band->primlist, band->dstdata, band->width, band->height, band->miny, band->maxy, band->pitch);
+#endif
+   return NULL;
+}
+
+static void draw_primitives_banded(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch)
+{
+   int numbands = 1;
+
+   /* the queue comes and goes with the core option */
+   if (threaded_renderer && render_queue == NULL)
+   {
+      render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+      render_band_count = MIN(MAX(osd_get_num_processors(), 1), RENDER_MAX_BANDS);
+   }
+   else if (!threaded_renderer && render_queue != NULL)
+   {
+      osd_work_queue_free(render_queue);
+      render_queue = NULL;
+   }
+
+   if (render_queue != NULL)
+   {
+      numbands = MAX(MIN(render_band_count, (int)height / 16), 1);
+
+      /* vectors build their line tables lazily, so keep them on one thread */
+      for (const render_primitive *prim = primlist.m_primlist.first(); prim != NULL; prim = prim->m_next)
+         if (prim->type == render_primitive::LINE)
+            numbands = 1;
+   }
+
+   for (int bandnum = 0; bandnum < numbands; bandnum++)
+   {
+      render_band &band = render_bands[bandnum];
+      band.primlist = &primlist;
+      band.dstdata  = dstdata;
+      band.width    = width;
+      band.height   = height;
+      band.pitch    = pitch;
+      band.miny     = height * bandnum / numbands;
+      band.maxy     = height * (bandnum + 1) / numbands;
+   }
+
+   if (numbands == 1)
+   {
+      draw_band(&render_bands[0], 0);
+      return;
+   }
+
+   osd_work_item_queue_multiple(render_queue, draw_band, numbands, render_bands, sizeof(render_bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+   osd_work_queue_wait(render_queue, osd_ticks_per_second() * 100);
+}
+#endif
+
+//============================================================
+//  retro_profiler_frame - publish the profiler buckets
+//  gathered during this retro_run as frontend perf
+//  counters, in profiler ticks
+//============================================================
+
+static struct retro_perf_counter perf_counters[PROFILER_TOTAL];
+static char perf_names[PROFILER_TOTAL][64];
+static running_machine *perf_machine = NULL;
+
+void retro_profiler_frame(void)
+{
+   running_machine &machine = retro_global_osd->machine();
+   device_iterator iter(machine.root_device());
+
+   /* counters stay registered across games, so only their names change */
+   bool renamed = (perf_machine != &machine);
+   perf_machine = &machine;
+
+   for (profile_type type = PROFILER_DEVICE_FIRST; type < PROFILER_TOTAL; type++)
+   {
+      struct retro_perf_counter &counter = perf_counters[type];
+      osd_ticks_t ticks = g_profiler.data(type);
+
+      if (ticks == 0 || type == PROFILER_PROFILER)
+         continue;
+
+      if (!counter.registered || renamed)
+      {
+         if (type <= PROFILER_DEVICE_MAX)
+         {
+            device_t *device = iter.byindex(type - PROFILER_DEVICE_FIRST);
+            snprintf(perf_names[type], sizeof(perf_names[type]), "%s %s", core, (device != NULL) ? device->tag() : "?");
+         }
+         else
+            snprintf(perf_names[type], sizeof(perf_names[type]), "%s %s", core, profiler_type_name(type));
+         counter.ident = perf_names[type];
+      }
+      if (!counter.registered)
+         perf_cb.perf_register(&counter);
+
+      counter.total += ticks;
+      counter.call_cnt++;
+   }
+
+   g_profiler.clear();
+}
+
 //FIX ME DO CLEAN EXIT
 //============================================================
 //  constructor
@@ -2365,6 +2648,12 @@ void retro_osd_interface::osd_exit()
    retro = NULL:
 #endif
 
+#if !defined(HAVE_OPENGL) && !defined(HAVE_OPENGLES)
+   if (render_queue != NULL)
+      osd_work_queue_free(render_queue);
+   render_queue = NULL;
+#endif
+
    osd_common_t::osd_exit();
 }
 
@@ -2421,6 +2710,57 @@ void retro_osd_interface::init(running_machine &machine)
 		log_cb(RETRO_LOG_INFO, "OSD initialization complete\n");
 }
 
+//============================================================
+//  draw_passthrough - convert a screen bitmap straight
+//  into the frame buffer at its native size
+//============================================================
+
+#if !defined(HAVE_OPENGL) && !defined(HAVE_OPENGLES)
+#ifdef M16B
+#define PASSTHROUGH_PIXEL(r,g,b) ((((r) >> 3) << 11) | (((g) >> 2) << 5) | ((b) >> 3))
+#else
+#define PASSTHROUGH_PIXEL(r,g,b) (((r) << 16) | ((g) << 8) | (b))
+#endif
+
+static void draw_passthrough(const render_texinfo &texinfo, int texformat, PIXEL_TYPE *dst, int pitch)
+{
+   const rgb_t *palette = texinfo.palette;
+
+   for (UINT32 y = 0; y < texinfo.height; y++, dst += pitch)
+   {
+      if (texformat == TEXFORMAT_PALETTE16)
+      {
+         const UINT16 *src = (const UINT16 *)texinfo.base + y * texinfo.rowpixels;
+         for (UINT32 x = 0; x < texinfo.width; x++)
+         {
+            rgb_t pix = palette[src[x]];
+            dst[x] = PASSTHROUGH_PIXEL(pix.r(), pix.g(), pix.b());
+         }
+      }
+      else if (palette == NULL)
+      {
+         const UINT32 *src = (const UINT32 *)texinfo.base + y * texinfo.rowpixels;
+         for (UINT32 x = 0; x < texinfo.width; x++)
+         {
+            UINT32 pix = src[x];
+            dst[x] = PASSTHROUGH_PIXEL((pix >> 16) & 0xff, (pix >> 8) & 0xff, pix & 0xff);
+         }
+      }
+      else
+      {
+         /* RGB32 with brightness/contrast/gamma lookups */
+         const UINT32 *src = (const UINT32 *)texinfo.base + y * texinfo.rowpixels;
+         for (UINT32 x = 0; x < texinfo.width; x++)
+         {
+            UINT32 pix = src[x];
+            dst[x] = PASSTHROUGH_PIXEL(palette[(pix >> 16) & 0xff], palette[(pix >> 8) & 0xff], palette[pix & 0xff]);
+         }
+      }
+   }
+}
+#endif
+
+
 void retro_osd_interface::update(bool skip_redraw, UINT32 flags)
 {
 	if (FirstTimeUpdate == 1)
@@ -2478,29 +2818,47 @@ void retro_osd_interface::update(bool skip_redraw, UINT32 flags)
          fb_height = 1200;
       }
 
-      /* make that the size of our target */
-      our_target->set_bounds(fb_width, fb_height);
+#if !defined(HAVE_OPENGL) && !defined(HAVE_OPENGLES)
+      render_texinfo texinfo;
+      int texformat = TEXFORMAT_UNDEFINED;
+
+      /* a lone unrotated screen is converted straight from its bitmap */
+      if (native_passthrough && !alternate_renderer)
+         texformat = our_target->get_passthrough(texinfo);
+
+      if (texformat != TEXFORMAT_UNDEFINED && texinfo.width <= 1600 && texinfo.height <= 1200)
+      {
+         fb_width  = fb_pitch = texinfo.width;
+         fb_height = texinfo.height;
+
+         /* may switch to the frontend buffer and adjust fb_pitch */
+         PIXEL_TYPE *surfptr = (PIXEL_TYPE *)retro_get_fb_ptr();
+         draw_passthrough(texinfo, texformat, surfptr, fb_pitch);
+      }
+      else
+#endif
+      {
+         /* make that the size of our target */
+         our_target->set_bounds(fb_width, fb_height);
 
-      /* get the list of primitives for the target at the current size */
+         /* get the list of primitives for the target at the current size */
 
-      render_primitive_list &primlist = our_target->get_primitives();
+         render_primitive_list &primlist = our_target->get_primitives();
 
-      /* lock them, and then render them */
-      osd_lock_acquire(primlist.m_lock);
+         /* lock them, and then render them */
+         osd_lock_acquire(primlist.m_lock);
 
 #if defined(HAVE_OPENGL) || defined(HAVE_OPENGLES)
-      gl_draw_primitives(primlist, fb_width, fb_height);
+         gl_draw_primitives(primlist, fb_width, fb_height);
 #else
-      UINT8 *surfptr = (UINT8 *)retro_get_fb_ptr();
-#ifdef M16B
-      software_renderer<UINT16, 3,2,3, 11,5,0>::draw_primitives(primlist, surfptr, minwidth, minheight,minwidth );
-#else
-      software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(primlist, surfptr, minwidth, minheight,minwidth );
-#endif
+         /* may switch to the frontend buffer and adjust fb_pitch */
+         UINT8 *surfptr = (UINT8 *)retro_get_fb_ptr();
+         draw_primitives_banded(primlist, surfptr, fb_width, fb_height, fb_pitch);
 
 #endif
 
-      osd_lock_release(primlist.m_lock);
+         osd_lock_release(primlist.m_lock);
+      }
    }
 	else
       retro_frame_draw_enable(false);
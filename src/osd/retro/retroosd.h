@@ -37,6 +37,9 @@ extern const options_entry mame_win_options[];
 // defined in winwork.c
 extern int osd_num_processors;
 
+// defined in retromain.c
+extern retro_osd_interface *retro_global_osd;
+
 
 
 //============================================================